@@ -0,0 +1,183 @@
+// ============================================
+// primitives.rs — bitboard vs cell-by-cell primitive timings
+//
+// Times the rule engine and evaluator entry points on the early, mid and
+// late boards of tests/microbench.cpp, once with the bitboard
+// implementation and once with the scans in reference.rs. Each benchmark
+// is warmed up, then measured as SAMPLES batches sized to last at least
+// MIN_SAMPLE_NS; reported per call: median ns/op.
+//
+// cargo bench [-- FILTER]
+// ============================================
+
+use gomoku_ai_rust::evaluator::Evaluator;
+use gomoku_ai_rust::game_types::*;
+use gomoku_ai_rust::reference::{ScanEvaluator, ScanRules};
+use gomoku_ai_rust::rule_engine::RuleEngine;
+use gomoku_ai_rust::zobrist::get_zobrist;
+use std::hint::black_box;
+use std::time::{Duration, Instant};
+
+const SAMPLES: usize = 60;
+const WARMUP: Duration = Duration::from_millis(20);
+const MIN_SAMPLE_NS: u128 = 200_000;
+
+// Same boards as tests/microbench.cpp (PositionIO format)
+const BOARDS: [(&str, &str); 3] = [
+    ("early", "X 0 0 19/19/19/19/19/19/19/19/8X10/7O1X9/10X1O6/6X4O7/19/19/19/19/19/19/19"),
+    ("mid", "X 1 1 19/19/19/19/6X12/7OX10/8O1X1O6/7XOOOO7/8O2O7/7OXXXXO6/6OX5X5/5XXX3O7/5O6X6/19/19/19/19/19/19"),
+    ("late", "X 6 4 19/19/19/11XX6/3O2O6O5/3OOX2XOOO2XO3/3OXO2OX2OOOO3/3XOXXXX2XOXX4/3XXOX2XOO1OOX3/\
+              4X1O1XXXOXX1O3/3XOXOXX3OOOO3/4OX1OX1X1OX5/5XXOOO1O7/5XXXXOXX7/7XX1XOXO5/10X2O5/19/19/19"),
+];
+
+/// <side> <captures X> <captures O> <rows x = 0..18 separated by '/'>
+fn parse_position(text: &str) -> GameState {
+    let fields: Vec<&str> = text.split_whitespace().collect();
+    let mut state = GameState::new();
+    state.current_player = if fields[0] == "X" { PLAYER1 } else { PLAYER2 };
+    state.captures = [fields[1].parse().unwrap(), fields[2].parse().unwrap()];
+
+    for (x, row) in fields[3].split('/').enumerate() {
+        let mut y = 0;
+        let mut empty_run = 0;
+        for c in row.chars() {
+            if let Some(digit) = c.to_digit(10) {
+                empty_run = empty_run * 10 + digit as i32;
+                continue;
+            }
+            y += empty_run;
+            empty_run = 0;
+            state.place_piece(x as i32, y, if c == 'X' { PLAYER1 } else { PLAYER2 });
+            state.turn_count += 1;
+            y += 1;
+        }
+    }
+    state.zobrist_hash = get_zobrist().compute_full_hash(&state);
+    state
+}
+
+// Empty cells next to a stone: the moves search actually considers
+fn candidate_moves(state: &GameState) -> Vec<Move> {
+    let mut moves = Vec::new();
+    for x in 0..BOARD_SIZE as i32 {
+        for y in 0..BOARD_SIZE as i32 {
+            let near = ALL_DIRECTIONS
+                .iter()
+                .any(|&(dx, dy)| state.get_piece(x + dx, y + dy) > EMPTY);
+            if state.is_empty(x, y) && near {
+                moves.push(Move::new(x, y));
+            }
+        }
+    }
+    moves
+}
+
+/// Median ns per call of op(i) (inputs are cycled through i)
+fn measure(mut op: impl FnMut(usize)) -> f64 {
+    let mut i = 0;
+    let warmup_end = Instant::now() + WARMUP;
+    while Instant::now() < warmup_end {
+        for _ in 0..64 {
+            op(i);
+            i += 1;
+        }
+    }
+
+    let mut batch = 1;
+    loop {
+        let start = Instant::now();
+        for _ in 0..batch {
+            op(i);
+            i += 1;
+        }
+        if start.elapsed().as_nanos() >= MIN_SAMPLE_NS {
+            break;
+        }
+        batch *= 2;
+    }
+
+    let mut per_op: Vec<f64> = (0..SAMPLES)
+        .map(|_| {
+            let start = Instant::now();
+            for _ in 0..batch {
+                op(i);
+                i += 1;
+            }
+            start.elapsed().as_nanos() as f64 / batch as f64
+        })
+        .collect();
+    per_op.sort_by(|a, b| a.partial_cmp(b).unwrap());
+    per_op[SAMPLES / 2]
+}
+
+fn main() {
+    // cargo bench passes --bench; anything else is a name filter
+    let filter = std::env::args().skip(1).find(|arg| !arg.starts_with("--")).unwrap_or_default();
+
+    println!("=== RUST PRIMITIVES: bitboard vs scan ({} samples, median ns/op) ===", SAMPLES);
+    println!("{:<40}{:<7}{:>12}{:>12}{:>9}", "benchmark", "board", "bitboard", "scan", "speedup");
+
+    for (name, text) in BOARDS.iter() {
+        let state = parse_position(text);
+        let moves = candidate_moves(&state);
+        let player = state.current_player;
+        let side = |i: usize| if i & 1 == 1 { player } else { state.get_opponent(player) };
+
+        let run = |benchmark: &str, bitboard: &mut dyn FnMut(usize), scan: &mut dyn FnMut(usize)| {
+            if !benchmark.contains(filter.as_str()) {
+                return;
+            }
+            let fast = measure(|i| bitboard(i));
+            let slow = measure(|i| scan(i));
+            println!("{:<40}{:<7}{:>12.1}{:>12.1}{:>8.2}x", benchmark, name, fast, slow, slow / fast);
+        };
+
+        run(
+            "RuleEngine::check_win",
+            &mut |i| {
+                black_box(RuleEngine::check_win(black_box(&state), side(i)));
+            },
+            &mut |i| {
+                black_box(ScanRules::check_win(black_box(&state), side(i)));
+            },
+        );
+        run(
+            "RuleEngine::creates_double_free_three",
+            &mut |i| {
+                let mv = &moves[i % moves.len()];
+                black_box(RuleEngine::creates_double_free_three(black_box(&state), mv, player));
+            },
+            &mut |i| {
+                let mv = &moves[i % moves.len()];
+                black_box(ScanRules::creates_double_free_three(black_box(&state), mv, player));
+            },
+        );
+        run(
+            "Evaluator::count_all_patterns",
+            &mut |i| {
+                black_box(Evaluator::count_all_patterns(black_box(&state), side(i)));
+            },
+            &mut |i| {
+                black_box(ScanEvaluator::count_all_patterns(black_box(&state), side(i)));
+            },
+        );
+        run(
+            "Evaluator::evaluate_for_player",
+            &mut |i| {
+                black_box(Evaluator::evaluate_for_player(black_box(&state), side(i)));
+            },
+            &mut |i| {
+                black_box(ScanEvaluator::evaluate_for_player(black_box(&state), side(i)));
+            },
+        );
+        run(
+            "Evaluator::evaluate_simple",
+            &mut |_| {
+                black_box(Evaluator::evaluate_simple(black_box(&state)));
+            },
+            &mut |_| {
+                black_box(ScanEvaluator::evaluate_simple(black_box(&state)));
+            },
+        );
+    }
+}
@@ -3,6 +3,11 @@
 //   + transposition_search.hpp (search wrapper)
 // Minimax with alpha-beta, LMR, killer moves,
 //   history heuristic, iterative deepening
+//
+// Lazy SMP: with more than one thread, helper threads run the same
+// iterative deepening on the same position, sharing only the lock-free
+// transposition table. Thread 0 drives the search and its result is the
+// one returned; helpers fill the table with entries it then hits.
 // ============================================
 
 use crate::evaluator::{Evaluator, WIN};
@@ -10,34 +15,149 @@ use crate::game_types::*;
 use crate::move_ordering::MoveOrdering;
 use crate::rule_engine::RuleEngine;
 use crate::transposition_table::*;
+use std::sync::atomic::{AtomicBool, AtomicI32, Ordering};
+use std::time::Instant;
+
+// Nodes between two polls of the stop flag
+const STOP_POLL_NODES: i32 = 64;
+
+pub const MAX_THREADS: usize = 64;
 
 pub struct AI {
     tt: TranspositionTable,
+    // threads[0] is the main thread; history and killers are per thread
+    threads: Vec<SearchThread>,
+}
+
+// Per-thread search state
+struct SearchThread {
     history_table: [[i32; BOARD_SIZE]; BOARD_SIZE],
     killer_moves: [[Move; 2]; MAX_SEARCH_DEPTH],
     previous_best_move: Move,
-    pub nodes_evaluated: i32,
-    pub cache_hits: i32,
+    nodes_evaluated: i32,
+    cache_hits: i32,
+    stopped: bool,
+}
+
+// Shared by all threads for one search
+struct SearchControl<'a> {
+    tt: &'a TranspositionTable,
+    stop: Option<&'a AtomicI32>, // Caller's cancellation flag
+    done: Option<&'a AtomicBool>, // Helpers only: main thread finished
+}
+
+impl SearchControl<'_> {
+    fn should_stop(&self) -> bool {
+        self.stop.map_or(false, |flag| flag.load(Ordering::Relaxed) != 0)
+            || self.done.map_or(false, |flag| flag.load(Ordering::Relaxed))
+    }
 }
 
 impl AI {
     pub fn new() -> Self {
-        AI {
-            tt: TranspositionTable::new(),
-            history_table: [[0i32; BOARD_SIZE]; BOARD_SIZE],
-            killer_moves: [[Move::invalid(); 2]; MAX_SEARCH_DEPTH],
-            previous_best_move: Move::invalid(),
-            nodes_evaluated: 0,
-            cache_hits: 0,
+        Self::with_config(DEFAULT_TT_MB, 1)
+    }
+
+    pub fn with_config(tt_mb: usize, threads: usize) -> Self {
+        let mut ai = AI {
+            tt: TranspositionTable::with_size_mb(tt_mb),
+            threads: Vec::new(),
+        };
+        ai.set_threads(threads);
+        ai
+    }
+
+    /// Resize the thread pool (1..=MAX_THREADS); existing threads keep
+    /// their history and killers
+    pub fn set_threads(&mut self, threads: usize) {
+        self.threads.resize_with(threads.clamp(1, MAX_THREADS), SearchThread::new);
+    }
+
+    pub fn thread_count(&self) -> usize {
+        self.threads.len()
+    }
+
+    /// Forget everything learned in previous searches (new game)
+    pub fn clear(&mut self) {
+        self.tt.clear();
+        for thread in self.threads.iter_mut() {
+            *thread = SearchThread::new();
         }
     }
 
+    pub fn tt_size(&self) -> usize {
+        self.tt.size()
+    }
+
     // ============================================
     // ITERATIVE DEEPENING — findBestMoveIterative
     // ============================================
 
     pub fn find_best_move_iterative(&mut self, state: &GameState, max_depth: i32) -> SearchResult {
+        self.find_best_move_with(state, max_depth, &mut |_| {}, None)
+    }
+
+    /// Iterative deepening with progress reporting and cancellation.
+    /// on_iteration receives the result after every completed depth of
+    /// the main thread (its own node/hit counters). When stop becomes
+    /// non-zero the running iteration is abandoned and the result of the
+    /// last completed one is returned. The final result counts the nodes
+    /// and cache hits of all threads.
+    pub fn find_best_move_with(
+        &mut self,
+        state: &GameState,
+        max_depth: i32,
+        on_iteration: &mut dyn FnMut(&SearchResult),
+        stop: Option<&AtomicI32>,
+    ) -> SearchResult {
+        let start = Instant::now();
+        let done = AtomicBool::new(false);
+        let tt = &self.tt;
+        let (main, helpers) = self.threads.split_first_mut().expect("at least one search thread");
+
+        let mut result = std::thread::scope(|scope| {
+            for (index, helper) in helpers.iter_mut().enumerate() {
+                let control = SearchControl { tt, stop, done: Some(&done) };
+                scope.spawn(move || helper.iterate_helper(&control, state, max_depth, index + 1));
+            }
+
+            let control = SearchControl { tt, stop, done: None };
+            let result = main.iterate(&control, state, max_depth, start, on_iteration);
+            done.store(true, Ordering::Relaxed);
+            result
+        });
+
+        result.nodes_evaluated = self.threads.iter().map(|t| t.nodes_evaluated).sum();
+        result.cache_hits = self.threads.iter().map(|t| t.cache_hits).sum();
+        result.elapsed_us = start.elapsed().as_micros() as i64;
+        result
+    }
+}
+
+impl SearchThread {
+    fn new() -> Self {
+        SearchThread {
+            history_table: [[0i32; BOARD_SIZE]; BOARD_SIZE],
+            killer_moves: [[Move::invalid(); 2]; MAX_SEARCH_DEPTH],
+            previous_best_move: Move::invalid(),
+            nodes_evaluated: 0,
+            cache_hits: 0,
+            stopped: false,
+        }
+    }
+
+    fn iterate(
+        &mut self,
+        control: &SearchControl,
+        state: &GameState,
+        max_depth: i32,
+        start: Instant,
+        on_iteration: &mut dyn FnMut(&SearchResult),
+    ) -> SearchResult {
         let mut result = SearchResult::new();
+        self.stopped = false;
+        self.nodes_evaluated = 0;
+        self.cache_hits = 0;
 
         // Pre-check: immediate victory
         let candidates = MoveOrdering::generate_ordered_moves(
@@ -53,22 +173,27 @@ impl AI {
                 result.best_move = *mv;
                 result.score = WIN;
                 result.depth_searched = 1;
+                result.elapsed_us = start.elapsed().as_micros() as i64;
+                on_iteration(&result);
                 return result;
             }
         }
 
         // Iterative deepening
+        // Node and cache-hit counters cover the whole search, as in C++
         let mut best_move = Move::invalid();
 
         for depth in 1..=max_depth {
-            self.nodes_evaluated = 0;
-            self.cache_hits = 0;
-            self.tt.increment_generation();
+            if self.poll_stop(control) {
+                break;
+            }
+            control.tt.increment_generation();
 
             let mut current_best = Move::invalid();
             let maximizing = state.current_player == PLAYER2;
 
             let score = self.minimax(
+                control,
                 state,
                 depth,
                 i32::MIN + 1,
@@ -78,6 +203,11 @@ impl AI {
                 &mut current_best,
             );
 
+            // Cancelled: keep the last completed iteration
+            if self.stopped {
+                break;
+            }
+
             if current_best.is_valid() {
                 best_move = current_best;
                 self.previous_best_move = current_best;
@@ -88,29 +218,87 @@ impl AI {
             result.depth_searched = depth;
             result.nodes_evaluated = self.nodes_evaluated;
             result.cache_hits = self.cache_hits;
+            result.elapsed_us = start.elapsed().as_micros() as i64;
+            on_iteration(&result);
 
             // Early exit if winning/losing position found
             if score.abs() > 300000 {
                 break;
             }
 
-            // Age history table between iterations
-            for i in 0..BOARD_SIZE {
-                for j in 0..BOARD_SIZE {
-                    self.history_table[i][j] >>= 1;
-                }
-            }
+            self.age_history();
         }
 
         result
     }
 
+    // Helpers search until the main thread finishes. Odd helpers start one
+    // ply deeper so the threads do not all walk the same tree in lockstep.
+    fn iterate_helper(&mut self, control: &SearchControl, state: &GameState, max_depth: i32, index: usize) {
+        self.stopped = false;
+        self.nodes_evaluated = 0;
+        self.cache_hits = 0;
+
+        let first_depth = 1 + (index % 2) as i32;
+        for depth in first_depth..=max_depth {
+            if self.poll_stop(control) {
+                break;
+            }
+
+            let mut current_best = Move::invalid();
+            let maximizing = state.current_player == PLAYER2;
+            let score = self.minimax(
+                control,
+                state,
+                depth,
+                i32::MIN + 1,
+                i32::MAX - 1,
+                maximizing,
+                depth,
+                &mut current_best,
+            );
+
+            if self.stopped || score.abs() > 300000 {
+                break;
+            }
+            if current_best.is_valid() {
+                self.previous_best_move = current_best;
+            }
+            self.age_history();
+        }
+    }
+
+    // Age history table between iterations
+    fn age_history(&mut self) {
+        for i in 0..BOARD_SIZE {
+            for j in 0..BOARD_SIZE {
+                self.history_table[i][j] >>= 1;
+            }
+        }
+    }
+
+    // Polled every STOP_POLL_NODES nodes
+    fn stop_requested(&mut self, control: &SearchControl) -> bool {
+        if !self.stopped && self.nodes_evaluated % STOP_POLL_NODES == 0 {
+            self.poll_stop(control);
+        }
+        self.stopped
+    }
+
+    fn poll_stop(&mut self, control: &SearchControl) -> bool {
+        if !self.stopped {
+            self.stopped = control.should_stop();
+        }
+        self.stopped
+    }
+
     // ============================================
     // MINIMAX — with alpha-beta, LMR, killer moves
     // ============================================
 
     fn minimax(
         &mut self,
+        control: &SearchControl,
         state: &GameState,
         depth: i32,
         mut alpha: i32,
@@ -120,6 +308,9 @@ impl AI {
         best_move_out: &mut Move,
     ) -> i32 {
         self.nodes_evaluated += 1;
+        if self.stop_requested(control) {
+            return 0;
+        }
 
         // Base case: terminal evaluation
         if depth <= 0 {
@@ -129,14 +320,14 @@ impl AI {
 
         // Transposition table lookup
         let tt_key = state.zobrist_hash;
-        if let Some((cached_score, cached_move)) = self.tt.lookup(tt_key, depth, alpha, beta) {
+        if let Some((cached_score, cached_move)) = control.tt.lookup(tt_key, depth, alpha, beta) {
             self.cache_hits += 1;
             *best_move_out = cached_move;
             return cached_score;
         }
 
         // Get cached best move for move ordering
-        let tt_best_move = self.tt.get_best_move(tt_key).unwrap_or(Move::invalid());
+        let tt_best_move = control.tt.get_best_move(tt_key).unwrap_or(Move::invalid());
 
         // Generate and order moves
         let prev_best = if tt_best_move.is_valid() {
@@ -188,7 +379,7 @@ impl AI {
                     *best_move_out = *mv;
 
                     // Store in TT
-                    self.tt.store(
+                    control.tt.store(
                         tt_key,
                         win_score,
                         depth,
@@ -208,6 +399,7 @@ impl AI {
                 if use_lmr {
                     // Reduced-depth search first
                     score = self.minimax(
+                        control,
                         &new_state,
                         depth - 2,
                         alpha,
@@ -220,6 +412,7 @@ impl AI {
                     // Re-search at full depth if score is promising
                     if score > alpha {
                         score = self.minimax(
+                            control,
                             &new_state,
                             depth - 1,
                             alpha,
@@ -231,6 +424,7 @@ impl AI {
                     }
                 } else {
                     score = self.minimax(
+                        control,
                         &new_state,
                         depth - 1,
                         alpha,
@@ -241,6 +435,11 @@ impl AI {
                     );
                 }
 
+                // Unwind without touching the TT or move-ordering tables
+                if self.stopped {
+                    return 0;
+                }
+
                 if score > best_score {
                     best_score = score;
                     local_best_move = *mv;
@@ -281,7 +480,7 @@ impl AI {
                     let win_score = -WIN + (original_max_depth - current_depth);
                     *best_move_out = *mv;
 
-                    self.tt.store(
+                    control.tt.store(
                         tt_key,
                         win_score,
                         depth,
@@ -300,6 +499,7 @@ impl AI {
 
                 if use_lmr {
                     score = self.minimax(
+                        control,
                         &new_state,
                         depth - 2,
                         beta - 1,
@@ -311,6 +511,7 @@ impl AI {
 
                     if score < beta {
                         score = self.minimax(
+                            control,
                             &new_state,
                             depth - 1,
                             alpha,
@@ -322,6 +523,7 @@ impl AI {
                     }
                 } else {
                     score = self.minimax(
+                        control,
                         &new_state,
                         depth - 1,
                         alpha,
@@ -332,6 +534,11 @@ impl AI {
                     );
                 }
 
+                // Unwind without touching the TT or move-ordering tables
+                if self.stopped {
+                    return 0;
+                }
+
                 if score < best_score {
                     best_score = score;
                     local_best_move = *mv;
@@ -370,7 +577,7 @@ impl AI {
             *best_move_out = local_best_move;
         }
 
-        self.tt
+        control.tt
             .store(tt_key, best_score, depth, local_best_move, entry_type);
 
         best_score
@@ -0,0 +1,286 @@
+// ============================================
+// Bitboard — 361-bit board sets for the rule engine and evaluator
+//
+// Cell (x, y) is bit x * 19 + y of six u64 words; bits 361-383 are
+// always zero. Shifting a set by one step of a direction moves every
+// stone to its neighbour; edge columns are masked so a stone never wraps
+// onto the next row. Runs, captures and line starts are then plain
+// AND / AND-NOT of shifted sets, one whole board at a time.
+// ============================================
+
+use crate::game_types::*;
+use std::ops::{BitAnd, BitAndAssign, BitOr, BitOrAssign, Not};
+
+pub const CELLS: usize = BOARD_SIZE * BOARD_SIZE;
+pub const WORDS: usize = 6;
+
+#[derive(Clone, Copy, Debug, PartialEq, Eq, Default)]
+pub struct Bitboard(pub [u64; WORDS]);
+
+const fn cell_mask(column: i32) -> Bitboard {
+    let mut words = [0u64; WORDS];
+    let mut index = 0;
+    while index < CELLS {
+        if column < 0 || (index % BOARD_SIZE) as i32 == column {
+            words[index / 64] |= 1u64 << (index % 64);
+        }
+        index += 1;
+    }
+    Bitboard(words)
+}
+
+const ALL_CELLS: Bitboard = cell_mask(-1);
+const FIRST_COLUMN: Bitboard = cell_mask(0);
+const LAST_COLUMN: Bitboard = cell_mask(BOARD_SIZE as i32 - 1);
+
+impl Bitboard {
+    pub const EMPTY: Bitboard = Bitboard([0; WORDS]);
+    pub const FULL: Bitboard = ALL_CELLS;
+
+    #[inline]
+    pub fn index(x: i32, y: i32) -> usize {
+        x as usize * BOARD_SIZE + y as usize
+    }
+
+    #[inline]
+    pub fn set(&mut self, x: i32, y: i32) {
+        let i = Self::index(x, y);
+        self.0[i >> 6] |= 1u64 << (i & 63);
+    }
+
+    #[inline]
+    pub fn clear(&mut self, x: i32, y: i32) {
+        let i = Self::index(x, y);
+        self.0[i >> 6] &= !(1u64 << (i & 63));
+    }
+
+    /// false off the board
+    #[inline]
+    pub fn test(&self, x: i32, y: i32) -> bool {
+        if x < 0 || y < 0 || x >= BOARD_SIZE as i32 || y >= BOARD_SIZE as i32 {
+            return false;
+        }
+        self.test_index(Self::index(x, y))
+    }
+
+    #[inline]
+    pub fn test_index(&self, i: usize) -> bool {
+        (self.0[i >> 6] >> (i & 63)) & 1 != 0
+    }
+
+    #[inline]
+    pub fn is_empty(&self) -> bool {
+        self.0.iter().all(|&w| w == 0)
+    }
+
+    #[inline]
+    pub fn count(&self) -> u32 {
+        self.0.iter().map(|w| w.count_ones()).sum()
+    }
+
+    /// Move every bit one step along (dx, dy): the result has (x, y) set
+    /// when (x - dx, y - dy) is set. Bits leaving the board are dropped.
+    #[inline]
+    pub fn shifted(&self, dx: i32, dy: i32) -> Bitboard {
+        let step = dx * BOARD_SIZE as i32 + dy;
+        let mut moved = if step >= 0 {
+            self.shl(step as u32)
+        } else {
+            self.shr((-step) as u32)
+        };
+        // A stone stepping past y = 18 lands on y = 0 of the next row and
+        // vice versa
+        if dy > 0 {
+            moved = moved & !FIRST_COLUMN;
+        } else if dy < 0 {
+            moved = moved & !LAST_COLUMN;
+        }
+        moved
+    }
+
+    // 0 < n < 64 for every direction step (1, 18, 19, 20)
+    #[inline]
+    fn shl(&self, n: u32) -> Bitboard {
+        let w = &self.0;
+        let mut out = [0u64; WORDS];
+        out[0] = w[0] << n;
+        for i in 1..WORDS {
+            out[i] = (w[i] << n) | (w[i - 1] >> (64 - n));
+        }
+        Bitboard(out) & ALL_CELLS
+    }
+
+    #[inline]
+    fn shr(&self, n: u32) -> Bitboard {
+        let w = &self.0;
+        let mut out = [0u64; WORDS];
+        for i in 0..WORDS - 1 {
+            out[i] = (w[i] >> n) | (w[i + 1] << (64 - n));
+        }
+        out[WORDS - 1] = w[WORDS - 1] >> n;
+        Bitboard(out)
+    }
+
+    /// Set cells as (x, y), in row-major order
+    #[inline]
+    pub fn cells(&self) -> Cells {
+        Cells { words: self.0, word: 0 }
+    }
+}
+
+impl BitAnd for Bitboard {
+    type Output = Bitboard;
+    #[inline]
+    fn bitand(self, rhs: Bitboard) -> Bitboard {
+        let mut out = self.0;
+        for (a, b) in out.iter_mut().zip(rhs.0) {
+            *a &= b;
+        }
+        Bitboard(out)
+    }
+}
+
+impl BitAndAssign for Bitboard {
+    #[inline]
+    fn bitand_assign(&mut self, rhs: Bitboard) {
+        *self = *self & rhs;
+    }
+}
+
+impl BitOr for Bitboard {
+    type Output = Bitboard;
+    #[inline]
+    fn bitor(self, rhs: Bitboard) -> Bitboard {
+        let mut out = self.0;
+        for (a, b) in out.iter_mut().zip(rhs.0) {
+            *a |= b;
+        }
+        Bitboard(out)
+    }
+}
+
+impl BitOrAssign for Bitboard {
+    #[inline]
+    fn bitor_assign(&mut self, rhs: Bitboard) {
+        *self = *self | rhs;
+    }
+}
+
+/// Complement within the 361 board cells
+impl Not for Bitboard {
+    type Output = Bitboard;
+    #[inline]
+    fn not(self) -> Bitboard {
+        let mut out = self.0;
+        for (a, b) in out.iter_mut().zip(ALL_CELLS.0) {
+            *a = !*a & b;
+        }
+        Bitboard(out)
+    }
+}
+
+pub struct Cells {
+    words: [u64; WORDS],
+    word: usize,
+}
+
+impl Iterator for Cells {
+    type Item = Move;
+
+    #[inline]
+    fn next(&mut self) -> Option<Move> {
+        while self.word < WORDS {
+            let w = self.words[self.word];
+            if w != 0 {
+                self.words[self.word] = w & (w - 1);
+                let i = self.word * 64 + w.trailing_zeros() as usize;
+                return Some(Move::new((i / BOARD_SIZE) as i32, (i % BOARD_SIZE) as i32));
+            }
+            self.word += 1;
+        }
+        None
+    }
+}
+
+// ============================================
+// Whole-board masks
+// ============================================
+
+/// Cells of `stones` that begin a run of at least 5 along (dx, dy):
+/// the cell before is not a stone, the cell and the next 4 are.
+pub fn five_starts(stones: Bitboard, dx: i32, dy: i32) -> Bitboard {
+    let mut run = stones;
+    let mut ahead = stones;
+    for _ in 1..5 {
+        ahead = ahead.shifted(-dx, -dy);
+        run &= ahead;
+    }
+    run & !stones.shifted(dx, dy)
+}
+
+pub fn has_five(stones: Bitboard) -> bool {
+    MAIN_DIRECTIONS
+        .iter()
+        .any(|&(dx, dy)| !five_starts(stones, dx, dy).is_empty())
+}
+
+/// Empty cells where `own` captures along (dx, dy): the next two cells
+/// hold `other` stones and the third an `own` stone (OWN-X-X-OWN).
+pub fn capture_moves(own: Bitboard, other: Bitboard, dx: i32, dy: i32) -> Bitboard {
+    let first = other.shifted(-dx, -dy);
+    let second = first.shifted(-dx, -dy);
+    let closing = own.shifted(-dx, -dy).shifted(-dx, -dy).shifted(-dx, -dy);
+    !(own | other) & first & second & closing
+}
+
+// ============================================
+// Line views
+// ============================================
+// Every line of the board in each main direction as a u32, bit i = i-th
+// cell walking along the direction. Rows and columns have 19 lines, each
+// diagonal direction 37 (lengths 1..19).
+
+pub const MAX_LINES: usize = 2 * BOARD_SIZE - 1;
+
+/// (line, position along it) of a cell for each of MAIN_DIRECTIONS
+#[inline]
+pub fn line_of(x: i32, y: i32, direction: usize) -> (usize, u32) {
+    let last = BOARD_SIZE as i32 - 1;
+    match direction {
+        0 => (x as usize, y as u32),
+        1 => (y as usize, x as u32),
+        2 => ((x - y + last) as usize, x.min(y) as u32),
+        _ => ((x + y) as usize, (x - (x + y - last).max(0)) as u32),
+    }
+}
+
+#[inline]
+pub fn line_length(line: usize, direction: usize) -> u32 {
+    if direction < 2 {
+        BOARD_SIZE as u32
+    } else {
+        BOARD_SIZE as u32 - (line as i32 - (BOARD_SIZE as i32 - 1)).unsigned_abs()
+    }
+}
+
+pub struct LineSet {
+    pub lines: [[u32; MAX_LINES]; 4],
+}
+
+impl LineSet {
+    pub fn new(stones: Bitboard) -> Self {
+        let mut lines = [[0u32; MAX_LINES]; 4];
+        for cell in stones.cells() {
+            for (direction, dir_lines) in lines.iter_mut().enumerate() {
+                let (line, pos) = line_of(cell.x, cell.y, direction);
+                dir_lines[line] |= 1 << pos;
+            }
+        }
+        LineSet { lines }
+    }
+
+    #[inline]
+    pub fn line_count(direction: usize) -> usize {
+        if direction < 2 { BOARD_SIZE } else { MAX_LINES }
+    }
+}
@@ -1,8 +1,12 @@
 // ============================================
 // Evaluator — Exact match of evaluator_patterns.cpp,
 //   evaluator_position.cpp, evaluator_threats.cpp
+// Patterns are read from per-line bitmasks (bitboard::LineSet) and capture
+// opportunities from whole-board masks; scores match the cell-by-cell
+// scans kept in reference.rs.
 // ============================================
 
+use crate::bitboard::{self, line_length, LineSet};
 use crate::game_types::*;
 use crate::rule_engine::RuleEngine;
 
@@ -24,16 +28,17 @@ pub const CAPTURE_PREVENT_LOSS: i32 = 400000;
 // ============================================
 // Types
 // ============================================
-struct PatternInfo {
-    consecutive_count: i32,
-    total_pieces: i32,
-    free_ends: i32,
-    has_gaps: bool,
-    _total_span: i32,
-    _gap_count: i32,
-    max_reachable: i32,
+pub(crate) struct PatternInfo {
+    pub(crate) consecutive_count: i32,
+    pub(crate) total_pieces: i32,
+    pub(crate) free_ends: i32,
+    pub(crate) has_gaps: bool,
+    pub(crate) _total_span: i32,
+    pub(crate) _gap_count: i32,
+    pub(crate) max_reachable: i32,
 }
 
+#[derive(Debug, PartialEq, Eq)]
 pub struct PatternCounts {
     pub four_open: i32,
     pub four_half: i32,
@@ -42,12 +47,6 @@ pub struct PatternCounts {
     pub two_open: i32,
 }
 
-#[allow(dead_code)]
-struct CaptureOpportunity {
-    position: Move,
-    captured: Vec<Move>,
-}
-
 pub struct Evaluator;
 
 impl Evaluator {
@@ -88,15 +87,16 @@ impl Evaluator {
 
     pub fn evaluate_for_player(state: &GameState, player: i32) -> i32 {
         let mut score = 0;
+        let lines = PlayerLines::new(state, player);
 
         // 1. Count patterns via single-pass
-        let counts = Self::count_all_patterns(state, player);
+        let counts = Self::count_line_patterns(&lines);
 
         // 2. Evaluate threats and combinations using counts
         score += Self::evaluate_threats_and_combinations(state, player, &counts);
 
         // 3. Unified evaluation: patterns + captures
-        score += Self::analyze_position(state, player);
+        score += Self::analyze_position(state, player, &lines);
 
         score
     }
@@ -105,104 +105,71 @@ impl Evaluator {
     // PATTERN ANALYSIS — evaluator_patterns.cpp
     // ============================================
 
-    fn is_line_start(state: &GameState, x: i32, y: i32, dx: i32, dy: i32, player: i32) -> bool {
-        let prev_x = x - dx;
-        let prev_y = y - dy;
-        if !state.is_valid(prev_x, prev_y) {
-            return true;
-        }
-        state.get_piece(prev_x, prev_y) != player
-    }
-
-    fn analyze_line(
-        state: &GameState, start_x: i32, start_y: i32, dx: i32, dy: i32, player: i32,
-    ) -> PatternInfo {
-        let opponent = state.get_opponent(player);
-        let mut consecutive_from_start = 0;
-        let mut total_pieces = 0;
-        let mut gap_count = 0;
-        let mut total_span = 0;
-        let mut in_gap = false;
-        let mut pattern_broken = false;
+    /// Pattern starting at bit `start` of a line (start is a stone of
+    /// `own` whose predecessor is not): same fields as analyzeLine.
+    fn analyze_line(own: u32, other: u32, length: u32, start: u32) -> PatternInfo {
+        // Opponent stones and cells past the end of the line stop a scan
+        let blocked = other as u64 | (!0u64 << length);
+        let occupied = blocked | own as u64;
+        let own = own as u64;
 
         // Scan up to 6 positions forward
-        for i in 0..6 {
-            let cx = start_x + i * dx;
-            let cy = start_y + i * dy;
-
-            if !state.is_valid(cx, cy) || state.get_piece(cx, cy) == opponent {
-                total_span = i;
-                pattern_broken = true;
-                break;
-            }
-
-            if state.get_piece(cx, cy) == player {
-                if !in_gap && total_pieces == consecutive_from_start {
-                    consecutive_from_start += 1;
-                }
-                total_pieces += 1;
-                in_gap = false;
-            } else {
-                // Empty cell
-                in_gap = true;
-                gap_count += 1;
-            }
-            total_span = i + 1;
-        }
-        if !pattern_broken {
-            total_span = 6;
-        }
-
-        // Count free ends
-        let mut free_ends = 0;
-
-        // Check backward end
-        let before_x = start_x - dx;
-        let before_y = start_y - dy;
-        if state.is_valid(before_x, before_y) && state.get_piece(before_x, before_y) == EMPTY {
-            free_ends += 1;
-        }
-
-        // Check forward end
-        let end_x = start_x + total_span * dx;
-        let end_y = start_y + total_span * dy;
-        if state.is_valid(end_x, end_y) && state.get_piece(end_x, end_y) == EMPTY {
+        let total_span = (blocked >> start).trailing_zeros().min(6);
+        let window = ((1u64 << total_span) - 1) << start;
+        let total_pieces = (own & window).count_ones();
+        let consecutive = (own >> start).trailing_ones().min(total_span);
+        let end = start + total_span;
+
+        // Free ends: the cell before the start and the one after the scan
+        let mut free_ends = ((occupied >> end) & 1 == 0) as i32;
+        if start > 0 && (occupied >> (start - 1)) & 1 == 0 {
             free_ends += 1;
         }
 
-        // Compute maxReachable — count non-opponent cells in both directions
-        let mut max_reachable = total_pieces;
-
-        // Extend backward
-        let mut bx = start_x - dx;
-        let mut by = start_y - dy;
-        while state.is_valid(bx, by) && state.get_piece(bx, by) != opponent {
-            max_reachable += 1;
-            bx -= dx;
-            by -= dy;
-        }
-
-        // Extend forward from the end of scanned region
-        let mut fx = start_x + total_span * dx;
-        let mut fy = start_y + total_span * dy;
-        while state.is_valid(fx, fy) && state.get_piece(fx, fy) != opponent {
-            max_reachable += 1;
-            fx += dx;
-            fy += dy;
-        }
+        // maxReachable — non-opponent cells before the start and after the scan
+        let before = blocked & ((1u64 << start) - 1);
+        let reachable_before = if before == 0 {
+            start
+        } else {
+            start - 1 - (63 - before.leading_zeros())
+        };
+        let reachable_after = (blocked >> end).trailing_zeros();
 
         PatternInfo {
-            consecutive_count: consecutive_from_start,
-            total_pieces,
+            consecutive_count: consecutive as i32,
+            total_pieces: total_pieces as i32,
             free_ends,
-            has_gaps: gap_count > 0,
-            _total_span: total_span,
-            _gap_count: gap_count,
-            max_reachable,
+            has_gaps: total_span > total_pieces,
+            _total_span: total_span as i32,
+            _gap_count: (total_span - total_pieces) as i32,
+            max_reachable: (total_pieces + reachable_before + reachable_after) as i32,
+        }
+    }
+
+    /// Visit the pattern at every line start of the player: each run of
+    /// stones in each of the 4 directions, as the board scans of
+    /// evaluator_patterns.cpp reach it
+    fn for_each_pattern(lines: &PlayerLines, mut visit: impl FnMut(&PatternInfo)) {
+        for direction in 0..MAIN_DIRECTIONS.len() {
+            for line in 0..LineSet::line_count(direction) {
+                let own = lines.own.lines[direction][line];
+                if own == 0 {
+                    continue;
+                }
+                let other = lines.other.lines[direction][line];
+                let length = line_length(line, direction);
+
+                let mut starts = own & !(own << 1);
+                while starts != 0 {
+                    let start = starts.trailing_zeros();
+                    starts &= starts - 1;
+                    visit(&Self::analyze_line(own, other, length, start));
+                }
+            }
         }
     }
 
-    fn pattern_to_score(pattern: &PatternInfo) -> i32 {
+    pub(crate) fn pattern_to_score(pattern: &PatternInfo) -> i32 {
         let c = pattern.consecutive_count;
         let tp = pattern.total_pieces;
         let fe = pattern.free_ends;
@@ -253,6 +220,10 @@ impl Evaluator {
     // ============================================
 
     pub fn count_all_patterns(state: &GameState, player: i32) -> PatternCounts {
+        Self::count_line_patterns(&PlayerLines::new(state, player))
+    }
+
+    fn count_line_patterns(lines: &PlayerLines) -> PatternCounts {
         let mut counts = PatternCounts {
             four_open: 0,
             four_half: 0,
@@ -261,55 +232,42 @@ impl Evaluator {
             two_open: 0,
         };
 
-        for i in 0..BOARD_SIZE as i32 {
-            for j in 0..BOARD_SIZE as i32 {
-                if state.get_piece(i, j) != player {
-                    continue;
-                }
-
-                for &(dx, dy) in MAIN_DIRECTIONS.iter() {
-                    if !Self::is_line_start(state, i, j, dx, dy, player) {
-                        continue;
-                    }
-
-                    let pattern = Self::analyze_line(state, i, j, dx, dy, player);
-                    let c = pattern.consecutive_count;
-                    let tp = pattern.total_pieces;
-                    let fe = pattern.free_ends;
-                    let has_gaps = pattern.has_gaps;
+        Self::for_each_pattern(lines, |pattern| {
+            let c = pattern.consecutive_count;
+            let tp = pattern.total_pieces;
+            let fe = pattern.free_ends;
+            let has_gaps = pattern.has_gaps;
 
-                    // Skip dead shapes
-                    if pattern.max_reachable < 5 && c < 5 {
-                        continue;
-                    }
-
-                    // Four patterns
-                    if tp >= 4 {
-                        if c == 4 || (tp == 4 && has_gaps) {
-                            if fe == 2 {
-                                counts.four_open += 1;
-                            } else if fe == 1 {
-                                counts.four_half += 1;
-                            }
-                        }
-                    }
+            // Skip dead shapes
+            if pattern.max_reachable < 5 && c < 5 {
+                return;
+            }
 
-                    // Three patterns
-                    if tp == 3 && (c == 3 || has_gaps) {
-                        if fe == 2 {
-                            counts.three_open += 1;
-                        } else if fe == 1 {
-                            counts.three_half += 1;
-                        }
+            // Four patterns
+            if tp >= 4 {
+                if c == 4 || (tp == 4 && has_gaps) {
+                    if fe == 2 {
+                        counts.four_open += 1;
+                    } else if fe == 1 {
+                        counts.four_half += 1;
                     }
+                }
+            }
 
-                    // Two patterns
-                    if tp == 2 && fe == 2 {
-                        counts.two_open += 1;
-                    }
+            // Three patterns
+            if tp == 3 && (c == 3 || has_gaps) {
+                if fe == 2 {
+                    counts.three_open += 1;
+                } else if fe == 1 {
+                    counts.three_half += 1;
                 }
             }
-        }
+
+            // Two patterns
+            if tp == 2 && fe == 2 {
+                counts.two_open += 1;
+            }
+        });
 
         counts
     }
@@ -319,28 +277,11 @@ impl Evaluator {
         state: &GameState, player: i32, consecutive_count: i32, free_ends: i32,
     ) -> i32 {
         let mut count = 0;
-
-        for i in 0..BOARD_SIZE as i32 {
-            for j in 0..BOARD_SIZE as i32 {
-                if state.get_piece(i, j) != player {
-                    continue;
-                }
-
-                for &(dx, dy) in MAIN_DIRECTIONS.iter() {
-                    if !Self::is_line_start(state, i, j, dx, dy, player) {
-                        continue;
-                    }
-
-                    let pattern = Self::analyze_line(state, i, j, dx, dy, player);
-                    if pattern.consecutive_count == consecutive_count
-                        && pattern.free_ends == free_ends
-                    {
-                        count += 1;
-                    }
-                }
+        Self::for_each_pattern(&PlayerLines::new(state, player), |pattern| {
+            if pattern.consecutive_count == consecutive_count && pattern.free_ends == free_ends {
+                count += 1;
             }
-        }
-
+        });
         count
     }
 
@@ -348,7 +289,7 @@ impl Evaluator {
     // THREAT/COMBINATION EVALUATION — evaluator_threats.cpp
     // ============================================
 
-    fn evaluate_threats_and_combinations(
+    pub(crate) fn evaluate_threats_and_combinations(
         state: &GameState, player: i32, counts: &PatternCounts,
     ) -> i32 {
         let mut score = 0;
@@ -443,72 +384,23 @@ impl Evaluator {
     // POSITION ANALYSIS — evaluator_position.cpp analyzePosition
     // ============================================
 
-    fn analyze_position(state: &GameState, player: i32) -> i32 {
+    fn analyze_position(state: &GameState, player: i32, lines: &PlayerLines) -> i32 {
         let mut total_score = 0;
         let opponent = state.get_opponent(player);
 
-        // Track evaluated positions to avoid double counting
-        let mut evaluated = [[[false; 4]; BOARD_SIZE]; BOARD_SIZE];
-
         // PART 1: PATTERN EVALUATION
-        for i in 0..BOARD_SIZE as i32 {
-            for j in 0..BOARD_SIZE as i32 {
-                if state.get_piece(i, j) != player {
-                    continue;
-                }
-
-                for (dir_idx, &(dx, dy)) in MAIN_DIRECTIONS.iter().enumerate() {
-                    if evaluated[i as usize][j as usize][dir_idx] {
-                        continue;
-                    }
-
-                    if !Self::is_line_start(state, i, j, dx, dy, player) {
-                        continue;
-                    }
-
-                    let pattern = Self::analyze_line(state, i, j, dx, dy, player);
-                    let score = Self::pattern_to_score(&pattern);
-                    total_score += score;
-
-                    // Mark all positions in this line as evaluated in this direction
-                    let mut mx = i;
-                    let mut my = j;
-                    for _ in 0..pattern.consecutive_count {
-                        if state.is_valid(mx, my) {
-                            evaluated[mx as usize][my as usize][dir_idx] = true;
-                        }
-                        mx += dx;
-                        my += dy;
-                    }
-                }
-            }
-        }
+        // Every line start is scored once (the C++ "evaluated" marks only
+        // cover the stones after a start, which are never starts themselves)
+        Self::for_each_pattern(lines, |pattern| {
+            total_score += Self::pattern_to_score(pattern);
+        });
 
         // PART 2: CAPTURE EVALUATION
-        let mut capture_opportunities = 0;
-        let mut capture_threats = 0;
-
         // Offensive: our capture opportunities
-        let my_opps = Self::find_all_capture_opportunities(state, player);
-        for opp in &my_opps {
-            capture_opportunities += Self::evaluate_capture_context(
-                state,
-                player,
-                &opp.captured,
-                state.captures[(player - 1) as usize] + (opp.captured.len() / 2) as i32,
-            );
-        }
+        let capture_opportunities = Self::capture_opportunities_value(state, player);
 
         // Defensive: opponent's capture opportunities (threats to us)
-        let opp_threats = Self::find_all_capture_opportunities(state, opponent);
-        for threat in &opp_threats {
-            capture_threats += Self::evaluate_capture_context(
-                state,
-                opponent,
-                &threat.captured,
-                state.captures[(opponent - 1) as usize] + (threat.captured.len() / 2) as i32,
-            );
-        }
+        let capture_threats = Self::capture_opportunities_value(state, opponent);
 
         // PART 3: EXISTING CAPTURES SCORING
         let my_captures = state.captures[(player - 1) as usize];
@@ -547,67 +439,28 @@ impl Evaluator {
     // CAPTURE OPPORTUNITIES — evaluator_threats.cpp
     // ============================================
 
-    fn find_all_capture_opportunities(state: &GameState, player: i32) -> Vec<CaptureOpportunity> {
-        let mut opportunities = Vec::new();
-        let opponent = state.get_opponent(player);
-
-        for i in 0..BOARD_SIZE as i32 {
-            for j in 0..BOARD_SIZE as i32 {
-                if state.get_piece(i, j) != opponent {
-                    continue;
-                }
-
-                for &(dx, dy) in ALL_DIRECTIONS.iter() {
-                    let nx = i + dx;
-                    let ny = j + dy;
-
-                    // Need pair of opponent pieces
-                    if !state.is_valid(nx, ny) || state.get_piece(nx, ny) != opponent {
-                        continue;
-                    }
-
-                    // Check front flank: player at (i - dx, j - dy) and empty at (nx + dx, ny + dy)
-                    let front_x = i - dx;
-                    let front_y = j - dy;
-                    let back_x = nx + dx;
-                    let back_y = ny + dy;
-
-                    if state.is_valid(front_x, front_y)
-                        && state.get_piece(front_x, front_y) == player
-                        && state.is_valid(back_x, back_y)
-                        && state.is_empty(back_x, back_y)
-                    {
-                        let mut captured = Vec::new();
-                        captured.push(Move::new(i, j));
-                        captured.push(Move::new(nx, ny));
-                        opportunities.push(CaptureOpportunity {
-                            position: Move::new(back_x, back_y),
-                            captured,
-                        });
-                    }
-
-                    // Check back flank: empty at (i - dx, j - dy) and player at (nx + dx, ny + dy)
-                    if state.is_valid(front_x, front_y)
-                        && state.is_empty(front_x, front_y)
-                        && state.is_valid(back_x, back_y)
-                        && state.get_piece(back_x, back_y) == player
-                    {
-                        let mut captured = Vec::new();
-                        captured.push(Move::new(i, j));
-                        captured.push(Move::new(nx, ny));
-                        opportunities.push(CaptureOpportunity {
-                            position: Move::new(front_x, front_y),
-                            captured,
-                        });
-                    }
-                }
+    /// Sum of evaluateCaptureContext over every capture the player can make.
+    /// findAllCaptureOpportunities reaches each capture from both stones of
+    /// the pair, so each one counts twice.
+    fn capture_opportunities_value(state: &GameState, player: i32) -> i32 {
+        let own = state.stones_of(player);
+        let other = state.stones_of(state.get_opponent(player));
+        let new_capture_count = state.captures[(player - 1) as usize] + 1;
+
+        let mut value = 0;
+        for &(dx, dy) in ALL_DIRECTIONS.iter() {
+            for at in bitboard::capture_moves(own, other, dx, dy).cells() {
+                let captured = [
+                    Move::new(at.x + dx, at.y + dy),
+                    Move::new(at.x + 2 * dx, at.y + 2 * dy),
+                ];
+                value += 2 * Self::evaluate_capture_context(state, player, &captured, new_capture_count);
             }
         }
-
-        opportunities
+        value
     }
 
-    fn evaluate_capture_context(
+    pub(crate) fn evaluate_capture_context(
         state: &GameState, player: i32, captured_pieces: &[Move], new_capture_count: i32,
     ) -> i32 {
         let mut value;
@@ -687,3 +540,18 @@ impl Evaluator {
         count
     }
 }
+
+/// Line masks of a player's stones and of the opponent's
+struct PlayerLines {
+    own: LineSet,
+    other: LineSet,
+}
+
+impl PlayerLines {
+    fn new(state: &GameState, player: i32) -> Self {
+        PlayerLines {
+            own: LineSet::new(state.stones_of(player)),
+            other: LineSet::new(state.stones_of(state.get_opponent(player))),
+        }
+    }
+}
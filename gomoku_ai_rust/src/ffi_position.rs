@@ -0,0 +1,63 @@
+// ============================================
+// FFI Position — Exact mirror of include/ai/ffi_position.hpp
+// Compact POD position shared by pointer with C++
+// ============================================
+
+use crate::game_types::*;
+use crate::zobrist::get_zobrist;
+use std::mem::{offset_of, size_of};
+
+pub const MAX_FORCED_CAPTURES: usize = 16;
+
+#[repr(C)]
+#[derive(Clone, Copy)]
+pub struct FfiMove8 {
+    pub x: i8,
+    pub y: i8,
+}
+
+/// cells: row-major [x * 19 + y], 0 = empty, 1 = PLAYER1, 2 = PLAYER2.
+/// Forced-capture data is carried but not used by the search (same as C++).
+#[repr(C)]
+#[derive(Clone, Copy)]
+pub struct FfiPosition {
+    pub turn_count: i32,
+    pub cells: [u8; BOARD_SIZE * BOARD_SIZE],
+    pub current_player: u8,
+    pub captures: [u8; 2],
+    pub forced_capture_player: u8,
+    pub last_move_x: i8,
+    pub last_move_y: i8,
+    pub forced_capture_count: u8,
+    pub forced_captures: [FfiMove8; MAX_FORCED_CAPTURES],
+}
+
+// Must match the static_asserts in ffi_position.hpp
+const _: () = assert!(size_of::<FfiPosition>() == 404);
+const _: () = assert!(offset_of!(FfiPosition, cells) == 4);
+const _: () = assert!(offset_of!(FfiPosition, current_player) == 365);
+const _: () = assert!(offset_of!(FfiPosition, forced_capture_count) == 371);
+const _: () = assert!(offset_of!(FfiPosition, forced_captures) == 372);
+
+impl FfiPosition {
+    /// Build the engine state in one pass over the cells
+    pub fn to_game_state(&self) -> GameState {
+        let mut state = GameState::new();
+        state.current_player = self.current_player as i32;
+        state.turn_count = self.turn_count;
+        state.captures[0] = self.captures[0] as i32;
+        state.captures[1] = self.captures[1] as i32;
+        state.last_human_move = Move::new(self.last_move_x as i32, self.last_move_y as i32);
+
+        for (x, cells) in self.cells.chunks_exact(BOARD_SIZE).enumerate() {
+            for (y, &piece) in cells.iter().enumerate() {
+                if piece != EMPTY as u8 {
+                    state.place_piece(x as i32, y as i32, piece as i32);
+                }
+            }
+        }
+
+        state.zobrist_hash = get_zobrist().compute_full_hash(&state);
+        state
+    }
+}
@@ -2,6 +2,8 @@
 // Game types and constants — Exact match of game_types.hpp/cpp
 // ============================================
 
+use crate::bitboard::Bitboard;
+
 pub const BOARD_SIZE: usize = 19;
 pub const BOARD_CENTER: i32 = 9;
 pub const PLAYER1: i32 = 1; // Human
@@ -47,9 +49,12 @@ impl Move {
     }
 }
 
+/// `board` and `stones` hold the same position: write cells through
+/// place_piece / remove_piece so both stay in sync.
 #[derive(Clone)]
 pub struct GameState {
     pub board: [[i32; BOARD_SIZE]; BOARD_SIZE],
+    pub stones: [Bitboard; 2], // [PLAYER1, PLAYER2]
     pub current_player: i32,
     pub turn_count: i32,
     pub captures: [i32; 2], // [PLAYER1_captures, PLAYER2_captures]
@@ -61,6 +66,7 @@ impl GameState {
     pub fn new() -> Self {
         GameState {
             board: [[EMPTY; BOARD_SIZE]; BOARD_SIZE],
+            stones: [Bitboard::EMPTY; 2],
             current_player: PLAYER1,
             turn_count: 0,
             captures: [0, 0],
@@ -92,4 +98,24 @@ impl GameState {
     pub fn get_opponent(&self, player: i32) -> i32 {
         if player == PLAYER1 { PLAYER2 } else { PLAYER1 }
     }
+
+    #[inline]
+    pub fn place_piece(&mut self, x: i32, y: i32, player: i32) {
+        self.board[x as usize][y as usize] = player;
+        self.stones[(player - 1) as usize].set(x, y);
+    }
+
+    #[inline]
+    pub fn remove_piece(&mut self, x: i32, y: i32) {
+        let piece = self.board[x as usize][y as usize];
+        if piece != EMPTY {
+            self.stones[(piece - 1) as usize].clear(x, y);
+            self.board[x as usize][y as usize] = EMPTY;
+        }
+    }
+
+    #[inline]
+    pub fn stones_of(&self, player: i32) -> Bitboard {
+        self.stones[(player - 1) as usize]
+    }
 }
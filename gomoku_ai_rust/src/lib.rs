@@ -4,17 +4,23 @@
 // ============================================
 
 pub mod game_types;
+pub mod bitboard;
 pub mod zobrist;
 pub mod rule_engine;
 pub mod evaluator;
 pub mod transposition_table;
 pub mod move_ordering;
 pub mod ai;
+pub mod ffi_position;
+pub mod reference;
 
 use game_types::*;
-use zobrist::get_zobrist;
 use evaluator::Evaluator;
 use ai::AI;
+use ffi_position::FfiPosition;
+use std::ffi::c_void;
+use std::sync::atomic::AtomicI32;
+use transposition_table::{SearchResult, DEFAULT_TT_MB};
 
 // ============================================
 // FFI Entry Points
@@ -24,106 +30,197 @@ use ai::AI;
 /// Called from C++ via rust_ai_wrapper.hpp.
 ///
 /// Parameters:
-///   board:          flat [19*19] i32 array (row-major)
-///   current_player: 1 or 2
-///   turn_count:     number of turns played
-///   captures_p1:    captures for player 1
-///   captures_p2:    captures for player 2
-///   last_move_x:    x of last human move (-1 if none)
-///   last_move_y:    y of last human move (-1 if none)
-///   max_depth:      search depth
+///   position:  FfiPosition (include/ai/ffi_position.hpp), read in place
+///   max_depth: search depth
 #[no_mangle]
 pub extern "C" fn rust_ai_get_best_move(
-    board: *const i32,
-    current_player: i32,
-    turn_count: i32,
-    captures_p1: i32,
-    captures_p2: i32,
-    last_move_x: i32,
-    last_move_y: i32,
+    position: *const FfiPosition,
     max_depth: i32,
 ) -> Move {
-    let state = build_game_state(
-        board,
-        current_player,
-        turn_count,
-        captures_p1,
-        captures_p2,
-        last_move_x,
-        last_move_y,
-    );
-
-    let mut ai = AI::new();
-    let result = ai.find_best_move_iterative(&state, max_depth);
-
-    if result.best_move.is_valid() {
-        result.best_move
-    } else {
-        // Fallback: play center or first empty cell
-        if state.is_empty(BOARD_CENTER, BOARD_CENTER) {
-            Move::new(BOARD_CENTER, BOARD_CENTER)
-        } else {
-            find_first_empty(&state)
+    let state = read_position(position);
+
+    search_state(&state, max_depth).best_move
+}
+
+/// Search result returned across the FFI.
+/// Layout must match RustSearchResult in rust_ai_wrapper.hpp.
+#[repr(C)]
+pub struct FfiSearchResult {
+    pub best_move: Move,
+    pub score: i32,
+    pub depth_searched: i32,
+    pub nodes_evaluated: i32,
+    pub cache_hits: i32,
+    pub elapsed_us: i64,
+}
+
+/// Called after every completed iteration with that iteration's result
+/// (cumulative nodes/time) and the caller's user_data.
+pub type IterationCallback = Option<extern "C" fn(*const FfiSearchResult, *mut c_void)>;
+
+/// Same search as rust_ai_get_best_move, but also returns the score and
+/// search statistics (used by the C++/Rust parity harness).
+#[no_mangle]
+pub extern "C" fn rust_ai_search_position(
+    position: *const FfiPosition,
+    max_depth: i32,
+) -> FfiSearchResult {
+    let state = read_position(position);
+
+    search_state(&state, max_depth)
+}
+
+// ============================================
+// Persistent engine handle
+// ============================================
+// The handle owns one AI (transposition table, history, killers) that
+// survives across moves, so consecutive searches reuse the table instead
+// of allocating a new one each call.
+
+/// Create an engine with a transposition table of about tt_mb megabytes
+/// (<= 0 selects the default) searching with `threads` Lazy SMP threads
+/// (clamped to 1..=64). Release it with rust_ai_destroy.
+#[no_mangle]
+pub extern "C" fn rust_ai_create(tt_mb: i32, threads: i32) -> *mut AI {
+    let size_mb = if tt_mb > 0 { tt_mb as usize } else { DEFAULT_TT_MB };
+    Box::into_raw(Box::new(AI::with_config(size_mb, threads.max(1) as usize)))
+}
+
+/// Change the thread count of a handle between searches.
+#[no_mangle]
+pub extern "C" fn rust_ai_set_threads(handle: *mut AI, threads: i32) {
+    // SAFETY: handle is null or a live pointer from rust_ai_create
+    if let Some(ai) = unsafe { handle.as_mut() } {
+        ai.set_threads(threads.max(1) as usize);
+    }
+}
+
+#[no_mangle]
+pub extern "C" fn rust_ai_destroy(handle: *mut AI) {
+    if !handle.is_null() {
+        // SAFETY: handle was returned by rust_ai_create and is not used again
+        drop(unsafe { Box::from_raw(handle) });
+    }
+}
+
+/// Clear the table, history and killers of a handle (new game).
+#[no_mangle]
+pub extern "C" fn rust_ai_clear(handle: *mut AI) {
+    // SAFETY: handle is null or a live pointer from rust_ai_create
+    if let Some(ai) = unsafe { handle.as_mut() } {
+        ai.clear();
+    }
+}
+
+/// Search with a persistent handle. Same parameters as
+/// rust_ai_get_best_move, plus:
+///   on_iteration:   optional progress callback (may be null)
+///   user_data:      passed back to on_iteration unchanged
+///   stop_flag:      optional; set it to non-zero from any thread to stop
+///                   the search (the last completed iteration is returned)
+#[no_mangle]
+pub extern "C" fn rust_ai_search(
+    handle: *mut AI,
+    position: *const FfiPosition,
+    max_depth: i32,
+    on_iteration: IterationCallback,
+    user_data: *mut c_void,
+    stop_flag: *const AtomicI32,
+) -> FfiSearchResult {
+    let state = read_position(position);
+
+    let mut report = |result: &SearchResult| {
+        if let Some(callback) = on_iteration {
+            let ffi_result = to_ffi(result, result.best_move);
+            callback(&ffi_result, user_data);
         }
+    };
+    // SAFETY: stop_flag is null or points to a 4-byte atomic owned by the
+    // caller for the duration of the call
+    let stop = unsafe { stop_flag.as_ref() };
+
+    // SAFETY: handle is null or a live pointer from rust_ai_create
+    match unsafe { handle.as_mut() } {
+        Some(ai) => search_with(ai, &state, max_depth, &mut report, stop),
+        None => search_with(&mut AI::new(), &state, max_depth, &mut report, stop),
     }
 }
 
 /// Evaluate the current position for use in tests/suggestions.
 #[no_mangle]
-pub extern "C" fn rust_ai_evaluate_position(
-    board: *const i32,
-    current_player: i32,
-    turn_count: i32,
-    captures_p1: i32,
-    captures_p2: i32,
-) -> i32 {
-    let state = build_game_state(
-        board,
-        current_player,
-        turn_count,
-        captures_p1,
-        captures_p2,
-        -1,
-        -1,
-    );
-
-    Evaluator::evaluate_simple(&state)
+pub extern "C" fn rust_ai_evaluate_position(position: *const FfiPosition) -> i32 {
+    Evaluator::evaluate_simple(&read_position(position))
+}
+
+/// Evaluate count contiguous positions into scores[0..count].
+#[no_mangle]
+pub extern "C" fn rust_ai_evaluate_positions(
+    positions: *const FfiPosition,
+    count: i32,
+    scores: *mut i32,
+) {
+    if positions.is_null() || scores.is_null() || count <= 0 {
+        return;
+    }
+    // SAFETY: the caller passes arrays of at least count elements
+    let (positions, scores) = unsafe {
+        (
+            std::slice::from_raw_parts(positions, count as usize),
+            std::slice::from_raw_parts_mut(scores, count as usize),
+        )
+    };
+    for (position, score) in positions.iter().zip(scores.iter_mut()) {
+        *score = Evaluator::evaluate_simple(&position.to_game_state());
+    }
 }
 
 // ============================================
 // Helpers
 // ============================================
 
-fn build_game_state(
-    board: *const i32,
-    current_player: i32,
-    turn_count: i32,
-    captures_p1: i32,
-    captures_p2: i32,
-    last_move_x: i32,
-    last_move_y: i32,
-) -> GameState {
-    let mut state = GameState::new();
-    state.current_player = current_player;
-    state.turn_count = turn_count;
-    state.captures[0] = captures_p1;
-    state.captures[1] = captures_p2;
-    state.last_human_move = Move::new(last_move_x, last_move_y);
-
-    // Copy flat board into 2D array
-    if !board.is_null() {
-        for i in 0..BOARD_SIZE {
-            for j in 0..BOARD_SIZE {
-                state.board[i][j] = unsafe { *board.add(i * BOARD_SIZE + j) };
-            }
-        }
-    }
+// One-shot search with a fresh engine (stateless entry points)
+fn search_state(state: &GameState, max_depth: i32) -> FfiSearchResult {
+    search_with(&mut AI::new(), state, max_depth, &mut |_| {}, None)
+}
+
+fn search_with(
+    ai: &mut AI,
+    state: &GameState,
+    max_depth: i32,
+    on_iteration: &mut dyn FnMut(&SearchResult),
+    stop: Option<&AtomicI32>,
+) -> FfiSearchResult {
+    let result = ai.find_best_move_with(state, max_depth, on_iteration, stop);
+
+    let best_move = if result.best_move.is_valid() {
+        result.best_move
+    } else if state.is_empty(BOARD_CENTER, BOARD_CENTER) {
+        // Fallback: play center or first empty cell
+        Move::new(BOARD_CENTER, BOARD_CENTER)
+    } else {
+        find_first_empty(state)
+    };
 
-    // Compute initial Zobrist hash
-    let z = get_zobrist();
-    state.zobrist_hash = z.compute_full_hash(&state);
+    to_ffi(&result, best_move)
+}
 
-    state
+fn to_ffi(result: &SearchResult, best_move: Move) -> FfiSearchResult {
+    FfiSearchResult {
+        best_move,
+        score: result.score,
+        depth_searched: result.depth_searched,
+        nodes_evaluated: result.nodes_evaluated,
+        cache_hits: result.cache_hits,
+        elapsed_us: result.elapsed_us,
+    }
+}
+
+fn read_position(position: *const FfiPosition) -> GameState {
+    // SAFETY: position is null or points to a valid FfiPosition
+    match unsafe { position.as_ref() } {
+        Some(position) => position.to_game_state(),
+        None => GameState::new(),
+    }
 }
 
 fn find_first_empty(state: &GameState) -> Move {
@@ -0,0 +1,680 @@
+// ============================================
+// Reference — the cell-by-cell rule engine and evaluator scans
+//
+// The original line-by-line port of rules_*.cpp / evaluator_*.cpp that
+// the bitboard RuleEngine and Evaluator replaced. The search does not use
+// it: it is the oracle for the differential tests in tests/bitboard.rs and
+// the baseline timed by benches/primitives.rs.
+// ============================================
+
+use crate::evaluator::*;
+use crate::game_types::*;
+
+pub struct ScanRules;
+
+impl ScanRules {
+    pub fn find_captures(state: &GameState, mv: &Move, player: i32) -> Vec<Move> {
+        let mut captures = Vec::new();
+        let opponent = state.get_opponent(player);
+
+        // Search all 8 directions: pattern PLAYER-OPP-OPP-PLAYER
+        for &(dx, dy) in ALL_DIRECTIONS.iter() {
+            let p1x = mv.x + dx;
+            let p1y = mv.y + dy;
+            let p2x = mv.x + 2 * dx;
+            let p2y = mv.y + 2 * dy;
+            let p3x = mv.x + 3 * dx;
+            let p3y = mv.y + 3 * dy;
+
+            if state.is_valid(p1x, p1y)
+                && state.is_valid(p2x, p2y)
+                && state.is_valid(p3x, p3y)
+                && state.get_piece(p1x, p1y) == opponent
+                && state.get_piece(p2x, p2y) == opponent
+                && state.get_piece(p3x, p3y) == player
+            {
+                captures.push(Move::new(p1x, p1y));
+                captures.push(Move::new(p2x, p2y));
+            }
+        }
+
+        captures
+    }
+
+    // ============================================
+    // WIN DETECTION — mirrors rules_win.cpp
+    // ============================================
+
+    pub fn check_win(state: &GameState, player: i32) -> bool {
+        let opponent = state.get_opponent(player);
+
+        // 1. Win by captures
+        if state.captures[(player - 1) as usize] >= WIN_CAPTURES_NORMAL {
+            return true;
+        }
+
+        // 2. Win by five in a row (with verification)
+        for i in 0..BOARD_SIZE {
+            for j in 0..BOARD_SIZE {
+                if state.board[i][j] == player {
+                    let pos = Move::new(i as i32, j as i32);
+
+                    for &(dx, dy) in MAIN_DIRECTIONS.iter() {
+                        if Self::check_line_win_in_direction(state, &pos, dx, dy, player) {
+                            // Verification: can opponent break it via capture?
+                            if Self::can_break_line_by_capture(state, &pos, dx, dy, player) {
+                                continue;
+                            }
+
+                            // Verification: is opponent close to capture win?
+                            if state.captures[(opponent - 1) as usize] >= 8
+                                && Self::opponent_can_capture_next_turn(state, opponent)
+                            {
+                                return false;
+                            }
+
+                            return true;
+                        }
+                    }
+                }
+            }
+        }
+
+        false
+    }
+
+    fn check_line_win_in_direction(
+        state: &GameState, start: &Move, dx: i32, dy: i32, player: i32,
+    ) -> bool {
+        // Only count if start is the actual beginning of the line
+        let bx = start.x - dx;
+        let by = start.y - dy;
+        if state.is_valid(bx, by) && state.get_piece(bx, by) == player {
+            return false;
+        }
+
+        let mut count = 1;
+        let mut cx = start.x + dx;
+        let mut cy = start.y + dy;
+        while state.is_valid(cx, cy) && state.get_piece(cx, cy) == player {
+            count += 1;
+            cx += dx;
+            cy += dy;
+        }
+
+        count >= 5
+    }
+
+    fn can_break_line_by_capture(
+        state: &GameState, line_start: &Move, dx: i32, dy: i32, winning_player: i32,
+    ) -> bool {
+        let opponent = state.get_opponent(winning_player);
+
+        // Collect first 5 positions of the line
+        for i in 0..5 {
+            let px = line_start.x + i * dx;
+            let py = line_start.y + i * dy;
+
+            for &(cdx, cdy) in ALL_DIRECTIONS.iter() {
+                let second = Move::new(px + cdx, py + cdy);
+                let before = Move::new(px - cdx, py - cdy);
+                let after = Move::new(second.x + cdx, second.y + cdy);
+
+                // Pattern: OPP - PIECE - SECOND - EMPTY
+                if state.is_valid(before.x, before.y)
+                    && state.get_piece(before.x, before.y) == opponent
+                    && state.is_valid(second.x, second.y)
+                    && state.get_piece(second.x, second.y) == winning_player
+                    && state.is_valid(after.x, after.y)
+                    && state.is_empty(after.x, after.y)
+                {
+                    return true;
+                }
+
+                // Pattern: EMPTY - PIECE - SECOND - OPP
+                if state.is_valid(after.x, after.y)
+                    && state.get_piece(after.x, after.y) == opponent
+                    && state.is_valid(second.x, second.y)
+                    && state.get_piece(second.x, second.y) == winning_player
+                    && state.is_valid(before.x, before.y)
+                    && state.is_empty(before.x, before.y)
+                {
+                    return true;
+                }
+            }
+        }
+
+        false
+    }
+
+    fn opponent_can_capture_next_turn(state: &GameState, opponent: i32) -> bool {
+        for i in 0..BOARD_SIZE {
+            for j in 0..BOARD_SIZE {
+                if state.is_empty(i as i32, j as i32) {
+                    let test_move = Move::new(i as i32, j as i32);
+                    let captures = Self::find_captures(state, &test_move, opponent);
+                    if !captures.is_empty() {
+                        return true;
+                    }
+                }
+            }
+        }
+        false
+    }
+
+    pub fn creates_double_free_three(state: &GameState, mv: &Move, player: i32) -> bool {
+        let mut temp = state.clone();
+        temp.board[mv.x as usize][mv.y as usize] = player;
+
+        let mut free_three_count = 0;
+        for &(dx, dy) in MAIN_DIRECTIONS.iter() {
+            if Self::is_free_three(&temp, mv, dx, dy, player) {
+                free_three_count += 1;
+            }
+        }
+        free_three_count >= 2
+    }
+
+    fn is_free_three(state: &GameState, mv: &Move, dx: i32, dy: i32, player: i32) -> bool {
+        let opponent = state.get_opponent(player);
+
+        // Search all windows of 5 positions containing the move
+        for offset in -4..=0i32 {
+            let wx = mv.x + offset * dx;
+            let wy = mv.y + offset * dy;
+
+            // Verify window of 5 is within the board
+            let mut valid = true;
+            for i in 0..5 {
+                if !state.is_valid(wx + i * dx, wy + i * dy) {
+                    valid = false;
+                    break;
+                }
+            }
+            if !valid {
+                continue;
+            }
+
+            // Verify the move is within this window
+            let mut in_window = false;
+            for i in 0..5 {
+                if wx + i * dx == mv.x && wy + i * dy == mv.y {
+                    in_window = true;
+                    break;
+                }
+            }
+            if !in_window {
+                continue;
+            }
+
+            // Create window state
+            let mut window = [0i32; 5];
+            let mut player_count = 0;
+            let mut opponent_count = 0;
+            let mut empty_count = 0;
+
+            for i in 0..5 {
+                let px = wx + i * dx;
+                let py = wy + i * dy;
+                if px == mv.x && py == mv.y {
+                    window[i as usize] = player;
+                } else {
+                    window[i as usize] = state.get_piece(px, py);
+                }
+                if window[i as usize] == player {
+                    player_count += 1;
+                } else if window[i as usize] == opponent {
+                    opponent_count += 1;
+                } else {
+                    empty_count += 1;
+                }
+            }
+
+            // Free-three: exactly 3 player pieces, 0 opponent, 2 empty
+            if player_count == 3 && opponent_count == 0 && empty_count == 2 {
+                let left_x = wx - dx;
+                let left_y = wy - dy;
+                let right_x = wx + 5 * dx;
+                let right_y = wy + 5 * dy;
+
+                let left_free =
+                    state.is_valid(left_x, left_y) && state.is_empty(left_x, left_y);
+                let right_free =
+                    state.is_valid(right_x, right_y) && state.is_empty(right_x, right_y);
+
+                if left_free && right_free && Self::is_valid_free_three_pattern(&window, player) {
+                    return true;
+                }
+            }
+        }
+
+        false
+    }
+
+    fn is_valid_free_three_pattern(window: &[i32; 5], player: i32) -> bool {
+        let e = 0; // EMPTY
+        let p = player;
+        let patterns: [[i32; 5]; 10] = [
+            [p, p, p, e, e],
+            [p, p, e, p, e],
+            [p, p, e, e, p],
+            [p, e, p, p, e],
+            [p, e, p, e, p],
+            [p, e, e, p, p],
+            [e, p, p, p, e],
+            [e, p, p, e, p],
+            [e, p, e, p, p],
+            [e, e, p, p, p],
+        ];
+
+        for pattern in &patterns {
+            if window == pattern {
+                return Self::can_form_threat(pattern, player);
+            }
+        }
+        false
+    }
+
+    fn can_form_threat(pattern: &[i32; 5], player: i32) -> bool {
+        for i in 0..5 {
+            if pattern[i] == 0 {
+                let mut temp = [0i32; 5];
+                temp.copy_from_slice(pattern);
+                temp[i] = player;
+                if Self::has_four_consecutive(&temp, player) {
+                    return true;
+                }
+            }
+        }
+        false
+    }
+
+    fn has_four_consecutive(pattern: &[i32; 5], player: i32) -> bool {
+        for start in 0..=1 {
+            let mut ok = true;
+            for j in 0..4 {
+                if pattern[start + j] != player {
+                    ok = false;
+                    break;
+                }
+            }
+            if ok {
+                return true;
+            }
+        }
+        false
+    }
+}
+
+#[allow(dead_code)]
+struct CaptureOpportunity {
+    position: Move,
+    captured: Vec<Move>,
+}
+
+pub struct ScanEvaluator;
+
+impl ScanEvaluator {
+    pub fn evaluate_simple(state: &GameState) -> i32 {
+        if ScanRules::check_win(state, PLAYER2) {
+            return WIN;
+        }
+        if ScanRules::check_win(state, PLAYER1) {
+            return -WIN;
+        }
+
+        let ai_score = Self::evaluate_for_player(state, PLAYER2);
+        let human_score = Self::evaluate_for_player(state, PLAYER1);
+        ai_score - human_score
+    }
+
+    pub fn evaluate_for_player(state: &GameState, player: i32) -> i32 {
+        let mut score = 0;
+
+        // 1. Count patterns via single-pass
+        let counts = Self::count_all_patterns(state, player);
+
+        // 2. Evaluate threats and combinations using counts
+        score += Evaluator::evaluate_threats_and_combinations(state, player, &counts);
+
+        // 3. Unified evaluation: patterns + captures
+        score += Self::analyze_position(state, player);
+
+        score
+    }
+
+    // ============================================
+    // PATTERN ANALYSIS — evaluator_patterns.cpp
+    // ============================================
+
+    fn is_line_start(state: &GameState, x: i32, y: i32, dx: i32, dy: i32, player: i32) -> bool {
+        let prev_x = x - dx;
+        let prev_y = y - dy;
+        if !state.is_valid(prev_x, prev_y) {
+            return true;
+        }
+        state.get_piece(prev_x, prev_y) != player
+    }
+
+    fn analyze_line(
+        state: &GameState, start_x: i32, start_y: i32, dx: i32, dy: i32, player: i32,
+    ) -> PatternInfo {
+        let opponent = state.get_opponent(player);
+        let mut consecutive_from_start = 0;
+        let mut total_pieces = 0;
+        let mut gap_count = 0;
+        let mut total_span = 0;
+        let mut in_gap = false;
+        let mut pattern_broken = false;
+
+        // Scan up to 6 positions forward
+        for i in 0..6 {
+            let cx = start_x + i * dx;
+            let cy = start_y + i * dy;
+
+            if !state.is_valid(cx, cy) || state.get_piece(cx, cy) == opponent {
+                total_span = i;
+                pattern_broken = true;
+                break;
+            }
+
+            if state.get_piece(cx, cy) == player {
+                if !in_gap && total_pieces == consecutive_from_start {
+                    consecutive_from_start += 1;
+                }
+                total_pieces += 1;
+                in_gap = false;
+            } else {
+                // Empty cell
+                in_gap = true;
+                gap_count += 1;
+            }
+            total_span = i + 1;
+        }
+        if !pattern_broken {
+            total_span = 6;
+        }
+
+        // Count free ends
+        let mut free_ends = 0;
+
+        // Check backward end
+        let before_x = start_x - dx;
+        let before_y = start_y - dy;
+        if state.is_valid(before_x, before_y) && state.get_piece(before_x, before_y) == EMPTY {
+            free_ends += 1;
+        }
+
+        // Check forward end
+        let end_x = start_x + total_span * dx;
+        let end_y = start_y + total_span * dy;
+        if state.is_valid(end_x, end_y) && state.get_piece(end_x, end_y) == EMPTY {
+            free_ends += 1;
+        }
+
+        // Compute maxReachable — count non-opponent cells in both directions
+        let mut max_reachable = total_pieces;
+
+        // Extend backward
+        let mut bx = start_x - dx;
+        let mut by = start_y - dy;
+        while state.is_valid(bx, by) && state.get_piece(bx, by) != opponent {
+            max_reachable += 1;
+            bx -= dx;
+            by -= dy;
+        }
+
+        // Extend forward from the end of scanned region
+        let mut fx = start_x + total_span * dx;
+        let mut fy = start_y + total_span * dy;
+        while state.is_valid(fx, fy) && state.get_piece(fx, fy) != opponent {
+            max_reachable += 1;
+            fx += dx;
+            fy += dy;
+        }
+
+        PatternInfo {
+            consecutive_count: consecutive_from_start,
+            total_pieces,
+            free_ends,
+            has_gaps: gap_count > 0,
+            _total_span: total_span,
+            _gap_count: gap_count,
+            max_reachable,
+        }
+    }
+
+    // ============================================
+    // PATTERN COUNTING — evaluator_threats.cpp
+    // ============================================
+
+    pub fn count_all_patterns(state: &GameState, player: i32) -> PatternCounts {
+        let mut counts = PatternCounts {
+            four_open: 0,
+            four_half: 0,
+            three_open: 0,
+            three_half: 0,
+            two_open: 0,
+        };
+
+        for i in 0..BOARD_SIZE as i32 {
+            for j in 0..BOARD_SIZE as i32 {
+                if state.get_piece(i, j) != player {
+                    continue;
+                }
+
+                for &(dx, dy) in MAIN_DIRECTIONS.iter() {
+                    if !Self::is_line_start(state, i, j, dx, dy, player) {
+                        continue;
+                    }
+
+                    let pattern = Self::analyze_line(state, i, j, dx, dy, player);
+                    let c = pattern.consecutive_count;
+                    let tp = pattern.total_pieces;
+                    let fe = pattern.free_ends;
+                    let has_gaps = pattern.has_gaps;
+
+                    // Skip dead shapes
+                    if pattern.max_reachable < 5 && c < 5 {
+                        continue;
+                    }
+
+                    // Four patterns
+                    if tp >= 4 {
+                        if c == 4 || (tp == 4 && has_gaps) {
+                            if fe == 2 {
+                                counts.four_open += 1;
+                            } else if fe == 1 {
+                                counts.four_half += 1;
+                            }
+                        }
+                    }
+
+                    // Three patterns
+                    if tp == 3 && (c == 3 || has_gaps) {
+                        if fe == 2 {
+                            counts.three_open += 1;
+                        } else if fe == 1 {
+                            counts.three_half += 1;
+                        }
+                    }
+
+                    // Two patterns
+                    if tp == 2 && fe == 2 {
+                        counts.two_open += 1;
+                    }
+                }
+            }
+        }
+
+        counts
+    }
+
+    // ============================================
+    // POSITION ANALYSIS — evaluator_position.cpp analyzePosition
+    // ============================================
+
+    fn analyze_position(state: &GameState, player: i32) -> i32 {
+        let mut total_score = 0;
+        let opponent = state.get_opponent(player);
+
+        // Track evaluated positions to avoid double counting
+        let mut evaluated = [[[false; 4]; BOARD_SIZE]; BOARD_SIZE];
+
+        // PART 1: PATTERN EVALUATION
+        for i in 0..BOARD_SIZE as i32 {
+            for j in 0..BOARD_SIZE as i32 {
+                if state.get_piece(i, j) != player {
+                    continue;
+                }
+
+                for (dir_idx, &(dx, dy)) in MAIN_DIRECTIONS.iter().enumerate() {
+                    if evaluated[i as usize][j as usize][dir_idx] {
+                        continue;
+                    }
+
+                    if !Self::is_line_start(state, i, j, dx, dy, player) {
+                        continue;
+                    }
+
+                    let pattern = Self::analyze_line(state, i, j, dx, dy, player);
+                    let score = Evaluator::pattern_to_score(&pattern);
+                    total_score += score;
+
+                    // Mark all positions in this line as evaluated in this direction
+                    let mut mx = i;
+                    let mut my = j;
+                    for _ in 0..pattern.consecutive_count {
+                        if state.is_valid(mx, my) {
+                            evaluated[mx as usize][my as usize][dir_idx] = true;
+                        }
+                        mx += dx;
+                        my += dy;
+                    }
+                }
+            }
+        }
+
+        // PART 2: CAPTURE EVALUATION
+        let mut capture_opportunities = 0;
+        let mut capture_threats = 0;
+
+        // Offensive: our capture opportunities
+        let my_opps = Self::find_all_capture_opportunities(state, player);
+        for opp in &my_opps {
+            capture_opportunities += Evaluator::evaluate_capture_context(
+                state,
+                player,
+                &opp.captured,
+                state.captures[(player - 1) as usize] + (opp.captured.len() / 2) as i32,
+            );
+        }
+
+        // Defensive: opponent's capture opportunities (threats to us)
+        let opp_threats = Self::find_all_capture_opportunities(state, opponent);
+        for threat in &opp_threats {
+            capture_threats += Evaluator::evaluate_capture_context(
+                state,
+                opponent,
+                &threat.captured,
+                state.captures[(opponent - 1) as usize] + (threat.captured.len() / 2) as i32,
+            );
+        }
+
+        // PART 3: EXISTING CAPTURES SCORING
+        let my_captures = state.captures[(player - 1) as usize];
+        if my_captures >= 9 {
+            total_score += 300000;
+        } else if my_captures >= 8 {
+            total_score += 200000;
+        } else if my_captures >= 6 {
+            total_score += 15000;
+        } else if my_captures >= 4 {
+            total_score += 6000;
+        } else {
+            total_score += my_captures * 500;
+        }
+
+        let opp_captures = state.captures[(opponent - 1) as usize];
+        if opp_captures >= 9 {
+            total_score -= 400000;
+        } else if opp_captures >= 8 {
+            total_score -= 300000;
+        } else if opp_captures >= 6 {
+            total_score -= 20000;
+        } else if opp_captures >= 4 {
+            total_score -= 8000;
+        } else {
+            total_score -= opp_captures * 800;
+        }
+
+        total_score += capture_opportunities;
+        total_score -= capture_threats;
+
+        total_score
+    }
+
+    // ============================================
+    // CAPTURE OPPORTUNITIES — evaluator_threats.cpp
+    // ============================================
+
+    fn find_all_capture_opportunities(state: &GameState, player: i32) -> Vec<CaptureOpportunity> {
+        let mut opportunities = Vec::new();
+        let opponent = state.get_opponent(player);
+
+        for i in 0..BOARD_SIZE as i32 {
+            for j in 0..BOARD_SIZE as i32 {
+                if state.get_piece(i, j) != opponent {
+                    continue;
+                }
+
+                for &(dx, dy) in ALL_DIRECTIONS.iter() {
+                    let nx = i + dx;
+                    let ny = j + dy;
+
+                    // Need pair of opponent pieces
+                    if !state.is_valid(nx, ny) || state.get_piece(nx, ny) != opponent {
+                        continue;
+                    }
+
+                    // Check front flank: player at (i - dx, j - dy) and empty at (nx + dx, ny + dy)
+                    let front_x = i - dx;
+                    let front_y = j - dy;
+                    let back_x = nx + dx;
+                    let back_y = ny + dy;
+
+                    if state.is_valid(front_x, front_y)
+                        && state.get_piece(front_x, front_y) == player
+                        && state.is_valid(back_x, back_y)
+                        && state.is_empty(back_x, back_y)
+                    {
+                        let mut captured = Vec::new();
+                        captured.push(Move::new(i, j));
+                        captured.push(Move::new(nx, ny));
+                        opportunities.push(CaptureOpportunity {
+                            position: Move::new(back_x, back_y),
+                            captured,
+                        });
+                    }
+
+                    // Check back flank: empty at (i - dx, j - dy) and player at (nx + dx, ny + dy)
+                    if state.is_valid(front_x, front_y)
+                        && state.is_empty(front_x, front_y)
+                        && state.is_valid(back_x, back_y)
+                        && state.get_piece(back_x, back_y) == player
+                    {
+                        let mut captured = Vec::new();
+                        captured.push(Move::new(i, j));
+                        captured.push(Move::new(nx, ny));
+                        opportunities.push(CaptureOpportunity {
+                            position: Move::new(front_x, front_y),
+                            captured,
+                        });
+                    }
+                }
+            }
+        }
+
+        opportunities
+    }
+}
@@ -2,8 +2,11 @@
 // Rule Engine — Exact match of rule_engine.hpp / rules_*.cpp
 // Handles: move application, captures, win detection,
 //          double free-three validation
+// Fives and capture threats are found with whole-board bitboard masks
+// (bitboard.rs); results match the cell-by-cell scans in reference.rs.
 // ============================================
 
+use crate::bitboard::{self, Bitboard};
 use crate::game_types::*;
 use crate::zobrist::get_zobrist;
 
@@ -23,6 +26,30 @@ impl MoveResult {
     }
 }
 
+// Bit s set for each 5-cell shape s (bit i = cell i) with exactly 3 stones
+// where one more stone makes four in a row: the free-three patterns of
+// rules_validation.cpp that pass canFormThreat.
+const FREE_THREE_SHAPES: u32 = free_three_shapes();
+
+const fn free_three_shapes() -> u32 {
+    let mut shapes = 0u32;
+    let mut shape = 0u32;
+    while shape < 32 {
+        if shape.count_ones() == 3 {
+            let mut cell = 0;
+            while cell < 5 {
+                let filled = shape | (1 << cell);
+                if filled & 0b0_1111 == 0b0_1111 || filled & 0b1_1110 == 0b1_1110 {
+                    shapes |= 1 << shape;
+                }
+                cell += 1;
+            }
+        }
+        shape += 1;
+    }
+    shapes
+}
+
 pub struct RuleEngine;
 
 impl RuleEngine {
@@ -49,13 +76,13 @@ impl RuleEngine {
         let opponent = state.get_opponent(current_player);
 
         // 3. Place the piece
-        state.board[mv.x as usize][mv.y as usize] = current_player;
+        state.place_piece(mv.x, mv.y, current_player);
 
         // 4. Find and apply captures
         result.my_captured_pieces = Self::find_captures(state, mv, current_player);
 
         for captured in &result.my_captured_pieces {
-            state.board[captured.x as usize][captured.y as usize] = EMPTY;
+            state.remove_piece(captured.x, captured.y);
         }
         state.captures[player_idx] += (result.my_captured_pieces.len() / 2) as i32;
         if state.captures[player_idx] > 10 {
@@ -140,55 +167,26 @@ impl RuleEngine {
         }
 
         // 2. Win by five in a row (with verification)
-        for i in 0..BOARD_SIZE {
-            for j in 0..BOARD_SIZE {
-                if state.board[i][j] == player {
-                    let pos = Move::new(i as i32, j as i32);
-
-                    for &(dx, dy) in MAIN_DIRECTIONS.iter() {
-                        if Self::check_line_win_in_direction(state, &pos, dx, dy, player) {
-                            // Verification: can opponent break it via capture?
-                            if Self::can_break_line_by_capture(state, &pos, dx, dy, player) {
-                                continue;
-                            }
-
-                            // Verification: is opponent close to capture win?
-                            if state.captures[(opponent - 1) as usize] >= 8
-                                && Self::opponent_can_capture_next_turn(state, opponent)
-                            {
-                                return false;
-                            }
-
-                            return true;
-                        }
-                    }
+        let stones = state.stones_of(player);
+        for &(dx, dy) in MAIN_DIRECTIONS.iter() {
+            for start in bitboard::five_starts(stones, dx, dy).cells() {
+                // Verification: can opponent break it via capture?
+                if Self::can_break_line_by_capture(state, &start, dx, dy, player) {
+                    continue;
                 }
-            }
-        }
 
-        false
-    }
-
-    fn check_line_win_in_direction(
-        state: &GameState, start: &Move, dx: i32, dy: i32, player: i32,
-    ) -> bool {
-        // Only count if start is the actual beginning of the line
-        let bx = start.x - dx;
-        let by = start.y - dy;
-        if state.is_valid(bx, by) && state.get_piece(bx, by) == player {
-            return false;
-        }
+                // Verification: is opponent close to capture win?
+                if state.captures[(opponent - 1) as usize] >= 8
+                    && Self::opponent_can_capture_next_turn(state, opponent)
+                {
+                    return false;
+                }
 
-        let mut count = 1;
-        let mut cx = start.x + dx;
-        let mut cy = start.y + dy;
-        while state.is_valid(cx, cy) && state.get_piece(cx, cy) == player {
-            count += 1;
-            cx += dx;
-            cy += dy;
+                return true;
+            }
         }
 
-        count >= 5
+        false
     }
 
     fn can_break_line_by_capture(
@@ -234,18 +232,11 @@ impl RuleEngine {
     }
 
     fn opponent_can_capture_next_turn(state: &GameState, opponent: i32) -> bool {
-        for i in 0..BOARD_SIZE {
-            for j in 0..BOARD_SIZE {
-                if state.is_empty(i as i32, j as i32) {
-                    let test_move = Move::new(i as i32, j as i32);
-                    let captures = Self::find_captures(state, &test_move, opponent);
-                    if !captures.is_empty() {
-                        return true;
-                    }
-                }
-            }
-        }
-        false
+        let own = state.stones_of(opponent);
+        let other = state.stones_of(state.get_opponent(opponent));
+        ALL_DIRECTIONS
+            .iter()
+            .any(|&(dx, dy)| !bitboard::capture_moves(own, other, dx, dy).is_empty())
     }
 
     // ============================================
@@ -260,145 +251,57 @@ impl RuleEngine {
     }
 
     pub fn creates_double_free_three(state: &GameState, mv: &Move, player: i32) -> bool {
-        let mut temp = state.clone();
-        temp.board[mv.x as usize][mv.y as usize] = player;
+        let own = state.stones_of(player);
+        let other = state.stones_of(state.get_opponent(player));
 
         let mut free_three_count = 0;
         for &(dx, dy) in MAIN_DIRECTIONS.iter() {
-            if Self::is_free_three(&temp, mv, dx, dy, player) {
+            if Self::is_free_three(own, other, mv, dx, dy) {
                 free_three_count += 1;
             }
         }
         free_three_count >= 2
     }
 
-    fn is_free_three(state: &GameState, mv: &Move, dx: i32, dy: i32, player: i32) -> bool {
-        let opponent = state.get_opponent(player);
-
-        // Search all windows of 5 positions containing the move
-        for offset in -4..=0i32 {
-            let wx = mv.x + offset * dx;
-            let wy = mv.y + offset * dy;
-
-            // Verify window of 5 is within the board
-            let mut valid = true;
-            for i in 0..5 {
-                if !state.is_valid(wx + i * dx, wy + i * dy) {
-                    valid = false;
-                    break;
-                }
-            }
-            if !valid {
-                continue;
-            }
-
-            // Verify the move is within this window
-            let mut in_window = false;
-            for i in 0..5 {
-                if wx + i * dx == mv.x && wy + i * dy == mv.y {
-                    in_window = true;
-                    break;
-                }
-            }
-            if !in_window {
-                continue;
-            }
-
-            // Create window state
-            let mut window = [0i32; 5];
-            let mut player_count = 0;
-            let mut opponent_count = 0;
-            let mut empty_count = 0;
-
-            for i in 0..5 {
-                let px = wx + i * dx;
-                let py = wy + i * dy;
-                if px == mv.x && py == mv.y {
-                    window[i as usize] = player;
-                } else {
-                    window[i as usize] = state.get_piece(px, py);
-                }
-                if window[i as usize] == player {
-                    player_count += 1;
-                } else if window[i as usize] == opponent {
-                    opponent_count += 1;
-                } else {
-                    empty_count += 1;
-                }
-            }
-
-            // Free-three: exactly 3 player pieces, 0 opponent, 2 empty
-            if player_count == 3 && opponent_count == 0 && empty_count == 2 {
-                let left_x = wx - dx;
-                let left_y = wy - dy;
-                let right_x = wx + 5 * dx;
-                let right_y = wy + 5 * dy;
-
-                let left_free =
-                    state.is_valid(left_x, left_y) && state.is_empty(left_x, left_y);
-                let right_free =
-                    state.is_valid(right_x, right_y) && state.is_empty(right_x, right_y);
-
-                if left_free && right_free && Self::is_valid_free_three_pattern(&window, player) {
-                    return true;
-                }
-            }
-        }
-
-        false
-    }
-
-    fn is_valid_free_three_pattern(window: &[i32; 5], player: i32) -> bool {
-        let e = 0; // EMPTY
-        let p = player;
-        let patterns: [[i32; 5]; 10] = [
-            [p, p, p, e, e],
-            [p, p, e, p, e],
-            [p, p, e, e, p],
-            [p, e, p, p, e],
-            [p, e, p, e, p],
-            [p, e, e, p, p],
-            [e, p, p, p, e],
-            [e, p, p, e, p],
-            [e, p, e, p, p],
-            [e, e, p, p, p],
-        ];
-
-        for pattern in &patterns {
-            if window == pattern {
-                return Self::can_form_threat(pattern, player);
-            }
-        }
-        false
-    }
-
-    fn can_form_threat(pattern: &[i32; 5], player: i32) -> bool {
-        for i in 0..5 {
-            if pattern[i] == 0 {
-                let mut temp = [0i32; 5];
-                temp.copy_from_slice(pattern);
-                temp[i] = player;
-                if Self::has_four_consecutive(&temp, player) {
-                    return true;
-                }
+    /// Every 5-cell window through the move (with the move played) holding
+    /// a free-three shape, both cells just outside it on the board and empty
+    fn is_free_three(own: Bitboard, other: Bitboard, mv: &Move, dx: i32, dy: i32) -> bool {
+        // Cells mv - 5d ..= mv + 5d as bits 0..=10; the move is bit 5
+        let reach = |coord: i32, d: i32| match d {
+            1 => BOARD_SIZE as i32 - 1 - coord,
+            -1 => coord,
+            _ => 5,
+        };
+        let back = reach(mv.x, -dx).min(reach(mv.y, -dy)).min(5);
+        let forward = reach(mv.x, dx).min(reach(mv.y, dy)).min(5);
+        let on_board = ((1u32 << (back + forward + 1)) - 1) << (5 - back);
+
+        let center = Bitboard::index(mv.x, mv.y) as i32;
+        let step = dx * BOARD_SIZE as i32 + dy;
+        let mut own_bits = 1u32 << 5;
+        let mut other_bits = 0u32;
+        for k in (-back..=forward).filter(|&k| k != 0) {
+            let cell = (center + k * step) as usize;
+            if own.test_index(cell) {
+                own_bits |= 1 << (k + 5);
+            } else if other.test_index(cell) {
+                other_bits |= 1 << (k + 5);
             }
         }
-        false
-    }
 
-    fn has_four_consecutive(pattern: &[i32; 5], player: i32) -> bool {
-        for start in 0..=1 {
-            let mut ok = true;
-            for j in 0..4 {
-                if pattern[start + j] != player {
-                    ok = false;
-                    break;
-                }
+        // Window cells start..start+4, outer ends start-1 and start+5
+        for start in 1..=5 {
+            let span = 0b111_1111u32 << (start - 1);
+            let window = 0b1_1111u32 << start;
+            let ends = span & !window;
+            if on_board & span != span || other_bits & window != 0 || (own_bits | other_bits) & ends != 0 {
+                continue;
             }
-            if ok {
+            if (FREE_THREE_SHAPES >> ((own_bits >> start) & 0b1_1111)) & 1 != 0 {
                 return true;
             }
         }
+
         false
     }
 
@@ -2,12 +2,22 @@
 // Transposition Table — Exact match of
 //   transposition_search.hpp / search_transposition.cpp
 // Vec-based with power-of-2 sizing and mask indexing
+//
+// Shared lock-free between search threads (Lazy SMP): each slot is two
+// atomic u64 words, (key ^ data, data). A reader recomputes the key from
+// both words, so a slot torn by a concurrent store fails the key check
+// and reads as a miss instead of returning mixed data.
 // ============================================
 
 use crate::game_types::*;
+use std::alloc::{alloc_zeroed, handle_alloc_error, Layout};
+use std::sync::atomic::{AtomicU32, AtomicU64, Ordering};
 
 pub const MAX_SEARCH_DEPTH: usize = 20;
 
+// 32 MB = 1 << 21 slots of 16 bytes
+pub const DEFAULT_TT_MB: usize = 32;
+
 #[derive(Clone, Copy, PartialEq, Eq)]
 pub enum CacheEntryType {
     Exact,
@@ -15,35 +25,14 @@ pub enum CacheEntryType {
     UpperBound,
 }
 
-#[derive(Clone)]
-pub struct CacheEntry {
-    pub zobrist_key: u64,
-    pub score: i32,
-    pub depth: i32,
-    pub best_move: Move,
-    pub generation: u32,
-    pub entry_type: CacheEntryType,
-}
-
-impl CacheEntry {
-    fn empty() -> Self {
-        CacheEntry {
-            zobrist_key: 0,
-            score: 0,
-            depth: 0,
-            best_move: Move::invalid(),
-            generation: 0,
-            entry_type: CacheEntryType::Exact,
-        }
-    }
-}
-
+#[derive(Clone, Copy)]
 pub struct SearchResult {
     pub best_move: Move,
     pub score: i32,
     pub depth_searched: i32,
     pub nodes_evaluated: i32,
     pub cache_hits: i32,
+    pub elapsed_us: i64,
 }
 
 impl SearchResult {
@@ -54,41 +43,150 @@ impl SearchResult {
             depth_searched: 0,
             nodes_evaluated: 0,
             cache_hits: 0,
+            elapsed_us: 0,
+        }
+    }
+}
+
+// ============================================
+// Packed entry
+// ============================================
+// bits  0-31  score
+// bits 32-39  depth
+// bits 40-44  move x, 45-49 move y, 50 move valid
+// bits 51-52  entry type
+// bits 53-63  generation (wraps at 2048)
+
+const GENERATION_BITS: u32 = 11;
+const GENERATION_MASK: u32 = (1 << GENERATION_BITS) - 1;
+
+struct CacheEntry {
+    score: i32,
+    depth: i32,
+    best_move: Move,
+    generation: u32,
+    entry_type: CacheEntryType,
+}
+
+impl CacheEntry {
+    fn pack(&self) -> u64 {
+        let move_bits = if self.best_move.is_valid() {
+            (self.best_move.x as u64) | ((self.best_move.y as u64) << 5) | (1 << 10)
+        } else {
+            0
+        };
+        let type_bits = match self.entry_type {
+            CacheEntryType::Exact => 0u64,
+            CacheEntryType::LowerBound => 1,
+            CacheEntryType::UpperBound => 2,
+        };
+        (self.score as u32 as u64)
+            | ((self.depth.clamp(0, 255) as u64) << 32)
+            | (move_bits << 40)
+            | (type_bits << 51)
+            | (((self.generation & GENERATION_MASK) as u64) << 53)
+    }
+
+    fn unpack(data: u64) -> Self {
+        let move_bits = (data >> 40) & 0x7FF;
+        let best_move = if move_bits & (1 << 10) != 0 {
+            Move::new((move_bits & 0x1F) as i32, ((move_bits >> 5) & 0x1F) as i32)
+        } else {
+            Move::invalid()
+        };
+        let entry_type = match (data >> 51) & 0x3 {
+            1 => CacheEntryType::LowerBound,
+            2 => CacheEntryType::UpperBound,
+            _ => CacheEntryType::Exact,
+        };
+        CacheEntry {
+            score: data as u32 as i32,
+            depth: ((data >> 32) & 0xFF) as i32,
+            best_move,
+            generation: (data >> 53) as u32,
+            entry_type,
         }
     }
 }
 
+// All-zero words are an empty slot (key 0), so the table is allocated
+// with alloc_zeroed instead of being filled slot by slot.
+#[repr(C)]
+struct Slot {
+    key_xor_data: AtomicU64,
+    data: AtomicU64,
+}
+
+impl Slot {
+    // (key, data): an empty slot reads as key 0, a torn one as a key
+    // that matches no position
+    fn load(&self) -> (u64, u64) {
+        let data = self.data.load(Ordering::Relaxed);
+        let key = self.key_xor_data.load(Ordering::Relaxed) ^ data;
+        (key, data)
+    }
+
+    fn store(&self, key: u64, data: u64) {
+        self.data.store(data, Ordering::Relaxed);
+        self.key_xor_data.store(key ^ data, Ordering::Relaxed);
+    }
+}
+
 pub struct TranspositionTable {
-    table: Vec<CacheEntry>,
+    table: Vec<Slot>,
     table_size_mask: usize,
-    current_generation: u32,
+    current_generation: AtomicU32,
 }
 
 impl TranspositionTable {
     pub fn new() -> Self {
-        // Power-of-2 sizing: 1 << 20 = 1048576 entries, same as C++
-        let size: usize = 1 << 20;
-        let mut table = Vec::with_capacity(size);
-        for _ in 0..size {
-            table.push(CacheEntry::empty());
+        Self::with_size_mb(DEFAULT_TT_MB)
+    }
+
+    /// Largest power-of-2 slot count that fits in size_mb (same rounding
+    /// as TranspositionSearch::initializeTranspositionTable).
+    pub fn with_size_mb(size_mb: usize) -> Self {
+        let slot_bytes = std::mem::size_of::<Slot>();
+        let max_slots = (size_mb.max(1) * 1024 * 1024 / slot_bytes).max(1);
+        let mut size: usize = 1;
+        while size * 2 <= max_slots {
+            size <<= 1;
         }
 
         TranspositionTable {
-            table,
+            table: Self::allocate_zeroed(size),
             table_size_mask: size - 1,
-            current_generation: 0,
+            current_generation: AtomicU32::new(0),
         }
     }
 
-    pub fn lookup(
-        &mut self, key: u64, depth: i32, alpha: i32, beta: i32,
-    ) -> Option<(i32, Move)> {
-        let index = (key as usize) & self.table_size_mask;
-        let entry = &self.table[index];
+    fn allocate_zeroed(size: usize) -> Vec<Slot> {
+        let layout = Layout::array::<Slot>(size).expect("transposition table too large");
+        // SAFETY: AtomicU64 is valid when zeroed; the Vec takes ownership
+        // of an allocation made with the layout it will free it with.
+        unsafe {
+            let ptr = alloc_zeroed(layout) as *mut Slot;
+            if ptr.is_null() {
+                handle_alloc_error(layout);
+            }
+            Vec::from_raw_parts(ptr, size, size)
+        }
+    }
+
+    pub fn size(&self) -> usize {
+        self.table.len()
+    }
 
-        if entry.zobrist_key != key {
+    fn probe(&self, key: u64) -> Option<CacheEntry> {
+        let (stored_key, data) = self.table[(key as usize) & self.table_size_mask].load();
+        if stored_key != key {
             return None;
         }
+        Some(CacheEntry::unpack(data))
+    }
+
+    pub fn lookup(&self, key: u64, depth: i32, alpha: i32, beta: i32) -> Option<(i32, Move)> {
+        let entry = self.probe(key)?;
 
         // Store best move hint regardless of depth
         let best_move = entry.best_move;
@@ -117,36 +215,35 @@ impl TranspositionTable {
 
     /// Get best move from cache without depth check (for move ordering)
     pub fn get_best_move(&self, key: u64) -> Option<Move> {
-        let index = (key as usize) & self.table_size_mask;
-        let entry = &self.table[index];
-        if entry.zobrist_key == key && entry.best_move.is_valid() {
-            Some(entry.best_move)
-        } else {
-            None
+        match self.probe(key) {
+            Some(entry) if entry.best_move.is_valid() => Some(entry.best_move),
+            _ => None,
         }
     }
 
     pub fn store(
-        &mut self, key: u64, score: i32, depth: i32, best_move: Move,
+        &self, key: u64, score: i32, depth: i32, best_move: Move,
         entry_type: CacheEntryType,
     ) {
-        let index = (key as usize) & self.table_size_mask;
-        let existing = &self.table[index];
+        let slot = &self.table[(key as usize) & self.table_size_mask];
+        let (existing_key, existing_data) = slot.load();
+        let current_generation = self.current_generation.load(Ordering::Relaxed);
 
         // Replacement strategy
-        if existing.zobrist_key == 0 {
+        if existing_key == 0 {
             // Empty slot — always store
-        } else if existing.zobrist_key == key {
+        } else if existing_key == key {
             // Same position — replace if depth >= existing
-            if depth < existing.depth {
+            if depth < CacheEntry::unpack(existing_data).depth {
                 return;
             }
         } else {
             // Collision — importance-based replacement with aging
+            let existing = CacheEntry::unpack(existing_data);
             let new_importance = depth;
             let existing_importance = existing.depth;
             let age_diff =
-                self.current_generation.wrapping_sub(existing.generation) as i32;
+                (current_generation.wrapping_sub(existing.generation) & GENERATION_MASK) as i32;
             let adjusted_existing = existing_importance - age_diff * 10;
 
             if new_importance < adjusted_existing {
@@ -154,24 +251,26 @@ impl TranspositionTable {
             }
         }
 
-        self.table[index] = CacheEntry {
-            zobrist_key: key,
+        let entry = CacheEntry {
             score,
             depth,
             best_move,
-            generation: self.current_generation,
+            generation: current_generation,
             entry_type,
         };
+        slot.store(key, entry.pack());
     }
 
-    pub fn increment_generation(&mut self) {
-        self.current_generation += 1;
+    pub fn increment_generation(&self) {
+        self.current_generation.fetch_add(1, Ordering::Relaxed);
     }
 
     pub fn clear(&mut self) {
-        for entry in self.table.iter_mut() {
-            *entry = CacheEntry::empty();
+        // SAFETY: &mut self excludes concurrent searches; zeroed slots are
+        // empty (see allocate_zeroed)
+        unsafe {
+            std::ptr::write_bytes(self.table.as_mut_ptr(), 0, self.table.len());
         }
-        self.current_generation = 0;
+        self.current_generation.store(0, Ordering::Relaxed);
     }
 }
@@ -0,0 +1,178 @@
+// ============================================
+// Differential tests: bitboard RuleEngine / Evaluator against the
+// cell-by-cell scans in reference.rs, on random positions
+//
+// cargo test --release
+// ============================================
+
+use gomoku_ai_rust::bitboard::Bitboard;
+use gomoku_ai_rust::evaluator::Evaluator;
+use gomoku_ai_rust::game_types::*;
+use gomoku_ai_rust::reference::{ScanEvaluator, ScanRules};
+use gomoku_ai_rust::rule_engine::RuleEngine;
+
+struct Rng(u64);
+
+impl Rng {
+    fn next(&mut self) -> u64 {
+        self.0 ^= self.0 << 13;
+        self.0 ^= self.0 >> 7;
+        self.0 ^= self.0 << 17;
+        self.0
+    }
+
+    fn below(&mut self, n: u32) -> i32 {
+        (self.next() % n as u64) as i32
+    }
+}
+
+/// Stones scattered with the given fill percentage: dense boards are
+/// full of fives and captures, sparse ones of open threes
+fn random_position(rng: &mut Rng, fill_percent: u32) -> GameState {
+    let mut state = GameState::new();
+    for x in 0..BOARD_SIZE as i32 {
+        for y in 0..BOARD_SIZE as i32 {
+            if (rng.below(100) as u32) < fill_percent {
+                state.place_piece(x, y, 1 + rng.below(2));
+            }
+        }
+    }
+    state.captures = [rng.below(10), rng.below(10)];
+    state.current_player = 1 + rng.below(2);
+    state
+}
+
+/// Random legal game near the centre, played through RuleEngine::apply_move
+fn played_position(rng: &mut Rng, moves: usize) -> GameState {
+    let mut state = GameState::new();
+    let mut tries = 0;
+    while (state.turn_count as usize) < moves && tries < 10 * moves {
+        tries += 1;
+        let mv = Move::new(BOARD_CENTER - 6 + rng.below(13), BOARD_CENTER - 6 + rng.below(13));
+        if !state.is_empty(mv.x, mv.y) {
+            continue;
+        }
+        let result = RuleEngine::apply_move(&mut state, &mv);
+        if result.success && result.creates_win {
+            break;
+        }
+    }
+    state
+}
+
+fn positions(seed: u64) -> Vec<GameState> {
+    let mut rng = Rng(seed);
+    let mut positions = Vec::new();
+    for i in 0..120 {
+        positions.push(random_position(&mut rng, [4, 10, 20, 35, 55][i % 5]));
+        positions.push(played_position(&mut rng, 10 + i % 60));
+    }
+    positions
+}
+
+fn assert_stones_match_board(state: &GameState) {
+    for x in 0..BOARD_SIZE as i32 {
+        for y in 0..BOARD_SIZE as i32 {
+            let piece = state.get_piece(x, y);
+            assert_eq!(state.stones[0].test(x, y), piece == PLAYER1, "({}, {})", x, y);
+            assert_eq!(state.stones[1].test(x, y), piece == PLAYER2, "({}, {})", x, y);
+        }
+    }
+}
+
+#[test]
+fn shifted_moves_every_cell_one_step() {
+    let mut rng = Rng(0x1234_5678);
+    for _ in 0..50 {
+        let stones = random_position(&mut rng, 30).stones[0];
+        for &(dx, dy) in ALL_DIRECTIONS.iter() {
+            let moved = stones.shifted(dx, dy);
+            for x in 0..BOARD_SIZE as i32 {
+                for y in 0..BOARD_SIZE as i32 {
+                    assert_eq!(moved.test(x, y), stones.test(x - dx, y - dy));
+                }
+            }
+        }
+        assert_eq!((!stones).count() + stones.count(), 361);
+        assert_eq!(stones.cells().count() as u32, stones.count());
+    }
+}
+
+#[test]
+fn stones_follow_moves_and_captures() {
+    let mut rng = Rng(0xC0FF_EE00);
+    for _ in 0..40 {
+        let state = played_position(&mut rng, 80);
+        assert_stones_match_board(&state);
+    }
+
+    // X O O _ : X at (9, 12) captures (9, 10) and (9, 11)
+    let mut state = GameState::new();
+    for &(y, player) in [(9, PLAYER1), (10, PLAYER2), (11, PLAYER2)].iter() {
+        state.place_piece(9, y, player);
+    }
+    let result = RuleEngine::apply_move(&mut state, &Move::new(9, 12));
+    assert_eq!(result.my_captured_pieces.len(), 2);
+    assert!(state.stones_of(PLAYER2).is_empty());
+    assert_eq!(state.stones_of(PLAYER1).count(), 2);
+    assert_stones_match_board(&state);
+}
+
+#[test]
+fn check_win_matches_scan() {
+    let mut fives = 0;
+    for state in positions(0x5EED_0001) {
+        for player in [PLAYER1, PLAYER2] {
+            let win = RuleEngine::check_win(&state, player);
+            assert_eq!(win, ScanRules::check_win(&state, player));
+            fives += win as i32;
+        }
+    }
+    assert!(fives > 0, "no winning positions generated");
+}
+
+#[test]
+fn double_free_three_matches_scan() {
+    let mut banned = 0;
+    for state in positions(0x5EED_0002) {
+        for x in 0..BOARD_SIZE as i32 {
+            for y in 0..BOARD_SIZE as i32 {
+                if !state.is_empty(x, y) {
+                    continue;
+                }
+                let mv = Move::new(x, y);
+                for player in [PLAYER1, PLAYER2] {
+                    let double = RuleEngine::creates_double_free_three(&state, &mv, player);
+                    assert_eq!(double, ScanRules::creates_double_free_three(&state, &mv, player));
+                    banned += double as i32;
+                }
+            }
+        }
+    }
+    assert!(banned > 0, "no double free-three generated");
+}
+
+#[test]
+fn patterns_and_evaluation_match_scan() {
+    for state in positions(0x5EED_0003) {
+        for player in [PLAYER1, PLAYER2] {
+            assert_eq!(
+                Evaluator::count_all_patterns(&state, player),
+                ScanEvaluator::count_all_patterns(&state, player)
+            );
+            assert_eq!(
+                Evaluator::evaluate_for_player(&state, player),
+                ScanEvaluator::evaluate_for_player(&state, player)
+            );
+        }
+        assert_eq!(Evaluator::evaluate_simple(&state), ScanEvaluator::evaluate_simple(&state));
+    }
+}
+
+#[test]
+fn empty_board_has_no_patterns() {
+    let state = GameState::new();
+    assert_eq!(state.stones, [Bitboard::EMPTY; 2]);
+    assert!(!RuleEngine::check_win(&state, PLAYER1));
+    assert_eq!(Evaluator::evaluate_simple(&state), 0);
+}
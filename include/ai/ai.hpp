@@ -2,8 +2,11 @@
 #define AI_HPP
 
 #include "../core/game_types.hpp"
+#include "rust_ai_wrapper.hpp"
 #include "transposition_search.hpp"
 #include <cstddef>
+#include <string>
+#include <vector>
 
 enum AIImplementation {
     CPP_IMPLEMENTATION,
@@ -12,8 +15,11 @@ enum AIImplementation {
 
 class AI {
 public:
-    AI(int searchDepth = 10, AIImplementation impl = CPP_IMPLEMENTATION)
-        : depth(searchDepth), implementation(impl) {}
+    // tableSizeMB sizes both transposition tables (0 = each engine's default)
+    AI(int searchDepth = 10, AIImplementation impl = CPP_IMPLEMENTATION, size_t tableSizeMB = 0)
+        : depth(searchDepth), implementation(impl), timeLimitMs(0),
+          searchEngine(tableSizeMB > 0 ? tableSizeMB : TranspositionSearch::DEFAULT_TABLE_MB),
+          rustEngine((int)tableSizeMB) {}
     
     // Get best move for the current state
     Move getBestMove(const GameState& state);
@@ -27,6 +33,18 @@ public:
     // Set AI implementation
     void setImplementation(AIImplementation impl) { implementation = impl; }
     AIImplementation getImplementation() const { return implementation; }
+    // Lazy SMP threads for the Rust engine (default 1)
+    void setRustThreads(int threads) { rustEngine.setThreads(threads); }
+    // Wall-clock budget per search in ms (0 = depth limit only)
+    void setTimeLimit(int milliseconds) { timeLimitMs = milliseconds; searchEngine.setTimeLimit(milliseconds); }
+    int getTimeLimit() const { return timeLimitMs; }
+    // Reallocate both transposition tables, clearing them (0 = engine defaults)
+    void setTableSize(size_t megabytes) { setTableSizes(megabytes, megabytes); }
+    // Same, with a size per engine (e.g. the minimum for the one not in use)
+    void setTableSizes(size_t cppMegabytes, size_t rustMegabytes) {
+        searchEngine.resizeTable(cppMegabytes > 0 ? cppMegabytes : TranspositionSearch::DEFAULT_TABLE_MB);
+        rustEngine.setTableSize((int)rustMegabytes);
+    }
     
     // Get statistics from last search
     int getLastNodesEvaluated() const { return lastResult.nodesEvaluated; }
@@ -34,9 +52,12 @@ public:
     int getLastCacheHits() const { return lastResult.cacheHits; }
     float getLastCacheHitRate() const { return lastResult.cacheHitRate; }
     size_t getCacheSize() const { return searchEngine.getCacheSize(); }
+    // Per-iteration telemetry of the last search (Rust: depth, move, score, nodes, TT hits, time)
+    const std::vector<SearchStats>& getLastSearchStats() const { return lastSearchStats; }
+    void setStatsLogFile(const std::string& filename) { searchEngine.setStatsLogFile(filename); }
     
     // Cache management
-    void clearCache() { searchEngine.clearCache(); }
+    void clearCache() { searchEngine.clearCache(); rustEngine.clearCache(); }
     
     // Additional functions for game engine integration
     TranspositionSearch::SearchResult findBestMoveIterative(const GameState& state, int maxDepth);
@@ -46,8 +67,11 @@ public:
 private:
     int depth;
     AIImplementation implementation;
+    int timeLimitMs;
     TranspositionSearch searchEngine;
+    RustAIWrapper rustEngine; // Handle created on the first Rust search
     TranspositionSearch::SearchResult lastResult;
+    std::vector<SearchStats> lastSearchStats;
 };
 
 #endif
\ No newline at end of file
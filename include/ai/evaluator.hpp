@@ -4,29 +4,78 @@
 #include "../core/game_types.hpp"
 #include "../utils/directions.hpp"
 #include "../debug/debug_types.hpp"
+#include "evaluator_weights.hpp"
+#include <cstdint>
+#include <string>
+
+/**
+ * Feature counts behind Evaluator::evaluate: for each weight in
+ * EvalWeights, how many times PLAYER2's evaluation adds it minus how many
+ * times PLAYER1's does. Below a five on the board,
+ *   evaluate(state) == sum of counts[t] * DEFAULT_WEIGHTS[t]
+ * which lets a tuner re-score positions with other weights at the cost of
+ * a dot product instead of a board scan.
+ */
+struct EvalFeatures
+{
+	enum Term
+	{
+		PATTERN_FIVE, FOUR_OPEN, FOUR_HALF, THREE_OPEN, THREE_HALF, TWO_OPEN,
+		THREAT_FOUR_OPEN, THREAT_FOUR_HALF, THREAT_DOUBLE_THREE,
+		FORK_FOUR_THREE, FORK_DOUBLE_FOUR, FORK_CAPTURES_THREE,
+		HELD_9, HELD_8, HELD_6, HELD_4, HELD_PAIR,
+		LOST_9, LOST_8, LOST_6, LOST_4, LOST_PAIR,
+		CAPTURE_WIN, CAPTURE_TO_9, CAPTURE_TO_8, CAPTURE_TO_6, CAPTURE_PAIRS,
+		BREAKS_FOUR, BREAKS_THREE, BREAKS_TWO, OPENS_LINE, CAPTURE_UNDER_PRESSURE,
+		TERM_COUNT
+	};
+
+	static const char *const NAMES[TERM_COUNT];	  // As in evaluator_weights.hpp
+	static const int DEFAULT_WEIGHTS[TERM_COUNT]; // EvalWeights values
+
+	int16_t counts[TERM_COUNT];
+
+	int score(const int *weights) const;
+	// Same dot product over unclamped counts
+	static int score(const int *terms, const int *weights);
+};
 
 class Evaluator
 {
 public:
 	static constexpr int WIN = 600000;
-	static constexpr int FOUR_OPEN = 50000;
-	static constexpr int FOUR_HALF = 25000;
-	static constexpr int THREE_OPEN = 10000;
-	static constexpr int THREE_HALF = 1500;
-	static constexpr int TWO_OPEN = 100;
-	static constexpr int CAPTURE_OPPORTUNITY = 5000;
-	static constexpr int CAPTURE_THREAT = 6000;
-	static constexpr int CAPTURE_WIN = 500000;
-	static constexpr int CAPTURE_PREVENT_LOSS = 400000;
+	static constexpr int FOUR_OPEN = EvalWeights::FOUR_OPEN;
+	static constexpr int FOUR_HALF = EvalWeights::FOUR_HALF;
+	static constexpr int THREE_OPEN = EvalWeights::THREE_OPEN;
+	static constexpr int THREE_HALF = EvalWeights::THREE_HALF;
+	static constexpr int TWO_OPEN = EvalWeights::TWO_OPEN;
+	static constexpr int CAPTURE_WIN = EvalWeights::CAPTURE_WIN;
 
 	static int evaluateForPlayer(const GameState &state, int player);
 
+	// Switches evaluate() to the NNUE network in `filename` (ai/nnue.hpp);
+	// false, handcrafted evaluation kept, if it cannot be loaded
+	static bool loadNetwork(const std::string &filename);
+
+	// Back to the handcrafted evaluation
+	static void unloadNetwork();
+
+	static bool usingNetwork() { return GameState::network != nullptr; }
+
 	// Evaluate position with mate distance scoring
 	static int evaluate(const GameState &state, int maxDepth, int currentDepth);
 
 	// Evaluate position (without mate distance)
 	static int evaluate(const GameState &state);
 
+	// Same score with runtime weights (EvalFeatures::Term order); the
+	// tuner's reference, far slower than evaluate()
+	static int evaluate(const GameState &state, const int *weights);
+
+	// Feature counts of a position; evaluate() is their dot product with
+	// EvalFeatures::DEFAULT_WEIGHTS unless a five is on the board
+	static void extractFeatures(const GameState &state, EvalFeatures &features);
+
 	static int evaluateImmediateThreats(const GameState &state, int player);
 
 	// Detect advantageous pattern combinations (forks)
@@ -51,9 +100,23 @@ public:
 	// Single-pass scan that returns all pattern counts at once
 	static PatternCounts countAllPatterns(const GameState &state, int player);
 
+	// Both players' counts from one scan of the board's lines
+	// (ai/pattern_scanner.hpp)
+	static void countAllPatterns(const GameState &state, PatternCounts &player1, PatternCounts &player2);
+
+	// Same counts from analyzeLine at every line start: the scanner's
+	// reference, several times slower
+	static PatternCounts countAllPatternsScan(const GameState &state, int player);
+
+	// evaluateForPlayer with the player's pattern counts already taken
+	static int evaluateForPlayer(const GameState &state, int player, const PatternCounts &counts);
+
 	// Threat + combination evaluation using pre-computed pattern counts
 	static int evaluateThreatsAndCombinations(const GameState &state, int player, const PatternCounts &counts);
 
+	// Unified pattern + capture scan for one player (public for microbenchmarks)
+	static int analyzePosition(const GameState &state, int player);
+
 private:
 	struct PatternInfo
 	{
@@ -66,12 +129,11 @@ private:
 		int maxReachable;     // Total reachable cells in this direction (must be >= 5 for viable pattern)
 	};
 
-	static int analyzePosition(const GameState &state, int player);
-
 	static PatternInfo analyzeLine(const GameState &state, int x, int y,
 								   int dx, int dy, int player);
 
-	static int patternToScore(const PatternInfo &pattern);
+	// EvalFeatures::Term the pattern scores as, or -1 for none
+	static int patternTerm(const PatternInfo &pattern);
 
 	static bool isLineStart(const GameState &state, int x, int y, int dx, int dy, int player);
 
@@ -89,17 +151,24 @@ private:
     static std::vector<CaptureOpportunity> findAllCaptureOpportunities(
         const GameState& state, int player);
     
-    static int evaluateCaptureContext(
-        const GameState& state,
-        int player,
-        const std::vector<Move>& capturedPieces,
-        int newCaptureCount);
-    
     static int countPatternThroughPosition(
         const GameState& state,
         const Move& pos,
         int dx, int dy,
         int player);
+
+    // Add one player's EvalFeatures terms to terms, with `sign` (+1 for
+    // PLAYER2, -1 for PLAYER1); the scorers above are their dot products
+    // with EvalFeatures::DEFAULT_WEIGHTS
+    static void addPlayerFeatures(const GameState& state, int player, const PatternCounts& counts,
+                                  int sign, int* terms);
+    static void addThreatFeatures(const GameState& state, int player, const PatternCounts& counts,
+                                  int sign, int* terms);
+    static void addPositionFeatures(const GameState& state, int player, int sign, int* terms);
+    // One capture by `player`, in context of the game state
+    static void addCaptureFeatures(const GameState& state, int player,
+                                   const std::vector<Move>& capturedPieces,
+                                   int newCaptureCount, int sign, int* terms);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,54 @@
+#ifndef EVALUATOR_WEIGHTS_HPP
+#define EVALUATOR_WEIGHTS_HPP
+
+/**
+ * Evaluator weights: every constant Evaluator::evaluate adds up
+ *
+ * tests/tune writes a file of this exact form with fitted values
+ * (see README, Evaluator Tuning); names match EvalFeatures::NAMES.
+ */
+namespace EvalWeights
+{
+	// Line patterns, per line (a split five, X-XXXX, scores Evaluator::WIN)
+	constexpr int FOUR_OPEN = 50000;
+	constexpr int FOUR_HALF = 25000;
+	constexpr int THREE_OPEN = 10000;
+	constexpr int THREE_HALF = 1500;
+	constexpr int TWO_OPEN = 100;
+
+	// Threats and forks, once per player
+	constexpr int THREAT_FOUR_OPEN = 90000;
+	constexpr int THREAT_FOUR_HALF = 40000;
+	constexpr int THREAT_DOUBLE_THREE = 50000;
+	constexpr int FORK_FOUR_THREE = 80000;
+	constexpr int FORK_DOUBLE_FOUR = 70000;
+	constexpr int FORK_CAPTURES_THREE = 60000;
+
+	// Pairs already captured by the player
+	constexpr int HELD_9 = 300000;
+	constexpr int HELD_8 = 200000;
+	constexpr int HELD_6 = 15000;
+	constexpr int HELD_4 = 6000;
+	constexpr int HELD_PAIR = 500; // Per pair, below 4
+
+	// Pairs already captured by the opponent (subtracted)
+	constexpr int LOST_9 = 400000;
+	constexpr int LOST_8 = 300000;
+	constexpr int LOST_6 = 20000;
+	constexpr int LOST_4 = 8000;
+	constexpr int LOST_PAIR = 800;
+
+	// Capture opportunities (added) and threats (subtracted), per capture
+	constexpr int CAPTURE_WIN = 500000;
+	constexpr int CAPTURE_TO_9 = 100000;
+	constexpr int CAPTURE_TO_8 = 50000;
+	constexpr int CAPTURE_TO_6 = 15000;
+	constexpr int CAPTURE_PAIRS = 2000; // Per pair held after the capture, below 6
+	constexpr int BREAKS_FOUR = 30000;
+	constexpr int BREAKS_THREE = 12000;
+	constexpr int BREAKS_TWO = 3000;
+	constexpr int OPENS_LINE = 1500;
+	constexpr int CAPTURE_UNDER_PRESSURE = 25000;
+}
+
+#endif // EVALUATOR_WEIGHTS_HPP
@@ -0,0 +1,79 @@
+#ifndef FFI_POSITION_HPP
+#define FFI_POSITION_HPP
+
+#include "../core/game_types.hpp"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * FfiPosition: position passed by pointer between C++ and the Rust engine
+ *
+ * Plain C layout with no padding, mirrored field for field by
+ * FfiPosition in gomoku_ai_rust/src/ffi_position.rs. Both sides check the
+ * size and offsets at compile time, so a change here that is not made
+ * there fails the build instead of corrupting positions.
+ *
+ * - cells: row-major [x * 19 + y], 0 = empty, 1 = PLAYER1, 2 = PLAYER2
+ * - lastMove: last human move (-1, -1 if none), used by move ordering
+ * - forcedCaptures: captures that may break a five (see GameEngine);
+ *   carried for completeness, neither search restricts moves with them
+ *
+ * Arrays of FfiPosition are contiguous, so batch calls take a pointer
+ * and a count.
+ */
+static const int FFI_MAX_FORCED_CAPTURES = 16;
+
+extern "C" {
+    struct FfiMove8 {
+        int8_t x, y;
+    };
+
+    struct FfiPosition {
+        int32_t turnCount;
+        uint8_t cells[GameState::BOARD_SIZE * GameState::BOARD_SIZE];
+        uint8_t currentPlayer;
+        uint8_t captures[2];
+        uint8_t forcedCapturePlayer; // 0 = none
+        int8_t lastMoveX, lastMoveY;
+        uint8_t forcedCaptureCount;
+        FfiMove8 forcedCaptures[FFI_MAX_FORCED_CAPTURES];
+    };
+}
+
+static_assert(sizeof(FfiPosition) == 404, "FfiPosition layout must match ffi_position.rs");
+static_assert(offsetof(FfiPosition, cells) == 4 && offsetof(FfiPosition, currentPlayer) == 365 &&
+              offsetof(FfiPosition, forcedCaptureCount) == 371 && offsetof(FfiPosition, forcedCaptures) == 372,
+              "FfiPosition layout must match ffi_position.rs");
+
+// Single pass over the board; the zobrist hash is recomputed on the Rust side
+inline FfiPosition packPosition(const GameState& state) {
+    FfiPosition position;
+    position.turnCount = state.turnCount;
+    uint8_t* cell = position.cells;
+    for (int i = 0; i < GameState::BOARD_SIZE; ++i) {
+        for (int j = 0; j < GameState::BOARD_SIZE; ++j) {
+            *cell++ = (uint8_t)state.board[i][j];
+        }
+    }
+    position.currentPlayer = (uint8_t)state.currentPlayer;
+    position.captures[0] = (uint8_t)state.captures[0];
+    position.captures[1] = (uint8_t)state.captures[1];
+    position.forcedCapturePlayer = (uint8_t)state.forcedCapturePlayer;
+    position.lastMoveX = (int8_t)state.lastHumanMove.x;
+    position.lastMoveY = (int8_t)state.lastHumanMove.y;
+
+    int count = 0;
+    for (const Move& capture : state.forcedCaptureMoves) {
+        if (count == FFI_MAX_FORCED_CAPTURES) break;
+        position.forcedCaptures[count].x = (int8_t)capture.x;
+        position.forcedCaptures[count].y = (int8_t)capture.y;
+        count++;
+    }
+    position.forcedCaptureCount = (uint8_t)count;
+    for (int i = count; i < FFI_MAX_FORCED_CAPTURES; ++i) {
+        position.forcedCaptures[i].x = position.forcedCaptures[i].y = -1;
+    }
+    return position;
+}
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef GAME_ANALYZER_HPP
+#define GAME_ANALYZER_HPP
+
+#include "../core/game_types.hpp"
+#include "../utils/game_record.hpp"
+#include "transposition_search.hpp"
+#include <cstdint>
+#include <vector>
+
+/**
+ * GameAnalyzer: per-move re-search of a recorded game (tests/analyze)
+ *
+ * Every position of the game is searched; for each move the engine's
+ * choice is compared with the move actually played. Scores are from the
+ * point of view of the player to move.
+ *
+ * The played move is scored at the same horizon as the engine's choice:
+ * a root search to depth d sees each of its moves d - 1 plies past it,
+ * so the played move's score is minus the next position's score after
+ * d - 1 plies (the static evaluation for d = 1), or a win if the move
+ * ended the game. d is the depth the search completed, or the requested
+ * one when it stopped early on a win or loss. loss = best - played, 0
+ * when the engine agrees.
+ *
+ * The caller's table is cleared first and then kept warm across the
+ * game, so the result does not depend on what the table searched before.
+ */
+class GameAnalyzer
+{
+public:
+	struct MoveAnalysis
+	{
+		int player;		 // Who played it
+		Move played;
+		Move best;		 // Engine's choice in the same position
+		int score;		 // Of the best move
+		int playedScore; // Of the played move, same horizon
+		int loss;		 // max(0, score - playedScore)
+		int depth;		 // Completed depth of the position's search
+		int nodes;
+	};
+
+	struct Result
+	{
+		std::vector<MoveAnalysis> moves;
+		uint64_t nodes = 0; // All searches, the next-position ones included
+		bool complete = true; // false: moves.size() is the ply of an illegal move
+	};
+
+	static Result analyze(TranspositionSearch &search, const GameRecord &record, int depth);
+};
+
+#endif // GAME_ANALYZER_HPP
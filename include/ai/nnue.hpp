@@ -0,0 +1,109 @@
+#ifndef NNUE_HPP
+#define NNUE_HPP
+
+#include "../core/game_types.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Small CPU neural evaluator (NNUE-style), an alternative to the
+ * handcrafted Evaluator::evaluate (see Evaluator::loadNetwork)
+ *
+ * Inputs, per perspective (PLAYER1, PLAYER2), 744 binary features:
+ *   - own stone / opponent stone on each of the 361 cells
+ *   - pairs captured by self / by the opponent, one-hot 0..10
+ *
+ * Layers:
+ *   - Feature transformer: 744 -> 64 int16 per perspective. Its sums
+ *     (GameState::nnue) are updated by RuleEngine::applyMove with the
+ *     stone placed, the stones captured and the capture count change,
+ *     instead of being recomputed for every leaf
+ *   - Side to move's 64 sums then the other side's, clipped to 0..127
+ *   - 128 -> 16, int8 weights, int32 bias, >> L1_SHIFT, clipped to 0..127
+ *   - 16 -> 1, int8 weights, int32 bias, times outputScale / OUTPUT_DIVISOR
+ * The 128 -> 16 layer runs on AVX2 or SSSE3 when the CPU has them (picked
+ * at runtime), otherwise in plain C++; all give the same integers.
+ *
+ * Weight file, little-endian:
+ *   "GMKN", version 1, board size 19, 2 reserved bytes
+ *   uint16 inputs (744), hidden (64), l1 (16), reserved; int32 outputScale
+ *   int16 ftBias[64], int16 ftWeights[744][64]
+ *   int32 l1Bias[16], int8 l1Weights[16][128]
+ *   int32 outBias, int8 outWeights[16]
+ * Scores are for the side to move, in Evaluator units.
+ */
+class NnueNetwork
+{
+public:
+	static constexpr int CELLS = GameState::BOARD_SIZE * GameState::BOARD_SIZE;
+	static constexpr int CAPTURE_STATES = GameState::WIN_CAPTURES_NORMAL + 1;
+	static constexpr int CAPTURE_FEATURES = 2 * CELLS;
+	static constexpr int INPUTS = 2 * CELLS + 2 * CAPTURE_STATES;
+	static constexpr int HIDDEN = NnueAccumulator::SIZE;
+	static constexpr int L1_INPUTS = 2 * HIDDEN;
+	static constexpr int L1 = 16;
+	static constexpr int L1_SHIFT = 6;
+	static constexpr int OUTPUT_DIVISOR = 1024;
+	// Keeps network scores clear of the win scores the search relies on
+	static constexpr int MAX_SCORE = 300000;
+
+	enum Kernel
+	{
+		SCALAR,
+		SSSE3,
+		AVX2
+	};
+
+	NnueNetwork();
+
+	// false, weights unchanged, if the file is missing or malformed
+	bool load(const std::string &filename);
+	bool save(const std::string &filename) const;
+
+	// Small random weights: tests and file format checks, not play
+	void randomize(uint64_t seed);
+
+	// Score for the side to move; refreshes state.nnue if it is stale
+	int evaluate(const GameState &state) const;
+
+	// Accumulator recomputed from the whole board
+	void refresh(const GameState &state, NnueAccumulator &accumulator) const;
+
+	// Accumulator delta of one RuleEngine::applyMove by `player`
+	void update(NnueAccumulator &accumulator, const Move &move, int player,
+				const std::vector<Move> &capturedPieces, int oldCaptures, int newCaptures) const;
+
+	// Changes whenever the weights do: accumulators built with other
+	// weights are never reused
+	uint32_t getWeightsId() const { return weightsId; }
+
+	static bool kernelSupported(Kernel kernel);
+	static const char *kernelName(Kernel kernel);
+	Kernel getKernel() const { return kernel; }
+	// false if the CPU lacks it
+	bool setKernel(Kernel newKernel);
+
+private:
+	std::vector<int16_t> ftBias;	// [HIDDEN]
+	std::vector<int16_t> ftWeights; // [INPUTS][HIDDEN]
+	std::vector<int32_t> l1Bias;	// [L1]
+	std::vector<int8_t> l1Weights;	// [L1][L1_INPUTS]
+	int32_t outBias;
+	std::vector<int8_t> outWeights; // [L1]
+	int32_t outputScale;
+	Kernel kernel;
+	uint32_t weightsId;
+
+	static uint32_t nextWeightsId();
+
+	// Feature index of `piece` on `cell`, and of `player` holding `count`
+	// pairs, as seen by perspective `view` (0 = PLAYER1, 1 = PLAYER2)
+	static int stoneFeature(int view, int piece, int cell);
+	static int captureFeature(int view, int player, int count);
+
+	void addFeature(NnueAccumulator &accumulator, int view, int feature) const;
+	void subFeature(NnueAccumulator &accumulator, int view, int feature) const;
+};
+
+#endif // NNUE_HPP
@@ -0,0 +1,40 @@
+#ifndef PATTERN_SCANNER_HPP
+#define PATTERN_SCANNER_HPP
+
+#include "evaluator.hpp"
+
+/**
+ * Whole-board pattern counting on the board's line bitsets
+ * (Evaluator::countAllPatterns)
+ *
+ * Every row, column and diagonal already holds a bitset of each player's
+ * stones (core/board.hpp). Each run of stones is classified with bit
+ * operations on its line's words, for both players in the same pass:
+ * one run at a time (scalar), or every run of 4 (SSE2) or 8 (AVX2) lines
+ * at once with shifts and logic ops, picked at runtime.
+ *
+ * The counts are exactly those of Evaluator::countAllPatternsScan, the
+ * per-stone analyzeLine scan kept as the reference.
+ */
+class PatternScanner
+{
+public:
+	enum Kernel
+	{
+		SCALAR,
+		SSE2,
+		AVX2
+	};
+
+	static void count(const GameState &state, Evaluator::PatternCounts &player1,
+					  Evaluator::PatternCounts &player2);
+
+	static bool kernelSupported(Kernel kernel);
+	static const char *kernelName(Kernel kernel);
+	static Kernel getKernel();
+	// false if the CPU lacks it; for tests and microbenchmarks, not
+	// while searches are running
+	static bool setKernel(Kernel kernel);
+};
+
+#endif // PATTERN_SCANNER_HPP
@@ -2,66 +2,186 @@
 #define RUST_AI_WRAPPER_HPP
 
 #include "../core/game_types.hpp"
+#include "ffi_position.hpp"
+#include "search_stats.hpp"
+#include "transposition_types.hpp"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
 
 // Forward declarations for Rust FFI
+// Positions are passed by pointer as FfiPosition (ffi_position.hpp)
 extern "C" {
     struct RustMove {
         int x, y;
     };
 
-    RustMove rust_ai_get_best_move(
-        const int* board, int current_player, int turn_count,
-        int captures_p1, int captures_p2,
-        int last_move_x, int last_move_y,
-        int max_depth
-    );
-    int rust_ai_evaluate_position(
-        const int* board, int current_player, int turn_count,
-        int captures_p1, int captures_p2
+    // Must match FfiSearchResult in gomoku_ai_rust/src/lib.rs
+    struct RustSearchResult {
+        RustMove bestMove;
+        int score;
+        int depthSearched;
+        int nodesEvaluated;
+        int cacheHits;
+        int64_t elapsedUs;
+    };
+
+    // Called by rust_ai_search after each completed iteration
+    typedef void (*RustIterationCallback)(const RustSearchResult* result, void* userData);
+
+    RustMove rust_ai_get_best_move(const FfiPosition* position, int max_depth);
+    RustSearchResult rust_ai_search_position(const FfiPosition* position, int max_depth);
+    int rust_ai_evaluate_position(const FfiPosition* position);
+    void rust_ai_evaluate_positions(const FfiPosition* positions, int count, int* scores);
+
+    // Persistent engine (opaque): keeps its transposition table between searches
+    struct RustEngine;
+    RustEngine* rust_ai_create(int tt_mb, int threads);
+    void rust_ai_set_threads(RustEngine* handle, int threads);
+    void rust_ai_destroy(RustEngine* handle);
+    void rust_ai_clear(RustEngine* handle);
+    RustSearchResult rust_ai_search(
+        RustEngine* handle,
+        const FfiPosition* position, int max_depth,
+        RustIterationCallback on_iteration, void* user_data,
+        const std::atomic<int>* stop_flag // Read by Rust as an AtomicI32
     );
 }
 
+static_assert(sizeof(std::atomic<int>) == sizeof(int32_t) && std::atomic<int>::is_always_lock_free,
+              "stop flag must be layout-compatible with Rust's AtomicI32");
+
+/**
+ * RustAIWrapper: C++ access to the Rust engine
+ *
+ * Static functions run a one-shot search on a fresh engine. An instance
+ * owns a persistent engine handle (created on first search) whose
+ * transposition table, history and killers carry over between moves,
+ * like the TranspositionSearch owned by AI.
+ */
 class RustAIWrapper {
 public:
-    static Move getBestMove(const GameState& state, int maxDepth) {
-        // Convert GameState board to flat array
-        int flat_board[19 * 19];
-        for (int i = 0; i < 19; ++i) {
-            for (int j = 0; j < 19; ++j) {
-                flat_board[i * 19 + j] = state.board[i][j];
-            }
-        }
-
-        RustMove rust_move = rust_ai_get_best_move(
-            flat_board,
-            state.currentPlayer,
-            state.turnCount,
-            state.captures[0],
-            state.captures[1],
-            state.lastHumanMove.x,
-            state.lastHumanMove.y,
-            maxDepth
+    // Receives one SearchStats per completed depth; only depth, bestMove,
+    // score, nodes, ttHits, wallTimeMs and nodesPerSecond are filled
+    using IterationListener = std::function<void(const SearchStats&)>;
+
+    // threads > 1 runs a Lazy SMP search (helper threads share the table)
+    explicit RustAIWrapper(int ttMegabytes = 0, int threads = 1)
+        : handle(nullptr), ttMB(ttMegabytes), threadCount(threads), lastDepth(0), lastElapsedUs(0) {}
+    ~RustAIWrapper() { rust_ai_destroy(handle); }
+
+    RustAIWrapper(const RustAIWrapper&) = delete;
+    RustAIWrapper& operator=(const RustAIWrapper&) = delete;
+
+    // stopFlag: set to non-zero from another thread to cancel; the result
+    // of the last completed iteration is returned
+    SearchResult findBestMove(const GameState& state, int maxDepth,
+                              const IterationListener& onIteration = nullptr,
+                              const std::atomic<int>* stopFlag = nullptr) {
+        if (!handle)
+            handle = rust_ai_create(ttMB, threadCount);
+
+        FfiPosition position = packPosition(state);
+        IterationContext context = {&onIteration, 0, 0, 0};
+        RustSearchResult rust_result = rust_ai_search(
+            handle,
+            &position,
+            maxDepth,
+            onIteration ? &RustAIWrapper::forwardIteration : nullptr,
+            &context,
+            stopFlag
         );
+        lastDepth = rust_result.depthSearched;
+        lastElapsedUs = rust_result.elapsedUs;
+        return toSearchResult(rust_result);
+    }
+
+    int getLastDepth() const { return lastDepth; }
+    int64_t getLastElapsedUs() const { return lastElapsedUs; }
 
+    // New game: drop everything learned so far (no-op before the first search)
+    void clearCache() { rust_ai_clear(handle); }
+
+    // Takes effect on the next search: the handle is recreated with the new table
+    void setTableSize(int ttMegabytes) {
+        ttMB = ttMegabytes;
+        rust_ai_destroy(handle);
+        handle = nullptr;
+    }
+
+    void setThreads(int threads) {
+        threadCount = threads;
+        rust_ai_set_threads(handle, threads);
+    }
+    int getThreads() const { return threadCount; }
+
+    static Move getBestMove(const GameState& state, int maxDepth) {
+        FfiPosition position = packPosition(state);
+        RustMove rust_move = rust_ai_get_best_move(&position, maxDepth);
         return Move(rust_move.x, rust_move.y);
     }
 
+    // Full search result: move, score, nodes and cache hits
+    static SearchResult search(const GameState& state, int maxDepth) {
+        FfiPosition position = packPosition(state);
+        return toSearchResult(rust_ai_search_position(&position, maxDepth));
+    }
+
     static int evaluatePosition(const GameState& state) {
-        // Convert GameState board to flat array
-        int flat_board[19 * 19];
-        for (int i = 0; i < 19; ++i) {
-            for (int j = 0; j < 19; ++j) {
-                flat_board[i * 19 + j] = state.board[i][j];
-            }
-        }
-
-        return rust_ai_evaluate_position(
-            flat_board,
-            state.currentPlayer,
-            state.turnCount,
-            state.captures[0],
-            state.captures[1]
-        );
+        FfiPosition position = packPosition(state);
+        return rust_ai_evaluate_position(&position);
+    }
+
+    // One FFI call for the whole batch
+    static std::vector<int> evaluatePositions(const std::vector<FfiPosition>& positions) {
+        std::vector<int> scores(positions.size());
+        rust_ai_evaluate_positions(positions.data(), (int)positions.size(), scores.data());
+        return scores;
+    }
+
+private:
+    RustEngine* handle;
+    int ttMB;
+    int threadCount;
+    int lastDepth;
+    int64_t lastElapsedUs;
+
+    // Rust reports cumulative counters; listeners get per-iteration deltas
+    struct IterationContext {
+        const IterationListener* listener;
+        int nodes;
+        int cacheHits;
+        int64_t elapsedUs;
+    };
+
+    static void forwardIteration(const RustSearchResult* result, void* userData) {
+        IterationContext* context = static_cast<IterationContext*>(userData);
+
+        SearchStats stats;
+        stats.depth = result->depthSearched;
+        stats.bestMove = Move(result->bestMove.x, result->bestMove.y);
+        stats.score = result->score;
+        stats.nodes = result->nodesEvaluated - context->nodes;
+        stats.ttHits = result->cacheHits - context->cacheHits;
+        stats.wallTimeMs = (result->elapsedUs - context->elapsedUs) / 1000.0;
+        stats.nodesPerSecond = stats.wallTimeMs > 0.0 ? stats.nodes * 1000.0 / stats.wallTimeMs : 0.0;
+
+        context->nodes = result->nodesEvaluated;
+        context->cacheHits = result->cacheHits;
+        context->elapsedUs = result->elapsedUs;
+        (*context->listener)(stats);
+    }
+
+    static SearchResult toSearchResult(const RustSearchResult& rust_result) {
+        SearchResult result;
+        result.bestMove = Move(rust_result.bestMove.x, rust_result.bestMove.y);
+        result.score = rust_result.score;
+        result.nodesEvaluated = rust_result.nodesEvaluated;
+        result.cacheHits = rust_result.cacheHits;
+        result.cacheHitRate = rust_result.nodesEvaluated > 0 ?
+            (float)rust_result.cacheHits / rust_result.nodesEvaluated : 0.0f;
+        return result;
     }
 };
 
@@ -0,0 +1,63 @@
+#ifndef SEARCH_STATS_HPP
+#define SEARCH_STATS_HPP
+
+#include "../core/game_types.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Per-iteration search telemetry
+ * Filled by TranspositionSearch::findBestMoveIterative, one entry per
+ * completed depth. Counters cover that iteration only (not cumulative),
+ * so move-ordering quality can be compared depth by depth.
+ */
+struct SearchStats
+{
+	int depth;
+	Move bestMove;
+	int score;
+
+	uint64_t nodes;
+	uint64_t leafEvals;
+
+	// Transposition table
+	uint64_t ttProbes;
+	uint64_t ttHits;
+	uint64_t ttCutoffsExact;
+	uint64_t ttCutoffsLower;
+	uint64_t ttCutoffsUpper;
+
+	// Move ordering quality
+	uint64_t betaCutoffs;
+	uint64_t firstMoveCutoffs; // Cutoffs produced by the first legal move
+	uint64_t killerHits;	   // Cutoffs produced by a killer move
+	uint64_t historyHits;	   // Cutoffs produced by a move with history score
+
+	// Late move reductions
+	uint64_t lmrReductions;
+	uint64_t lmrResearches;
+
+	double wallTimeMs;
+	double nodesPerSecond;
+
+	SearchStats() { reset(); }
+
+	void reset();
+
+	uint64_t ttCutoffs() const { return ttCutoffsExact + ttCutoffsLower + ttCutoffsUpper; }
+	double ttHitRate() const { return ttProbes > 0 ? (double)ttHits / ttProbes : 0.0; }
+	double firstMoveCutoffRate() const
+	{
+		return betaCutoffs > 0 ? (double)firstMoveCutoffs / betaCutoffs : 0.0;
+	}
+
+	// Single-line JSON object (no trailing newline)
+	std::string toJson(int searchId = 0, int turn = 0) const;
+
+	// Append one JSON line per iteration; false if the file cannot be opened
+	static bool appendJsonLines(const std::string &filename, const std::vector<SearchStats> &iterations,
+								int searchId, int turn);
+};
+
+#endif // SEARCH_STATS_HPP
@@ -0,0 +1,37 @@
+#ifndef THREAT_SCANNER_HPP
+#define THREAT_SCANNER_HPP
+
+#include "../core/game_types.hpp"
+
+/**
+ * Per-cell threat map (GameState::threats) for move ordering and pruning
+ *
+ * For each player and cell: the best shape a stone there would make (five,
+ * open four, four, open three, three, two; gapped ones included) and
+ * whether it would capture a pair, both read from the board's line
+ * bitsets. quickEvaluateMove scores moves by them, and
+ * generateCandidatesAdaptiveRadius keeps only the forced replies when
+ * either side has a five to make.
+ *
+ * The map is built on first use. RuleEngine::applyMove then keeps it in
+ * step: only the cells within four steps of a changed stone, on its four
+ * lines, are recomputed. A board write the map was not told about (the
+ * board's revision moved) makes the next read rebuild it.
+ */
+class ThreatScanner
+{
+public:
+	// Entry of `player` for (x, y) (ThreatMap bits); rebuilds a stale map
+	static uint8_t entry(const GameState &state, int player, int x, int y);
+
+	// Whole map from the board
+	static void refresh(const GameState &state, ThreatMap &map);
+
+	// Entries the change of one cell can affect
+	static void update(const GameState &state, ThreatMap &map, const Move &changed);
+
+	// Both players' entries for (x, y), computed from the board
+	static void classify(const GameState &state, int x, int y, uint8_t &player1, uint8_t &player2);
+};
+
+#endif // THREAT_SCANNER_HPP
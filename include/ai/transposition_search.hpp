@@ -7,8 +7,11 @@
 #include "../utils/zobrist_hasher.hpp"
 #include "../utils/directions.hpp"
 #include "transposition_types.hpp"
+#include "search_stats.hpp"
+#include <string>
 #include <vector>
 #include <cstdint>
+#include <chrono>
 
 class TranspositionSearch
 {
@@ -18,6 +21,8 @@ public:
 	using CacheEntry = ::CacheEntry;
 	using CacheStats = ::CacheStats;
 
+	static constexpr size_t DEFAULT_TABLE_MB = 64;
+
 private:
 	std::vector<CacheEntry> transpositionTable;
 	size_t tableSizeMask;
@@ -27,6 +32,13 @@ private:
 	int cacheHits;
 	Move previousBestMove;
 
+	// Telemetry: counters for the iteration in progress, completed iterations
+	// of the last search, and optional JSON lines export
+	SearchStats iterationStats;
+	std::vector<SearchStats> lastSearchStats;
+	std::string statsLogFile;
+	int searchCount;
+
 	// History heuristic: tracks moves that caused cutoffs across the search tree
 	// Higher values = move was historically good, used for move ordering
 	int historyTable[GameState::BOARD_SIZE][GameState::BOARD_SIZE];
@@ -36,9 +48,19 @@ private:
 	static constexpr int MAX_SEARCH_DEPTH = 20;
 	Move killerMoves[MAX_SEARCH_DEPTH][2];
 
+	// Time limit (0 = none): minimax polls the clock every TIME_CHECK_NODES
+	// nodes and abandons the iteration in progress once the deadline passes
+	static constexpr int TIME_CHECK_NODES = 256;
+	int timeLimitMs;
+	std::chrono::steady_clock::time_point searchDeadline;
+	bool searchAborted;
+
 	int minimax(GameState &state, int depth, int alpha, int beta, bool maximizing,
 				int originalMaxDepth, Move *bestMove = nullptr);
 
+	void recordCutoff(const Move &move, int depth, int moveIndex);
+	void reportProfile(uint64_t searchStartCycles);
+
 	void orderMoves(std::vector<Move> &moves, const GameState &state);
 
 	int countThreats(const GameState &state, int player);
@@ -48,7 +70,7 @@ private:
 
 	bool lookupTransposition(uint64_t zobristKey, CacheEntry &entry);
 	void storeTransposition(uint64_t zobristKey, int score, int depth, Move bestMove, CacheEntry::Type type);
-	void initializeTranspositionTable(size_t sizeInMB = 64);
+	void initializeTranspositionTable(size_t sizeInMB = DEFAULT_TABLE_MB);
 
 	std::vector<Move> generateCandidatesAdaptiveRadius(const GameState &state);
 	int getSearchRadiusForGamePhase(int pieceCount);
@@ -66,29 +88,31 @@ private:
 
 	int quickCategorizeMove(const GameState &state, const Move &move);
 
-	bool wouldCreateFiveInRow(const GameState &state, const Move &move, int player);
-	bool createsFourInRow(const GameState &state, const Move &move, int player);
-	bool createsThreeInRow(const GameState &state, const Move &move, int player);
-	bool hasImmediateCapture(const GameState &state, const Move &move, int player);
 	bool isNearExistingPieces(const GameState &state, const Move &move);
 
-	bool blocksOpponentWin(const GameState &state, const Move &move, int opponent);
-	bool blocksOpponentFour(const GameState &state, const Move &move, int opponent);
-	bool blocksOpponentThree(const GameState &state, const Move &move, int opponent);
-
-	int countConsecutiveInDirection(const GameState &state, int x, int y,
-									int dx, int dy, int player, int maxCount = 5);
-
 public:
-	TranspositionSearch(size_t tableSizeMB = 64);
+	TranspositionSearch(size_t tableSizeMB = DEFAULT_TABLE_MB);
 	~TranspositionSearch() = default;
 
 	void clearCache();
+	// Reallocate the table (contents are lost); same rounding as the constructor
+	void resizeTable(size_t sizeInMB);
 	size_t getCacheSize() const { return transpositionTable.size(); }
 	CacheStats getCacheStats() const;
 	void printCacheStats() const;
 
 	SearchResult findBestMoveIterative(const GameState &state, int maxDepth);
+	// Wall-clock budget per search in ms (0 = depth limit only). Depth 1 always
+	// completes; a deeper iteration cut short is discarded
+	void setTimeLimit(int milliseconds) { timeLimitMs = milliseconds; }
+	int getTimeLimit() const { return timeLimitMs; }
+	const std::vector<SearchStats> &getLastSearchStats() const { return lastSearchStats; }
+	// PLAYER2's score (the search's and the evaluator's view) -> the player to move's
+	static int forPlayerToMove(const GameState &state, int score);
+	// Same for the score of the last findBestMoveIterative, whose
+	// immediate-win shortcut already scores for the player to move
+	int scoreForPlayerToMove(const GameState &state, int score) const;
+	void setStatsLogFile(const std::string &filename) { statsLogFile = filename; }
 	void orderMovesWithPreviousBest(std::vector<Move> &moves, const GameState &state);
 	std::vector<Move> generateOrderedMoves(const GameState &state);
 	int quickEvaluateMove(const GameState &state, const Move &move);
@@ -2,6 +2,7 @@
 #define TRANSPOSITION_TYPES_HPP
 
 #include "../core/game_types.hpp"
+#include <cstddef>
 #include <cstdint>
 
 /**
@@ -0,0 +1,148 @@
+#ifndef BOARD_HPP
+#define BOARD_HPP
+
+#include <cstdint>
+
+// Line geometry of the 19x19 board: every row, column, ↘ diagonal and ↗
+// diagonal, in Directions::MAIN order (19 + 19 + 37 + 37 lines). Bit i of
+// a line is its i-th cell walking along the line's MAIN direction.
+struct BoardLines {
+    static constexpr int SIZE = 19;
+    static constexpr int DIAGONALS = 2 * SIZE - 1;
+    static constexpr int COUNT = 2 * SIZE + 2 * DIAGONALS;
+
+    // A cell's line in one MAIN direction and its bit in that line
+    struct Point {
+        uint8_t line = 0;
+        uint8_t bit = 0;
+    };
+
+    Point points[SIZE][SIZE][4];
+    uint32_t cells[COUNT] = {};      // Bit mask of the cells the line has
+    uint8_t direction[COUNT] = {};   // Directions::MAIN index
+    int8_t origin[COUNT][2] = {};    // Cell of bit 0
+
+    constexpr BoardLines() : points() {
+        for (int x = 0; x < SIZE; x++) {
+            for (int y = 0; y < SIZE; y++) {
+                int down = x - y;  // ↘: x - y constant, x increasing
+                int up = x + y;    // ↗: x + y constant, x increasing
+                int lines[4] = {x, SIZE + y, 2 * SIZE + down + (SIZE - 1), 2 * SIZE + DIAGONALS + up};
+                int bits[4] = {y, x, x < y ? x : y, up > SIZE - 1 ? x - (up - (SIZE - 1)) : x};
+                for (int d = 0; d < 4; d++) {
+                    points[x][y][d].line = (uint8_t)lines[d];
+                    points[x][y][d].bit = (uint8_t)bits[d];
+                    cells[lines[d]] |= 1u << bits[d];
+                    direction[lines[d]] = (uint8_t)d;
+                    if (bits[d] == 0) {
+                        origin[lines[d]][0] = (int8_t)x;
+                        origin[lines[d]][1] = (int8_t)y;
+                    }
+                }
+            }
+        }
+    }
+};
+
+inline constexpr BoardLines BOARD_LINES{};
+
+/**
+ * Board cells plus line-major views of them (GameState::board)
+ *
+ * Next to the 19x19 cells, each of the BoardLines keeps one bitset per
+ * player. Every write, board[x][y] = piece included, updates the four
+ * lines through the cell, so a directional scan reads one word per
+ * player instead of walking cells (RuleEngine win, capture and free-three
+ * checks, Evaluator::analyzeLine).
+ *
+ * Reads are plain ints; writes go through a small proxy:
+ *   int piece = board[x][y];   board[x][y] = GameState::PLAYER1;
+ */
+class Board {
+public:
+    static constexpr int SIZE = BoardLines::SIZE;
+
+    class Cell {
+    public:
+        Cell(Board& board, int x, int y) : board(board), x(x), y(y) {}
+        operator int() const { return board.cells[x][y]; }
+        Cell& operator=(int piece) { board.set(x, y, piece); return *this; }
+        Cell& operator=(const Cell& other) { return *this = (int)other; }
+    private:
+        Board& board;
+        int x, y;
+    };
+
+    class Row {
+    public:
+        Row(Board& board, int x) : board(board), x(x) {}
+        Cell operator[](int y) const { return Cell(board, x, y); }
+    private:
+        Board& board;
+        int x;
+    };
+
+    Board() : cells(), lines(), writes(0) {}
+
+    Row operator[](int x) { return Row(*this, x); }
+    const int* operator[](int x) const { return cells[x]; }
+
+    void set(int x, int y, int piece) {
+        int old = cells[x][y];
+        if (old == piece)
+            return;
+        cells[x][y] = piece;
+        writes++;
+        const BoardLines::Point* points = BOARD_LINES.points[x][y];
+        for (int d = 0; d < 4; d++) {
+            uint32_t bit = 1u << points[d].bit;
+            if (old == 1 || old == 2)
+                lines[points[d].line][old - 1] &= ~bit;
+            if (piece == 1 || piece == 2)
+                lines[points[d].line][piece - 1] |= bit;
+        }
+    }
+
+    void clear() { *this = Board(); }
+
+    // Number of cell changes so far: caches derived from the board (the
+    // threat map) record it to notice writes they were not told about
+    uint32_t revision() const { return writes; }
+
+    // Line through (x, y) along Directions::MAIN[direction]
+    static const BoardLines::Point& point(int x, int y, int direction) {
+        return BOARD_LINES.points[x][y][direction];
+    }
+
+    // MAIN index of (dx, dy) or of its reverse, -1 for neither
+    static int mainDirection(int dx, int dy) {
+        if (dx < 0 || (dx == 0 && dy < 0)) {
+            dx = -dx;
+            dy = -dy;
+        }
+        if (dx == 0 && dy == 1) return 0;
+        if (dx == 1 && dy == 0) return 1;
+        if (dx == 1 && dy == 1) return 2;
+        if (dx == 1 && dy == -1) return 3;
+        return -1;
+    }
+
+    // Stones of `player` (1 or 2) on a line, and its empty cells
+    uint32_t stones(int line, int player) const { return lines[line][player - 1]; }
+    uint32_t empty(int line) const { return ~(lines[line][0] | lines[line][1]) & BOARD_LINES.cells[line]; }
+
+    // Cell at `bit` of a line
+    static void cellAt(int line, int bit, int& x, int& y) {
+        static constexpr int STEP[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+        int d = BOARD_LINES.direction[line];
+        x = BOARD_LINES.origin[line][0] + bit * STEP[d][0];
+        y = BOARD_LINES.origin[line][1] + bit * STEP[d][1];
+    }
+
+private:
+    int cells[SIZE][SIZE];
+    uint32_t lines[BoardLines::COUNT][2];  // PLAYER1, PLAYER2
+    uint32_t writes;
+};
+
+#endif
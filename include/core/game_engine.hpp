@@ -4,7 +4,9 @@
 #include "game_types.hpp"
 #include "../rules/rule_engine.hpp"
 #include "../ai/ai.hpp"
+#include "../utils/game_record.hpp"
 #include <cstddef>
+#include <random>
 
 enum class GameMode {
     VS_AI,
@@ -23,6 +25,12 @@ public:
     void newGame();
     
     bool makeHumanMove(const Move& move);
+
+    // Random opening moves are drawn from the square of this radius around the centre
+    static constexpr int OPENING_RADIUS = 3;
+    // Plays `plies` random legal moves near the centre (selfplay, datagen);
+    // false if one could not be placed or the game ended
+    bool playRandomOpening(int plies, std::mt19937_64& random);
     
     Move makeAIMove();
     
@@ -39,8 +47,17 @@ public:
     int getLastCacheHits() const { return ai.getLastCacheHits(); }
     float getLastCacheHitRate() const { return ai.getLastCacheHitRate(); }
     size_t getCacheSize() const { return ai.getCacheSize(); }
+    const std::vector<SearchStats>& getLastSearchStats() const { return ai.getLastSearchStats(); }
+    void setStatsLogFile(const std::string& filename) { ai.setStatsLogFile(filename); }
     
     void clearAICache() { ai.clearCache(); }
+    // Appends every game from now on to a binary record file (see game_record.hpp)
+    bool setGameRecordFile(const std::string& filename) { return recordWriter.open(filename); }
+    // Moves of the current game so far, with its result once it is over
+    const GameRecord& getGameRecord() const { return gameRecord; }
+
+    // Shrinks the built-in AI's tables when moves come from elsewhere (referee use)
+    void setAITableSize(size_t megabytes) { ai.setTableSize(megabytes); }
 	void setGameMode(GameMode mode) { currentMode = mode; }
     GameMode getGameMode() const { return currentMode; }
 	std::vector<Move> findWinningLine() const;
@@ -56,6 +73,11 @@ private:
     
     Move lastHumanMove;
 	GameMode currentMode;
+
+    GameRecord gameRecord;
+    GameRecordWriter recordWriter;
+
+    void recordMove(const Move& move, const RuleEngine::MoveResult& result, bool hadCaptureOpportunity);
 };
 
 #endif
\ No newline at end of file
@@ -4,9 +4,11 @@
 #include <utility>
 #include <vector>
 #include <cstdint>
+#include "board.hpp"
 
 // Forward declaration to avoid circular dependencies
 class ZobristHasher;
+class NnueNetwork;
 
 struct Move {
     int x, y;
@@ -17,6 +19,42 @@ struct Move {
     bool operator==(const Move& other) const { return x == other.x && y == other.y; }
 };
 
+// First-layer sums of the NNUE evaluator (include/ai/nnue.hpp), one row per
+// perspective (PLAYER1, PLAYER2); only meaningful while key == zobristHash
+struct NnueAccumulator {
+    static constexpr int SIZE = 64;
+    
+    alignas(32) int16_t values[2][SIZE];
+    uint64_t key = 0;
+    uint32_t weightsId = 0;  // NnueNetwork::getWeightsId() of the values, 0 = none
+};
+
+// What a stone on each empty cell would make, per player
+// (include/ai/threat_scanner.hpp); only meaningful while valid and
+// revision == board.revision(), once the pending cells are applied
+struct ThreatMap {
+    // Best shape a stone on the cell makes over the four directions. A four
+    // has one cell left to make five, an open four two; an open three is
+    // one stone from an open four
+    enum Shape { NONE, TWO, THREE, OPEN_THREE, FOUR, OPEN_FOUR, FIVE };
+    
+    // Entry bits: 0-2 Shape, 7 the stone captures a pair
+    static constexpr uint8_t SHAPE_MASK = 0x07;
+    static constexpr uint8_t CAPTURE = 0x80;
+    
+    // Changed cells (x * BOARD_SIZE + y) whose lines are not updated yet
+    static constexpr int MAX_PENDING = 12;
+    
+    static Shape shape(uint8_t entry) { return (Shape)(entry & SHAPE_MASK); }
+    static bool captures(uint8_t entry) { return (entry & CAPTURE) != 0; }
+    
+    uint8_t cells[2][Board::SIZE][Board::SIZE];  // PLAYER1, PLAYER2
+    uint16_t pending[MAX_PENDING];
+    int pendingCount = 0;
+    uint32_t revision = 0;
+    bool valid = false;
+};
+
 struct GameState {
     static constexpr int BOARD_SIZE = 19;
     static constexpr int BOARD_CENTER = 9;  // Center of 19x19 board
@@ -29,7 +67,8 @@ struct GameState {
     static constexpr int WARNING_CAPTURES = 8;       // Warning threshold for near-win
     static constexpr int CRITICAL_CAPTURES = 9;      // Critical threshold (1 away from win)
     
-    int board[BOARD_SIZE][BOARD_SIZE];
+    // Cells plus per-line bitsets, kept in step by every write (core/board.hpp)
+    Board board;
     int captures[2] = {0, 0};
     int currentPlayer = PLAYER1;
     int turnCount = 0;
@@ -48,9 +87,23 @@ struct GameState {
     int forcedCapturePlayer = 0;  // Which player must make the forced capture (0 = none)
     int pendingWinPlayer = 0;     // Which player has the pending 5-in-a-row
     
+    // NNUE accumulator, kept in step by RuleEngine::applyMove while a
+    // network is loaded; like zobristHash, direct board writes leave it
+    // stale until recalculateHash (then it is rebuilt on first use)
+    mutable NnueAccumulator nnue;
+    
+    // Threat map for move ordering, kept in step by RuleEngine::applyMove
+    // once built (its cells are applied on the next read, so leaves never
+    // pay for them); rebuilt on first use after any other board write
+    mutable ThreatMap threats;
+    
     // Reference to hasher (shared between all states)
     static const ZobristHasher* hasher;
     
+    // Network used by Evaluator::evaluate, nullptr for the handcrafted
+    // evaluation (set by Evaluator::loadNetwork)
+    static const NnueNetwork* network;
+    
     GameState();
     GameState(const GameState& other);
     GameState& operator=(const GameState& other);
@@ -68,6 +121,12 @@ struct GameState {
      */
     static void initializeHasher();
     
+    /**
+     * Initializes the static hasher with a fixed seed (reproducible hashes)
+     * Replaces any hasher created earlier
+     */
+    static void initializeHasher(uint64_t seed);
+    
     /**
      * Cleans up the static hasher (call once at program end)
      */
@@ -81,6 +140,22 @@ struct GameState {
                            const std::vector<Move>& capturedPieces,
                            int oldCaptures);
     
+    /**
+     * Updates the NNUE accumulator after applying a move (network loaded);
+     * rebuilds it if it did not match oldHash, the hash before the move
+     */
+    void updateNnueAfterMove(const Move& move, int player,
+                             const std::vector<Move>& capturedPieces,
+                             int oldCaptures, uint64_t oldHash);
+    
+    /**
+     * Queues the cells a move changed for the threat map, if it matched
+     * the board before it (oldRevision); otherwise it is left to be rebuilt
+     */
+    void updateThreatsAfterMove(const Move& move,
+                                const std::vector<Move>& capturedPieces,
+                                uint32_t oldRevision);
+    
     /**
      * Recalculates the complete hash from scratch (only for verification/debug)
      */
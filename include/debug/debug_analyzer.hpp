@@ -3,9 +3,10 @@
 
 #include "../core/game_types.hpp"
 #include "debug_types.hpp"
+#include "debug_log_writer.hpp"
 #include <vector>
 #include <string>
-#include <fstream>
+#include <memory>
 #include <chrono>
 
 /**
@@ -28,7 +29,7 @@ private:
     DebugLevel currentLevel;
     std::vector<MoveAnalysis> rootMoveAnalyses;
     GameSnapshot lastSnapshot;
-    std::ofstream debugFile;
+    std::unique_ptr<DebugLogWriter> logWriter;  // Async, never blocks the caller on disk I/O
     bool fileLoggingEnabled;
     
 public:
@@ -41,6 +42,8 @@ public:
     bool isEnabled() const { return currentLevel != DEBUG_OFF; }
     void enableFileLogging(const std::string& filename = "gomoku_debug.log");
     void disableFileLogging();
+    void flushLog();    // Blocks until queued log records are on disk (game over, shutdown)
+    uint64_t getDroppedLogRecords() const;
     
     // Core analysis functions
     void analyzeRootMove(const Move& move, int score, const EvaluationBreakdown& breakdown);
@@ -71,8 +74,6 @@ public:
     void logStats(const std::string& message) const;
     void logInit(const std::string& message) const;
     void logAI(const std::string& message) const;
-
-    std::ofstream& getDebugFile() { return debugFile; }
     
 private:
     std::string formatScore(int score) const;
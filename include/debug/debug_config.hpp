@@ -0,0 +1,21 @@
+#ifndef DEBUG_CONFIG_HPP
+#define DEBUG_CONFIG_HPP
+
+/**
+ * Compile-time switch for search instrumentation
+ * - Release builds (make) leave GOMOKU_DEBUG undefined: the per-node
+ *   statistics, evaluator pattern capture and root board dumps are
+ *   removed from minimax entirely
+ * - Debug builds (make debug, binary Gomoku-debug) pass -DGOMOKU_DEBUG=1
+ *   and keep the full DebugAnalyzer output
+ * Per-move logging (chosen move, snapshots, game stats) is unaffected.
+ */
+#ifndef GOMOKU_DEBUG
+#define GOMOKU_DEBUG 0
+#endif
+
+namespace DebugConfig {
+	constexpr bool SEARCH_INSTRUMENTATION = (GOMOKU_DEBUG != 0);
+}
+
+#endif
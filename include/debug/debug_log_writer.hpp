@@ -0,0 +1,82 @@
+#ifndef DEBUG_LOG_WRITER_HPP
+#define DEBUG_LOG_WRITER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * Asynchronous writer behind DebugAnalyzer::logToFile
+ * - Producers (search, GUI thread) copy preformatted records into a
+ *   bounded lock-free ring buffer and return immediately
+ * - A background thread drains the ring in batches and writes them to disk
+ * - When the ring is full the record is dropped and counted; the writer
+ *   reports the drop count in the log itself
+ * Memory use is fixed: capacity * RECORD_SIZE bytes.
+ */
+class DebugLogWriter {
+public:
+	static constexpr size_t DEFAULT_CAPACITY = 1024;	// Records (rounded up to power of 2)
+	static constexpr size_t RECORD_SIZE = 2048;			// Bytes per record, including header
+	static constexpr int IDLE_WAIT_MS = 5;				// Writer poll interval when idle
+
+	explicit DebugLogWriter(size_t capacity = DEFAULT_CAPACITY);
+	~DebugLogWriter();
+
+	DebugLogWriter(const DebugLogWriter &) = delete;
+	DebugLogWriter &operator=(const DebugLogWriter &) = delete;
+
+	// Opens the file in append mode and starts the writer thread
+	bool open(const std::string &filename);
+	// Drains pending records, stops the writer thread and closes the file
+	void close();
+	bool isOpen() const { return running.load(std::memory_order_acquire); }
+
+	// Lock-free enqueue; returns false if the record was dropped
+	bool push(const std::string &message);
+	// Blocks until every record pushed before the call is on disk
+	void flush();
+
+	uint64_t getDroppedCount() const { return droppedRecords.load(std::memory_order_relaxed); }
+	uint64_t getTruncatedCount() const { return truncatedRecords.load(std::memory_order_relaxed); }
+	size_t getCapacity() const { return capacity; }
+
+private:
+	struct Slot {
+		std::atomic<size_t> sequence;
+		uint32_t length;
+		char text[RECORD_SIZE - sizeof(std::atomic<size_t>) - sizeof(uint32_t)];
+	};
+	static constexpr size_t MAX_MESSAGE = sizeof(Slot::text);
+
+	size_t capacity;
+	size_t mask;
+	std::unique_ptr<Slot[]> slots;
+
+	alignas(64) std::atomic<size_t> enqueuePos;
+	alignas(64) size_t dequeuePos;			// Writer thread only
+	std::atomic<size_t> writtenPos;			// Records durably written
+
+	std::atomic<uint64_t> droppedRecords;
+	std::atomic<uint64_t> truncatedRecords;
+	uint64_t reportedDrops;					// Writer thread only
+
+	std::atomic<bool> running;
+	std::atomic<bool> stopRequested;
+	std::mutex wakeMutex;
+	std::condition_variable wakeCondition;
+	std::thread writerThread;
+	std::ofstream file;
+
+	void resetSlots();
+	void writerLoop();
+	size_t drainBatch(std::string &batch);
+};
+
+#endif
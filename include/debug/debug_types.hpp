@@ -2,6 +2,7 @@
 #define DEBUG_TYPES_HPP
 
 #include "../core/game_types.hpp"
+#include "debug_config.hpp"
 #include <vector>
 #include <string>
 
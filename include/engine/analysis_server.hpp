@@ -0,0 +1,126 @@
+#ifndef ANALYSIS_SERVER_HPP
+#define ANALYSIS_SERVER_HPP
+
+#include "../ai/ai.hpp"
+#include "../core/game_types.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * AnalysisServer: many games in one process on a fixed pool of engines
+ *
+ * - Sessions (one GameState each) are cheap; engines are not. Each of the
+ *   `workers` threads owns one AI, reused for every session, and the
+ *   transposition tables share one global budget (tableMB / workers each)
+ * - "think" requests go through a bounded queue; when it is full, or the
+ *   session already has a search pending, the request is rejected at once
+ *   instead of waiting (admission control)
+ * - Every other request is answered inline by the caller's thread
+ *
+ * One JSON object per line in each direction; replies echo "id" (a
+ * string or a number; anything else is rejected):
+ *   {"cmd":"new"[,"position":"<PositionIO>"]}  -> {"ok":true,"session":N}
+ *   {"cmd":"move","session":N,"x":9,"y":9}     -> {"ok":true,"captures":[a,b],"win":false,"turn":T}
+ *   {"cmd":"think","session":N[,"budget_ms":B][,"depth":D][,"play":true]}
+ *                                              -> {"ok":true,"x":..,"y":..,"score":..,"depth":..,"nodes":..,"ms":..}
+ *   {"cmd":"close","session":N}                -> {"ok":true}
+ *   {"cmd":"stats"}                            -> counters of the whole server
+ * x, y are Move coordinates (x = row). Errors: {"ok":false,"error":"..."}.
+ */
+class AnalysisServer
+{
+public:
+	struct Config
+	{
+		int workers = 2;
+		size_t tableMB = 256; // Global transposition table budget
+		size_t queueLimit = 64;
+		size_t maxSessions = 1024;
+		AIImplementation implementation = CPP_IMPLEMENTATION;
+		int defaultBudgetMs = 1000;
+		int defaultDepth = 10;
+	};
+
+	// Receives each reply line (without the newline); may be called from a worker
+	using ReplySink = std::function<void(const std::string &)>;
+
+	explicit AnalysisServer(const Config &config);
+	~AnalysisServer();
+
+	AnalysisServer(const AnalysisServer &) = delete;
+	AnalysisServer &operator=(const AnalysisServer &) = delete;
+
+	// Handles one request line; think replies arrive later through sink
+	void handleRequest(const std::string &line, const ReplySink &sink);
+
+	// Listens on a Unix domain socket, one reader thread per connection,
+	// until stop() (or a failure to bind: returns false)
+	bool serve(const std::string &socketPath);
+	void stop() { stopRequested.store(true); }
+
+	size_t getTableMBPerWorker() const { return tableMBPerWorker; }
+	std::string statsJson() const;
+
+private:
+	struct Session
+	{
+		GameState state;
+		bool thinking = false;
+	};
+
+	struct ThinkJob
+	{
+		std::shared_ptr<Session> session;
+		std::string requestId;
+		int budgetMs;
+		int depth;
+		bool play;
+		ReplySink sink;
+	};
+
+	Config config;
+	size_t tableMBPerWorker;
+
+	mutable std::mutex sessionMutex;
+	std::map<int, std::shared_ptr<Session>> sessions;
+	int nextSessionId;
+
+	mutable std::mutex queueMutex;
+	std::condition_variable queueReady;
+	std::deque<ThinkJob> queue;
+	bool shuttingDown;
+	std::vector<std::thread> workers;
+
+	std::atomic<bool> stopRequested;
+
+	// Counters for "stats"
+	std::atomic<int> activeSearches;
+	std::atomic<uint64_t> thinksCompleted;
+	std::atomic<uint64_t> thinksRejected;
+	std::atomic<uint64_t> nodesSearched;
+	std::atomic<uint64_t> thinkMicroseconds;
+
+	void workerLoop();
+	std::string runThink(AI &ai, const ThinkJob &job);
+
+	std::string newSession(const std::map<std::string, std::string> &request, const std::string &id);
+	std::string playMove(const std::map<std::string, std::string> &request, const std::string &id);
+	std::string queueThink(const std::map<std::string, std::string> &request, const std::string &id,
+						   const ReplySink &sink);
+	std::string closeSession(const std::map<std::string, std::string> &request, const std::string &id);
+	std::shared_ptr<Session> findSession(const std::map<std::string, std::string> &request);
+
+	void serveConnection(int fd);
+};
+
+#endif // ANALYSIS_SERVER_HPP
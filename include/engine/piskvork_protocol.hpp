@@ -0,0 +1,94 @@
+#ifndef PISKVORK_PROTOCOL_HPP
+#define PISKVORK_PROTOCOL_HPP
+
+#include "../ai/ai.hpp"
+#include "../core/game_types.hpp"
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * PiskvorkProtocol: Gomocup / Piskvork brain protocol over text streams
+ *
+ * One command per line (case-insensitive); coordinates are "x,y" with
+ * x = column and y = row, 0-based, i.e. Move(y, x).
+ *
+ *   START 19 / RECTSTART 19,19  -> OK (other sizes: ERROR)
+ *   RESTART                     -> OK, new game with cleared tables
+ *   BEGIN                       -> engine plays the first stone
+ *   TURN x,y                    -> opponent stone; engine replies with its move
+ *   BOARD / x,y,who ... / DONE  -> whole position (who 1 = engine, 2 = opponent,
+ *                                  any order; the stone counts tell who began);
+ *                                  engine replies with its move
+ *   TAKEBACK x,y                -> OK, undoes the last stone if it is at x,y
+ *   INFO key value              -> timeout_turn, timeout_match, time_left (ms),
+ *                                  max_memory (bytes); other keys are ignored
+ *   ABOUT                       -> name="...", version="..."
+ *   END                         -> stop reading
+ *
+ * Capture rules: stones are played through RuleEngine (pair captures,
+ * double free-three ban), so a move that is occupied or banned gets an
+ * ERROR. A reply that captured is preceded by "MESSAGE CAPTURED x,y ...",
+ * and a "CAPTURES own,opponent" line inside a BOARD block sets the pairs
+ * each side has captured so far.
+ */
+class PiskvorkProtocol
+{
+public:
+	static constexpr int DEFAULT_TURN_MS = 30000;
+	static constexpr int DEFAULT_MAX_DEPTH = 10;
+
+	PiskvorkProtocol(std::ostream &out, AIImplementation impl = CPP_IMPLEMENTATION,
+					 int maxDepth = DEFAULT_MAX_DEPTH);
+
+	// Processes one command line; returns false after END
+	bool handleLine(const std::string &line);
+	// Reads commands until END or end of input
+	void run(std::istream &in);
+
+	const GameState &getState() const { return state; }
+	int getOwnPlayer() const { return ownPlayer; }
+	// Time budget for the next move (ms) and table size from the INFO limits
+	int getMoveTimeLimit() const;
+	size_t getTableSizeMB() const;
+	void setRustThreads(int threads) { rustThreads = threads; }
+
+private:
+	std::ostream &out;
+	AIImplementation implementation;
+	int maxDepth;
+	int rustThreads;
+	std::unique_ptr<AI> ai; // Created on the first search, sized by max_memory
+	size_t aiTableMB;
+
+	GameState state;
+	std::vector<GameState> history; // State before each stone, for TAKEBACK
+	int ownPlayer;
+
+	bool readingBoard;
+	std::vector<std::string> boardLines;
+
+	// INFO limits; 0 = none (timeout_turn 0 = play as fast as possible)
+	int turnTimeoutMs;
+	int matchTimeoutMs;
+	int timeLeftMs;
+	long long maxMemoryBytes;
+
+	void newGame();
+	void handleCommand(const std::string &command, const std::string &args);
+	void handleInfo(const std::string &args);
+	bool setUpBoard();
+
+	bool playMove(const Move &move, std::vector<Move> *captured = nullptr);
+	void replyWithMove();
+	Move chooseMove();
+	AI &getAI();
+
+	void reply(const std::string &line);
+	static bool parseCoordinates(const std::string &text, std::vector<int> &values);
+	static std::string formatMove(const Move &move);
+};
+
+#endif // PISKVORK_PROTOCOL_HPP
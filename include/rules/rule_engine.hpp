@@ -30,6 +30,10 @@ public:
 
 	static bool isLegalMove(const GameState &state, const Move &move);
 
+	// Legal cell closest to the centre (invalid Move if none): the fallback
+	// for callers that got no move from the search (empty board, no candidates)
+	static Move findCentralLegalMove(const GameState &state);
+
 	static bool checkWin(const GameState &state, int player);
 
 	// Fast check: does the player have 5+ in a row on the board?
@@ -0,0 +1,130 @@
+#ifndef GAME_RECORD_HPP
+#define GAME_RECORD_HPP
+
+#include "../core/game_types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <string>
+#include <vector>
+
+/**
+ * Binary game records: a file header, then games as 16-bit little-endian words
+ *
+ *   header: "GMKR", version (1 byte), board size (1 byte), 2 reserved bytes
+ *   game:   GAME_START, one word per move, GAME_END | result
+ *   move:   bits 0-8 cell (x * 19 + y), bit 9 CAPTURED (the move took at
+ *           least one pair), bit 10 FORCED_CAPTURE (the mover could break a
+ *           pending five by capturing)
+ *
+ * Every game starts from the empty board, so a record is replayed with
+ * RuleEngine::applyMove alone; the CAPTURED flag is checked on the way.
+ * A move takes 2 bytes (361 cells need 9 bits), a game 4 more.
+ */
+struct RecordedMove
+{
+	static constexpr uint16_t CAPTURED = 1 << 9;
+	static constexpr uint16_t FORCED_CAPTURE = 1 << 10;
+
+	Move move;
+	uint16_t flags;
+
+	RecordedMove(const Move &m = Move(), uint16_t f = 0) : move(m), flags(f) {}
+};
+
+struct GameRecord
+{
+	enum Result
+	{
+		UNFINISHED = 0, // Abandoned or still being played
+		PLAYER1_WINS = 1,
+		PLAYER2_WINS = 2,
+		DRAW = 3
+	};
+
+	std::vector<RecordedMove> moves;
+	int result = UNFINISHED;
+
+	void clear()
+	{
+		moves.clear();
+		result = UNFINISHED;
+	}
+};
+
+// Appends games to a record file through a write buffer
+class GameRecordWriter
+{
+public:
+	static constexpr size_t BUFFER_BYTES = 64 * 1024;
+
+	GameRecordWriter() : gameOpen(false) {}
+	~GameRecordWriter() { close(); }
+
+	GameRecordWriter(const GameRecordWriter &) = delete;
+	GameRecordWriter &operator=(const GameRecordWriter &) = delete;
+
+	// Appends to filename (writing the header if the file is new or empty);
+	// refuses files that are not game records
+	bool open(const std::string &filename);
+	// Ends an open game as UNFINISHED, flushes and closes
+	void close();
+	bool isOpen() const { return file.is_open(); }
+
+	// Streaming: one game at a time, moves as they are played
+	void beginGame();
+	void recordMove(const RecordedMove &move);
+	void endGame(int result);
+
+	// A whole game at once
+	void writeGame(const GameRecord &game);
+
+	void flush();
+
+private:
+	std::ofstream file;
+	std::vector<uint8_t> buffer;
+	bool gameOpen;
+
+	void writeWord(uint16_t word);
+};
+
+// Reads a record file game by game, BUFFER_BYTES at a time
+class GameRecordReader
+{
+public:
+	static constexpr size_t BUFFER_BYTES = 64 * 1024;
+
+	GameRecordReader() : position(0), failed(false) {}
+
+	// Checks the file header
+	bool open(const std::string &filename);
+
+	// Next game; false at the end of the file or on a malformed record
+	// (hasError() tells which). A game cut off by the end of the file is
+	// returned as UNFINISHED.
+	bool next(GameRecord &game);
+	bool hasError() const { return failed; }
+
+	// Applies one recorded move; false if it is illegal or its CAPTURED
+	// flag does not match what the rules did
+	static bool applyMove(GameState &state, const RecordedMove &move);
+	// Plays the first `plies` moves of the game from the empty board
+	static bool replay(const GameRecord &game, GameState &state, size_t plies = SIZE_MAX);
+
+	// Piskvork .psq game: "Piskvorky 19x19, ..." then 1-based "x,y[,ms]"
+	// lines (x = column) up to the first other line. Moves are played
+	// through the rules to fill in the flags and the result.
+	static bool readPsq(std::istream &in, GameRecord &game);
+
+private:
+	std::ifstream file;
+	std::vector<uint8_t> buffer;
+	size_t position;
+	bool failed;
+
+	bool readWord(uint16_t &word);
+};
+
+#endif // GAME_RECORD_HPP
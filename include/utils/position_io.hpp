@@ -0,0 +1,34 @@
+#ifndef POSITION_IO_HPP
+#define POSITION_IO_HPP
+
+#include "../core/game_types.hpp"
+#include <istream>
+#include <string>
+
+/**
+ * PositionIO: compact text form of a GameState
+ *
+ *   <side to move> <captures X> <captures O> <board>
+ *
+ * - side to move: X (PLAYER1) or O (PLAYER2)
+ * - captures: captured pairs per player (0-10)
+ * - board: 19 rows (x = 0..18) separated by '/', columns y = 0..18;
+ *   X / O are stones, digits are runs of empty cells
+ *
+ * Used by the bench/perft suites under tests/data/.
+ * turnCount is derived (stones on board + 2 per captured pair) and the
+ * Zobrist hash is recalculated after parsing.
+ */
+class PositionIO
+{
+public:
+	// Board field only; state.board is overwritten
+	static bool parseBoard(const std::string &text, GameState &state);
+	static std::string formatBoard(const GameState &state);
+
+	// Reads the four position fields from the stream into a fresh state
+	static bool read(std::istream &in, GameState &state);
+	static std::string format(const GameState &state);
+};
+
+#endif // POSITION_IO_HPP
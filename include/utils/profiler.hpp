@@ -0,0 +1,105 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <cstdint>
+#include <ostream>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+/**
+ * Profiler: scoped cycle counters for the search hot path
+ *
+ * Compiled in only when GOMOKU_PROFILE=1 (make profile). Otherwise
+ * PROFILE_SCOPE expands to nothing and the accumulators are never touched.
+ * - RDTSC on x86 (steady_clock nanoseconds elsewhere)
+ * - Accumulators are thread_local: each search thread profiles itself
+ * - Timings are inclusive (applyMove includes createsDoubleFreeThree,
+ *   candidate generation includes move ordering)
+ */
+#ifndef GOMOKU_PROFILE
+#define GOMOKU_PROFILE 0
+#endif
+
+class Profiler
+{
+public:
+	static constexpr bool ENABLED = (GOMOKU_PROFILE != 0);
+
+	enum Section
+	{
+		SEARCH,				 // Whole findBestMoveIterative call (reference for %)
+		EVALUATE,			 // Evaluator::evaluate
+		APPLY_MOVE,			 // RuleEngine::applyMove
+		DOUBLE_FREE_THREE,	 // RuleEngine::createsDoubleFreeThree
+		GENERATE_CANDIDATES, // TranspositionSearch::generateCandidatesAdaptiveRadius
+		ORDER_MOVES,		 // TranspositionSearch::orderMovesWithPreviousBest
+		SECTION_COUNT
+	};
+
+	struct Counter
+	{
+		uint64_t calls;
+		uint64_t cycles;
+	};
+
+	static inline uint64_t readCycles()
+	{
+#if defined(__x86_64__) || defined(__i386__)
+		return __rdtsc();
+#else
+		return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+				   std::chrono::steady_clock::now().time_since_epoch())
+			.count();
+#endif
+	}
+
+	static inline void record(Section section, uint64_t cycles)
+	{
+		Counter &counter = counters[section];
+		counter.calls++;
+		counter.cycles += cycles;
+	}
+
+	static const Counter &get(Section section) { return counters[section]; }
+	static const char *getSectionName(Section section);
+
+	// Flat profile of the calling thread: calls, total cycles, cycles/call, % of SEARCH
+	static void report(std::ostream &out);
+	static void reset();
+
+private:
+	static thread_local Counter counters[SECTION_COUNT];
+};
+
+/**
+ * RAII timer: charges the enclosing scope to a Profiler section
+ */
+class ScopedTimer
+{
+public:
+	explicit ScopedTimer(Profiler::Section s) : section(s), start(Profiler::readCycles()) {}
+	~ScopedTimer() { Profiler::record(section, Profiler::readCycles() - start); }
+
+	ScopedTimer(const ScopedTimer &) = delete;
+	ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+private:
+	Profiler::Section section;
+	uint64_t start;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if GOMOKU_PROFILE
+#define PROFILE_SCOPE(section) \
+	ScopedTimer PROFILE_CONCAT(profileScope_, __LINE__)(Profiler::section)
+#else
+#define PROFILE_SCOPE(section) ((void)0)
+#endif
+
+#endif // PROFILER_HPP
@@ -0,0 +1,102 @@
+#ifndef TRACE_RECORDER_HPP
+#define TRACE_RECORDER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * TraceRecorder: Chrome trace_event export (viewable in Perfetto / chrome://tracing)
+ *
+ * - Disabled by default; a disabled TraceScope costs one relaxed atomic load
+ * - Enabled with GOMOKU_TRACE=<file> or the --trace <file> command line flag
+ * - Each thread appends complete ("X") events to its own buffer; buffers are
+ *   only merged and serialized once, by writeAndStop() at shutdown
+ */
+class TraceRecorder
+{
+public:
+	// Starts recording; events are written to filename by writeAndStop()
+	static void start(const std::string &filename);
+	// Reads GOMOKU_TRACE; returns true if recording was started
+	static bool startFromEnvironment();
+	// Serializes every thread buffer to the trace file and stops recording
+	static bool writeAndStop();
+
+	static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+	static uint64_t nowNanos();
+
+	// Names the calling thread in the trace viewer
+	static void setThreadName(const std::string &name);
+	// name and category must be string literals (stored by pointer)
+	static void recordComplete(const char *name, const char *category,
+							   uint64_t startNs, uint64_t endNs, std::string args);
+
+	static size_t getEventCount();
+
+private:
+	struct Event
+	{
+		const char *name;
+		const char *category;
+		uint64_t startNs;
+		uint64_t durationNs;
+		std::string args; // JSON object body, e.g. "\"depth\":5"
+	};
+
+	struct ThreadBuffer
+	{
+		int tid;
+		std::string threadName;
+		std::vector<Event> events;
+	};
+
+	static std::atomic<bool> enabled;
+	static std::mutex registryMutex;
+	static std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+	static std::string outputFile;
+	static uint64_t originNs;
+
+	static ThreadBuffer &localBuffer();
+};
+
+/**
+ * RAII span: records a complete event from construction to destruction
+ * A null name (or recording disabled at construction) makes it a no-op.
+ */
+class TraceScope
+{
+public:
+	TraceScope(const char *spanName, const char *spanCategory)
+		: name(TraceRecorder::isEnabled() ? spanName : nullptr), category(spanCategory),
+		  startNs(name ? TraceRecorder::nowNanos() : 0) {}
+
+	~TraceScope()
+	{
+		if (name)
+			TraceRecorder::recordComplete(name, category, startNs, TraceRecorder::nowNanos(), std::move(args));
+	}
+
+	TraceScope(const TraceScope &) = delete;
+	TraceScope &operator=(const TraceScope &) = delete;
+
+	// True if this span will be recorded (use to skip formatting args)
+	bool isActive() const { return name != nullptr; }
+	void setArgs(std::string jsonBody) { args = std::move(jsonBody); }
+
+private:
+	const char *name;
+	const char *category;
+	uint64_t startNs;
+	std::string args;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name, category) \
+	TraceScope TRACE_CONCAT(traceScope_, __LINE__)(name, category)
+
+#endif // TRACE_RECORDER_HPP
@@ -0,0 +1,99 @@
+#ifndef TRAINING_DATA_HPP
+#define TRAINING_DATA_HPP
+
+#include "../core/game_types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * Packed training positions: a file header, then fixed-size 98-byte records
+ *
+ *   header:  "GMKP", version (1 byte), board size (1 byte), 2 reserved bytes
+ *   record:  bytes 0-90   cells, 2 bits each (0 empty, 1 X, 2 O), cell
+ *                         x * 19 + y, four per byte from the low bits
+ *            bytes 91-92  captured pairs of X and O
+ *            byte  93     bit 0 side to move (0 X, 1 O), bits 1-2 game
+ *                         result (GameRecord::Result)
+ *            bytes 94-97  search score for the side to move, int32 LE
+ *
+ * Pending forced captures are not stored: datagen samples no position
+ * with a five on the board or a forced capture pending. As in
+ * PositionIO, turnCount is derived and the hash recalculated when a
+ * record is unpacked.
+ */
+struct PackedPosition
+{
+	static constexpr size_t PACKED_BYTES = 98;
+
+	uint8_t bytes[PACKED_BYTES];
+
+	static PackedPosition pack(const GameState &state, int score, int result);
+	// False if a cell code or capture count is out of range
+	bool unpack(GameState &state) const;
+
+	int sideToMove() const { return (bytes[93] & 1) ? GameState::PLAYER2 : GameState::PLAYER1; }
+	int result() const { return (bytes[93] >> 1) & 3; }
+	int score() const;
+};
+
+// Streams positions into numbered shard files <prefix>-0000.gpos, ...
+class TrainingDataWriter
+{
+public:
+	static constexpr size_t BUFFER_BYTES = 64 * 1024;
+
+	TrainingDataWriter() : positionsPerShard(0), shardPositions(0), shardIndex(0), totalPositions(0) {}
+	~TrainingDataWriter() { close(); }
+
+	TrainingDataWriter(const TrainingDataWriter &) = delete;
+	TrainingDataWriter &operator=(const TrainingDataWriter &) = delete;
+
+	// Numbering starts after the shards already on disk, so runs add up
+	bool open(const std::string &prefix, size_t positionsPerShard);
+	void close();
+	bool isOpen() const { return file.is_open(); }
+
+	bool write(const PackedPosition &position);
+
+	size_t positionsWritten() const { return totalPositions; }
+	const std::vector<std::string> &shardFiles() const { return shards; }
+
+private:
+	std::string prefix;
+	size_t positionsPerShard;
+	size_t shardPositions;
+	int shardIndex;
+	size_t totalPositions;
+	std::ofstream file;
+	std::vector<uint8_t> buffer;
+	std::vector<std::string> shards;
+
+	bool openNextShard();
+	void flush();
+};
+
+// Reads one shard file, BUFFER_BYTES at a time
+class TrainingDataReader
+{
+public:
+	static constexpr size_t BUFFER_BYTES = 64 * 1024;
+
+	TrainingDataReader() : position(0), failed(false) {}
+
+	bool open(const std::string &filename);
+
+	// False at the end of the file or on a truncated record (hasError())
+	bool next(PackedPosition &packed);
+	bool hasError() const { return failed; }
+
+private:
+	std::ifstream file;
+	std::vector<uint8_t> buffer;
+	size_t position;
+	bool failed;
+};
+
+#endif // TRAINING_DATA_HPP
@@ -24,6 +24,12 @@ public:
 	 * The table must remain consistent throughout execution
 	 */
 	ZobristHasher();
+
+	/**
+	 * Deterministic constructor: same seed => same keys on every run
+	 * Used by benchmarks so node counts are reproducible
+	 */
+	explicit ZobristHasher(uint64_t seed);
 	~ZobristHasher();
 
 	/**
@@ -98,10 +104,15 @@ private:
 	 */
 	void initializeZobristTable();
 
+	/**
+	 * Fill all tables from the given generator
+	 */
+	void fillTables(std::mt19937_64 &generator);
+
 	/**
 	 * Generate a 64-bit random number
 	 */
-	ZobristKey generateRandomKey();
+	static ZobristKey generateRandomKey(std::mt19937_64 &generator);
 
 	// Static random generator for initialization
 	static std::mt19937_64 rng;
@@ -6,7 +6,45 @@
 // ===============================================
 
 #include "../../include/ai/ai.hpp"
-#include "../../include/ai/rust_ai_wrapper.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// ===============================================
+// RUST TIME LIMIT
+// ===============================================
+
+// Raises the Rust stop flag once limitMs have passed, unless destroyed first
+class StopTimer {
+public:
+    StopTimer(int limitMs, std::atomic<int>& stopFlag) : finished(false) {
+        if (limitMs <= 0)
+            return;
+        worker = std::thread([this, limitMs, &stopFlag] {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (!wakeUp.wait_for(lock, std::chrono::milliseconds(limitMs), [this] { return finished; }))
+                stopFlag.store(1);
+        });
+    }
+
+    ~StopTimer() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            finished = true;
+        }
+        wakeUp.notify_one();
+        if (worker.joinable())
+            worker.join();
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    bool finished;
+    std::thread worker;
+};
 
 // ===============================================
 // MAIN AI INTERFACE
@@ -15,11 +53,12 @@
 Move AI::getBestMove(const GameState& state) {
     if (implementation == RUST_IMPLEMENTATION) {
         int maxDepth = getDepthForGamePhase(state);
-        return RustAIWrapper::getBestMove(state, maxDepth);
+        return findBestMoveIterative(state, maxDepth).bestMove;
     } else {
         // Original C++ implementation
         int depth = getDepthForGamePhase(state);
         lastResult = searchEngine.findBestMoveIterative(state, depth);
+        lastSearchStats = searchEngine.getLastSearchStats();
         return lastResult.bestMove;
     }
 }
@@ -43,18 +82,22 @@ int AI::getDepthForGamePhase(const GameState& state) {
 
 TranspositionSearch::SearchResult AI::findBestMoveIterative(const GameState& state, int maxDepth) {
     if (implementation == RUST_IMPLEMENTATION) {
-        // For Rust implementation, create a basic result since we don't have detailed stats yet
-        Move bestMove = RustAIWrapper::getBestMove(state, maxDepth);
-        TranspositionSearch::SearchResult result;
-        result.bestMove = bestMove;
-        result.score = 0; // TODO: Get score from Rust
-        result.nodesEvaluated = 0; // TODO: Get stats from Rust
-        result.cacheHits = 0;
-        result.cacheHitRate = 0.0f;
-        lastResult = result;
-        return result;
+        lastSearchStats.clear();
+        auto recordIteration = [this](const SearchStats& iteration) {
+            lastSearchStats.push_back(iteration);
+        };
+        std::atomic<int> stopFlag(0);
+        {
+            StopTimer timer(timeLimitMs, stopFlag);
+            lastResult = rustEngine.findBestMove(state, maxDepth, recordIteration, &stopFlag);
+        }
+        // Stopped before depth 1 completed: that depth is cheap, run it alone
+        if (!lastResult.bestMove.isValid() && stopFlag.load())
+            lastResult = rustEngine.findBestMove(state, 1, recordIteration);
+        return lastResult;
     } else {
         lastResult = searchEngine.findBestMoveIterative(state, maxDepth);
+        lastSearchStats = searchEngine.getLastSearchStats();
         return lastResult;
     }
 }
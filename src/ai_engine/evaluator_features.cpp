@@ -0,0 +1,92 @@
+// ===============================================
+// AI Engine - Evaluator Features Module
+// ===============================================
+// Handles: Feature counts behind evaluate(), runtime-weight evaluation
+// Dependencies: Evaluator (patterns, threats, position), RuleEngine
+// ===============================================
+
+#include "../../include/ai/evaluator.hpp"
+#include "../../include/rules/rule_engine.hpp"
+#include <algorithm>
+
+using namespace Directions;
+
+const char *const EvalFeatures::NAMES[TERM_COUNT] = {
+	"PATTERN_FIVE", "FOUR_OPEN", "FOUR_HALF", "THREE_OPEN", "THREE_HALF", "TWO_OPEN",
+	"THREAT_FOUR_OPEN", "THREAT_FOUR_HALF", "THREAT_DOUBLE_THREE",
+	"FORK_FOUR_THREE", "FORK_DOUBLE_FOUR", "FORK_CAPTURES_THREE",
+	"HELD_9", "HELD_8", "HELD_6", "HELD_4", "HELD_PAIR",
+	"LOST_9", "LOST_8", "LOST_6", "LOST_4", "LOST_PAIR",
+	"CAPTURE_WIN", "CAPTURE_TO_9", "CAPTURE_TO_8", "CAPTURE_TO_6", "CAPTURE_PAIRS",
+	"BREAKS_FOUR", "BREAKS_THREE", "BREAKS_TWO", "OPENS_LINE", "CAPTURE_UNDER_PRESSURE"};
+
+const int EvalFeatures::DEFAULT_WEIGHTS[TERM_COUNT] = {
+	Evaluator::WIN, EvalWeights::FOUR_OPEN, EvalWeights::FOUR_HALF, EvalWeights::THREE_OPEN,
+	EvalWeights::THREE_HALF, EvalWeights::TWO_OPEN,
+	EvalWeights::THREAT_FOUR_OPEN, EvalWeights::THREAT_FOUR_HALF, EvalWeights::THREAT_DOUBLE_THREE,
+	EvalWeights::FORK_FOUR_THREE, EvalWeights::FORK_DOUBLE_FOUR, EvalWeights::FORK_CAPTURES_THREE,
+	EvalWeights::HELD_9, EvalWeights::HELD_8, EvalWeights::HELD_6, EvalWeights::HELD_4, EvalWeights::HELD_PAIR,
+	EvalWeights::LOST_9, EvalWeights::LOST_8, EvalWeights::LOST_6, EvalWeights::LOST_4, EvalWeights::LOST_PAIR,
+	EvalWeights::CAPTURE_WIN, EvalWeights::CAPTURE_TO_9, EvalWeights::CAPTURE_TO_8, EvalWeights::CAPTURE_TO_6,
+	EvalWeights::CAPTURE_PAIRS, EvalWeights::BREAKS_FOUR, EvalWeights::BREAKS_THREE, EvalWeights::BREAKS_TWO,
+	EvalWeights::OPENS_LINE, EvalWeights::CAPTURE_UNDER_PRESSURE};
+
+int EvalFeatures::score(const int *weights) const
+{
+	int terms[TERM_COUNT];
+	for (int term = 0; term < TERM_COUNT; term++)
+		terms[term] = counts[term];
+	return score(terms, weights);
+}
+
+int EvalFeatures::score(const int *terms, const int *weights)
+{
+	long long total = 0;
+	for (int term = 0; term < TERM_COUNT; term++)
+		total += (long long)terms[term] * weights[term];
+	return (int)total;
+}
+
+// ===============================================
+// FEATURE EXTRACTION
+// ===============================================
+
+/**
+ * Terms of evaluateForPlayer: threats and forks, then line patterns,
+ * capture opportunities and threats, pairs held
+ */
+void Evaluator::addPlayerFeatures(const GameState &state, int player, const PatternCounts &counts,
+								  int sign, int *terms)
+{
+	addThreatFeatures(state, player, counts, sign, terms);
+	addPositionFeatures(state, player, sign, terms);
+}
+
+void Evaluator::extractFeatures(const GameState &state, EvalFeatures &features)
+{
+	PatternCounts patterns[2];
+	countAllPatterns(state, patterns[0], patterns[1]);
+
+	int terms[EvalFeatures::TERM_COUNT] = {0};
+	addPlayerFeatures(state, GameState::PLAYER2, patterns[1], 1, terms);
+	addPlayerFeatures(state, GameState::PLAYER1, patterns[0], -1, terms);
+	for (int term = 0; term < EvalFeatures::TERM_COUNT; term++)
+		features.counts[term] = (int16_t)std::max(-32768, std::min(32767, terms[term]));
+}
+
+/**
+ * evaluate(state) with the given weights instead of EvalWeights
+ */
+int Evaluator::evaluate(const GameState &state, const int *weights)
+{
+	if (RuleEngine::hasFiveInARow(state, GameState::PLAYER2) ||
+		RuleEngine::checkWin(state, GameState::PLAYER2))
+		return WIN;
+	if (RuleEngine::hasFiveInARow(state, GameState::PLAYER1) ||
+		RuleEngine::checkWin(state, GameState::PLAYER1))
+		return -WIN;
+
+	EvalFeatures features;
+	extractFeatures(state, features);
+	return features.score(weights);
+}
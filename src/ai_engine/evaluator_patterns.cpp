@@ -31,44 +31,48 @@ bool Evaluator::isLineStart(const GameState &state, int x, int y, int dx, int dy
 // LINE ANALYSIS
 // ===============================================
 
+// Bits of a line read against its direction
+static uint32_t reverseLine(uint32_t bits, int length)
+{
+	uint32_t reversed = 0;
+	for (int i = 0; i < length; i++)
+		reversed |= ((bits >> i) & 1) << (length - 1 - i);
+	return reversed;
+}
+
 /**
  * Analyze a line starting from (x,y) in direction (dx,dy)
  * Detects consecutive pieces, gaps, and free ends
+ *
+ * Works on the bitsets of the cell's line (Board): bit k is (x,y) and
+ * bit k + i the cell i steps further along (dx,dy)
  */
 Evaluator::PatternInfo Evaluator::analyzeLine(const GameState &state, int x, int y,
 											  int dx, int dy, int player)
 {
 	PatternInfo info = {0, 0, 0, false, 0, 0, 0};
 
-	// STEP 1: Extended analysis - scan up to 6 positions to detect gaps
-	const int MAX_SCAN = 6;
-	int sequence[MAX_SCAN];
-	int actualPositions = 0;
-
-	// Fill array with content of 6 positions
-	for (int i = 0; i < MAX_SCAN; i++)
+	int d = Board::mainDirection(dx, dy);
+	const BoardLines::Point &point = Board::point(x, y, d);
+	uint32_t cells = BOARD_LINES.cells[point.line];
+	uint32_t own = state.board.stones(point.line, player);
+	uint32_t opponent = state.board.stones(point.line, state.getOpponent(player));
+	int k = point.bit;
+	if (dx != MAIN[d][0] || dy != MAIN[d][1])
 	{
-		int checkX = x + i * dx;
-		int checkY = y + i * dy;
-
-		if (!state.isValid(checkX, checkY))
-		{
-			break;
-		}
-
-		sequence[i] = state.getPiece(checkX, checkY);
-		actualPositions = i + 1;
+		int length = __builtin_popcount(cells);
+		own = reverseLine(own, length);
+		opponent = reverseLine(opponent, length);
+		k = length - 1 - k;
 	}
+	uint32_t empty = cells & ~(own | opponent);
 
-	// STEP 2: Analyze consecutive patterns from start
-	int consecutiveFromStart = 0;
-	while (consecutiveFromStart < actualPositions &&
-		   sequence[consecutiveFromStart] == player)
-	{
-		consecutiveFromStart++;
-	}
+	// STEP 1: Extended analysis - scan up to 6 positions to detect gaps
+	const int MAX_SCAN = 6;
+	int actualPositions = __builtin_ctz(~(cells >> k) | (1u << MAX_SCAN));
 
-	info.consecutiveCount = consecutiveFromStart;
+	// STEP 2: Analyze consecutive patterns from start
+	info.consecutiveCount = __builtin_ctz(~(own >> k) | (1u << MAX_SCAN));
 
 	// STEP 3: If 5+ consecutive, it's immediate victory
 	if (info.consecutiveCount >= 5)
@@ -80,53 +84,23 @@ Evaluator::PatternInfo Evaluator::analyzeLine(const GameState &state, int x, int
 	}
 
 	// STEP 4: Gap pattern analysis (X-XXX, XX-XX, etc.)
-	int totalPieces = 0;
-	int gapCount = 0;
-	int lastPiecePos = -1;
-
-	// Count total pieces and gaps in first 5-6 spaces
-	for (int i = 0; i < actualPositions && i < 6; i++)
-	{
-		if (sequence[i] == player)
-		{
-			totalPieces++;
-			lastPiecePos = i;
-		}
-		else if (sequence[i] != GameState::EMPTY)
-		{
-			// If opponent piece, cut analysis here
-			break;
-		}
-		else if (totalPieces > 0)
-		{
-			// It's a gap (empty space after finding pieces)
-			gapCount++;
-		}
-	}
+	// The scan stops at the first opponent piece; empty cells count as
+	// gaps once a piece has been found
+	int scanned = __builtin_ctz((opponent >> k) | (1u << actualPositions));
+	uint32_t window = (1u << scanned) - 1;
+	uint32_t pieces = (own >> k) & window;
+	int totalPieces = __builtin_popcount(pieces);
+	int gapCount = pieces ? __builtin_popcount(((empty >> k) & window) >> __builtin_ctz(pieces)) : 0;
 
 	// STEP 5: Determine total span (from first to last piece)
-	int totalSpan = lastPiecePos + 1;
+	int totalSpan = pieces ? 32 - __builtin_clz(pieces) : 0;
 
 	// STEP 6: Detect significant gaps
 	bool hasGaps = (gapCount > 0 && totalPieces > info.consecutiveCount);
 
-	// STEP 7: Calculate free ends
-	info.freeEnds = 0;
-
-	// Check back end (before start)
-	int backX = x - dx, backY = y - dy;
-	if (state.isValid(backX, backY) && state.isEmpty(backX, backY))
-	{
-		info.freeEnds++;
-	}
-
-	// Check front end (after last analyzed element)
-	int frontX = x + totalSpan * dx;
-	int frontY = y + totalSpan * dy;
-	if (state.isValid(frontX, frontY) && state.isEmpty(frontX, frontY))
-	{
-		info.freeEnds++;
-	}
+	// STEP 7: Calculate free ends (before start, after the span)
+	int front = k + totalSpan;
+	info.freeEnds = (k > 0 ? (empty >> (k - 1)) & 1 : 0) + ((empty >> front) & 1);
 
 	// STEP 8: Assign final values
 	info.totalPieces = totalPieces;
@@ -137,28 +111,11 @@ Evaluator::PatternInfo Evaluator::analyzeLine(const GameState &state, int x, int
 	// STEP 9: Compute maxReachable — total usable cells (own + empty)
 	// in this direction. If < 5, pattern can never become 5-in-a-row.
 	{
-		int reachable = totalSpan; // Already includes pieces + gaps in span
-
-		// Extend backward (before start position)
-		int bx = x - dx, by = y - dy;
-		while (state.isValid(bx, by) && state.getPiece(bx, by) != state.getOpponent(player))
-		{
-			reachable++;
-			bx -= dx;
-			by -= dy;
-		}
-
-		// Extend forward (after span end)
-		int fx = x + totalSpan * dx;
-		int fy = y + totalSpan * dy;
-		while (state.isValid(fx, fy) && state.getPiece(fx, fy) != state.getOpponent(player))
-		{
-			reachable++;
-			fx += dx;
-			fy += dy;
-		}
-
-		info.maxReachable = reachable;
+		uint32_t usable = cells & ~opponent;
+		uint32_t blockedBehind = ~usable & ((1u << k) - 1);
+		int behind = blockedBehind ? k - 1 - (31 - __builtin_clz(blockedBehind)) : k;
+		int ahead = __builtin_ctz(~(usable >> front));
+		info.maxReachable = totalSpan + behind + ahead;
 	}
 
 	return info;
@@ -168,170 +125,70 @@ Evaluator::PatternInfo Evaluator::analyzeLine(const GameState &state, int x, int
 // PATTERN SCORING
 // ===============================================
 
+// Pattern counters of EvaluationDebugCapture for the player being scored
+static void countDebugPattern(int term)
+{
+	if (!DebugConfig::SEARCH_INSTRUMENTATION || !g_evalDebug.active)
+		return;
+	bool ai = g_evalDebug.currentPlayer == GameState::PLAYER2;
+	if (term == EvalFeatures::FOUR_OPEN)
+		(ai ? g_evalDebug.aiFourOpen : g_evalDebug.humanFourOpen)++;
+	else if (term == EvalFeatures::FOUR_HALF)
+		(ai ? g_evalDebug.aiFourHalf : g_evalDebug.humanFourHalf)++;
+	else if (term == EvalFeatures::THREE_OPEN)
+		(ai ? g_evalDebug.aiThreeOpen : g_evalDebug.humanThreeOpen)++;
+	else if (term == EvalFeatures::TWO_OPEN)
+		(ai ? g_evalDebug.aiTwoOpen : g_evalDebug.humanTwoOpen)++;
+}
+
 /**
- * Convert pattern information to score
- * Handles consecutive patterns, gap patterns, and various threat levels
+ * Classify a line pattern: the EvalFeatures::Term it scores as, or -1
+ * for none. Handles consecutive patterns, gap patterns, and various
+ * threat levels
  */
-int Evaluator::patternToScore(const PatternInfo &pattern)
+int Evaluator::patternTerm(const PatternInfo &pattern)
 {
 	int consecutiveCount = pattern.consecutiveCount;
 	int totalPieces = pattern.totalPieces;
 	int freeEnds = pattern.freeEnds;
 	bool hasGaps = pattern.hasGaps;
+	int term = -1;
 
 	// SPACE VALIDATION: If not enough room to ever make 5-in-a-row,
 	// this pattern is strategically worthless (dead shape).
 	if (pattern.maxReachable < 5 && consecutiveCount < 5)
-		return 0;
+		return -1;
 
-	// STEP 1: Victory patterns (5+ pieces consecutive or with valid gaps)
-	if (consecutiveCount >= 5)
-		return WIN;
+	// STEP 1: Victory patterns (5+ pieces consecutive, or with valid
+	// gaps: X-XXXX, XX-XXX, etc.)
+	if (consecutiveCount >= 5 || (totalPieces >= 5 && hasGaps && freeEnds >= 1))
+		return EvalFeatures::PATTERN_FIVE;
 
-	// Victory with gaps - X-XXXX, XX-XXX, etc.
-	if (totalPieces >= 5 && hasGaps && freeEnds >= 1)
+	// STEP 2: Critical 4-piece patterns: 4 consecutive (XXXX) or 4 with
+	// gaps (X-XXX, XX-XX, XXX-X, as unstoppable when open)
+	if (totalPieces == 4 && (consecutiveCount == 4 || hasGaps))
 	{
-		return WIN; // Also victory
-	}
-
-	// STEP 2: Critical 4-piece patterns
-	if (totalPieces == 4)
-	{
-		// Case 1: 4 consecutive (XXXX)
-		if (consecutiveCount == 4)
-		{
-			if (freeEnds == 2)
-			{
-				if (g_evalDebug.active)
-				{
-					if (g_evalDebug.currentPlayer == GameState::PLAYER2)
-					{
-						g_evalDebug.aiFourOpen++;
-					}
-					else
-					{
-						g_evalDebug.humanFourOpen++;
-					}
-				}
-				return FOUR_OPEN; // Unstoppable
-			}
-			if (freeEnds == 1)
-			{
-				if (g_evalDebug.active)
-				{
-					if (g_evalDebug.currentPlayer == GameState::PLAYER2)
-					{
-						g_evalDebug.aiFourHalf++;
-					}
-					else
-					{
-						g_evalDebug.humanFourHalf++;
-					}
-				}
-				return FOUR_HALF; // Forced threat
-			}
-		}
-		// Case 2: 4 with gaps (X-XXX, XX-XX, XXX-X)
-		else if (hasGaps)
-		{
-			if (freeEnds == 2)
-			{
-				if (g_evalDebug.active)
-				{
-					if (g_evalDebug.currentPlayer == GameState::PLAYER2)
-					{
-						g_evalDebug.aiFourOpen++;
-					}
-					else
-					{
-						g_evalDebug.humanFourOpen++;
-					}
-				}
-				return FOUR_OPEN; // CRITICAL! X-XXX is unstoppable
-			}
-			if (freeEnds == 1)
-			{
-				if (g_evalDebug.active)
-				{
-					if (g_evalDebug.currentPlayer == GameState::PLAYER2)
-					{
-						g_evalDebug.aiFourHalf++;
-					}
-					else
-					{
-						g_evalDebug.humanFourHalf++;
-					}
-				}
-				return FOUR_HALF; // Strong threat
-			}
-		}
+		if (freeEnds == 2)
+			term = EvalFeatures::FOUR_OPEN;
+		else if (freeEnds == 1)
+			term = EvalFeatures::FOUR_HALF;
 	}
 
-	// STEP 3: 3-piece patterns
-	if (totalPieces == 3)
+	// STEP 3: 3-piece patterns: XXX, or with gaps X-XX, XX-X
+	if (totalPieces == 3 && (consecutiveCount == 3 || hasGaps))
 	{
-		// Case 1: 3 consecutive (XXX)
-		if (consecutiveCount == 3)
-		{
-			if (freeEnds == 2)
-			{
-				if (g_evalDebug.active)
-				{
-					if (g_evalDebug.currentPlayer == GameState::PLAYER2)
-					{
-						g_evalDebug.aiThreeOpen++;
-					}
-					else
-					{
-						g_evalDebug.humanThreeOpen++;
-					}
-				}
-				return THREE_OPEN; // Very dangerous
-			}
-			if (freeEnds == 1)
-				return THREE_HALF; // Threat
-		}
-		// Case 2: 3 with gaps (X-XX, XX-X)
-		else if (hasGaps)
-		{
-			if (freeEnds == 2)
-			{
-				if (g_evalDebug.active)
-				{
-					if (g_evalDebug.currentPlayer == GameState::PLAYER2)
-					{
-						g_evalDebug.aiThreeOpen++;
-					}
-					else
-					{
-						g_evalDebug.humanThreeOpen++;
-					}
-				}
-				return THREE_OPEN; // Also dangerous
-			}
-			if (freeEnds == 1)
-				return THREE_HALF; // Split threat
-		}
+		if (freeEnds == 2)
+			term = EvalFeatures::THREE_OPEN;
+		else if (freeEnds == 1)
+			term = EvalFeatures::THREE_HALF;
 	}
 
-	// STEP 4: 2-piece patterns (development)
+	// STEP 4: 2-piece patterns (development, XX or X-X)
 	if (totalPieces == 2 && freeEnds == 2)
-	{
-		if (g_evalDebug.active)
-		{
-			if (g_evalDebug.currentPlayer == GameState::PLAYER2)
-			{
-				g_evalDebug.aiTwoOpen++;
-			}
-			else
-			{
-				g_evalDebug.humanTwoOpen++;
-			}
-		}
-		return TWO_OPEN; // Development (XX or X-X)
-	}
+		term = EvalFeatures::TWO_OPEN;
 
-	return 0;
+	countDebugPattern(term);
+	return term;
 }
 
 // ===============================================
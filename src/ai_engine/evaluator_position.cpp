@@ -6,14 +6,47 @@
 // ===============================================
 
 #include "../../include/ai/evaluator.hpp"
+#include "../../include/ai/nnue.hpp"
 #include "../../include/rules/rule_engine.hpp"
+#include "../../include/utils/profiler.hpp"
 #include <iostream>
+#include <memory>
 
 using namespace Directions;
 
 // Global debug capture instance
 EvaluationDebugCapture g_evalDebug;
 
+// Network behind GameState::network while one is loaded
+static std::unique_ptr<NnueNetwork> g_network;
+
+// ===============================================
+// EVALUATION MODE
+// ===============================================
+
+bool Evaluator::loadNetwork(const std::string &filename)
+{
+	std::unique_ptr<NnueNetwork> network(new NnueNetwork());
+	if (!network->load(filename))
+		return false;
+	GameState::network = network.get();
+	g_network = std::move(network);
+	return true;
+}
+
+void Evaluator::unloadNetwork()
+{
+	GameState::network = nullptr;
+	g_network.reset();
+}
+
+// NNUE score for the side to move, turned to PLAYER2's view
+static int networkScore(const GameState &state)
+{
+	int score = GameState::network->evaluate(state);
+	return state.currentPlayer == GameState::PLAYER2 ? score : -score;
+}
+
 // ===============================================
 // MAIN EVALUATION FUNCTIONS
 // ===============================================
@@ -24,6 +57,7 @@ EvaluationDebugCapture g_evalDebug;
  */
 int Evaluator::evaluate(const GameState &state, int maxDepth, int currentDepth)
 {
+	PROFILE_SCOPE(EVALUATE);
 	int mateDistance = maxDepth - currentDepth;
 
 	// Check immediate win conditions WITH mate distance
@@ -40,8 +74,13 @@ int Evaluator::evaluate(const GameState &state, int maxDepth, int currentDepth)
 		return -WIN + mateDistance;
 	}
 
-	int aiScore = evaluateForPlayer(state, GameState::PLAYER2);
-	int humanScore = evaluateForPlayer(state, GameState::PLAYER1);
+	if (GameState::network)
+		return networkScore(state);
+
+	PatternCounts counts[2];
+	countAllPatterns(state, counts[0], counts[1]);
+	int aiScore = evaluateForPlayer(state, GameState::PLAYER2, counts[1]);
+	int humanScore = evaluateForPlayer(state, GameState::PLAYER1, counts[0]);
 
 	return aiScore - humanScore;
 }
@@ -51,6 +90,7 @@ int Evaluator::evaluate(const GameState &state, int maxDepth, int currentDepth)
  */
 int Evaluator::evaluate(const GameState &state)
 {
+	PROFILE_SCOPE(EVALUATE);
 	// Check immediate win conditions
 	// hasFiveInARow catches breakable 5-in-a-row that checkWin ignores
 	if (RuleEngine::hasFiveInARow(state, GameState::PLAYER2) ||
@@ -60,18 +100,25 @@ int Evaluator::evaluate(const GameState &state)
 	    RuleEngine::checkWin(state, GameState::PLAYER1))
 		return -WIN;
 
+	if (GameState::network)
+		return networkScore(state);
+
+	// Both players' pattern counts in one scan
+	PatternCounts counts[2];
+	countAllPatterns(state, counts[0], counts[1]);
+
 	// Evaluate AI with debug capture if active
-	if (g_evalDebug.active)
+	if (DebugConfig::SEARCH_INSTRUMENTATION && g_evalDebug.active)
 		g_evalDebug.currentPlayer = GameState::PLAYER2;
-	int aiScore = evaluateForPlayer(state, GameState::PLAYER2);
+	int aiScore = evaluateForPlayer(state, GameState::PLAYER2, counts[1]);
 
 	// Evaluate HUMAN with debug capture if active
-	if (g_evalDebug.active)
+	if (DebugConfig::SEARCH_INSTRUMENTATION && g_evalDebug.active)
 		g_evalDebug.currentPlayer = GameState::PLAYER1;
-	int humanScore = evaluateForPlayer(state, GameState::PLAYER1);
+	int humanScore = evaluateForPlayer(state, GameState::PLAYER1, counts[0]);
 
 	// Complete debug information
-	if (g_evalDebug.active)
+	if (DebugConfig::SEARCH_INSTRUMENTATION && g_evalDebug.active)
 	{
 		g_evalDebug.totalScore = aiScore - humanScore;
 		g_evalDebug.aiScore = aiScore;
@@ -87,17 +134,20 @@ int Evaluator::evaluate(const GameState &state)
  */
 int Evaluator::evaluateForPlayer(const GameState &state, int player)
 {
-	int score = 0;
+	return evaluateForPlayer(state, player, countAllPatterns(state, player));
+}
 
+int Evaluator::evaluateForPlayer(const GameState &state, int player, const PatternCounts &counts)
+{
 	// Capture debug info if active for this player
-	bool captureForThisPlayer = g_evalDebug.active && player == g_evalDebug.currentPlayer;
-
-	// Single-pass threat + combination evaluation (replaces 5 separate board scans)
-	PatternCounts counts = countAllPatterns(state, player);
-	score += evaluateThreatsAndCombinations(state, player, counts);
+	bool captureForThisPlayer = DebugConfig::SEARCH_INSTRUMENTATION &&
+								 g_evalDebug.active && player == g_evalDebug.currentPlayer;
 
-	// Unified evaluation: patterns + captures in single pass
-	score += analyzePosition(state, player);
+	// Threats, combinations, patterns and captures as feature counts,
+	// scored with the EvalWeights values
+	int terms[EvalFeatures::TERM_COUNT] = {0};
+	addPlayerFeatures(state, player, counts, 1, terms);
+	int score = EvalFeatures::score(terms, EvalFeatures::DEFAULT_WEIGHTS);
 
 	// Capture information if activated
 	if (captureForThisPlayer)
@@ -120,13 +170,17 @@ int Evaluator::evaluateForPlayer(const GameState &state, int player)
  * Evaluates patterns and capture opportunities in optimized single pass
  */
 int Evaluator::analyzePosition(const GameState& state, int player) {
-    int totalScore = 0;
+    int terms[EvalFeatures::TERM_COUNT] = {0};
+    addPositionFeatures(state, player, 1, terms);
+    return EvalFeatures::score(terms, EvalFeatures::DEFAULT_WEIGHTS);
+}
+
+/**
+ * Terms of analyzePosition, added to terms with `sign`
+ */
+void Evaluator::addPositionFeatures(const GameState& state, int player, int sign, int* terms) {
     int opponent = state.getOpponent(player);
     
-    // Variables for captures
-    int captureOpportunities = 0;
-    int captureThreats = 0;
-    
     // OPTIMIZATION: Mark already evaluated lines
     bool evaluated[GameState::BOARD_SIZE][GameState::BOARD_SIZE][4] = {{{false}}};
     
@@ -144,7 +198,8 @@ int Evaluator::analyzePosition(const GameState& state, int player) {
                     
                     if (isLineStart(state, i, j, dx, dy, player)) {
                         PatternInfo pattern = analyzeLine(state, i, j, dx, dy, player);
-                        totalScore += patternToScore(pattern);
+                        int term = patternTerm(pattern);
+                        if (term >= 0) terms[term] += sign;
                         
                         // Mark evaluated positions
                         int markX = i, markY = j;
@@ -174,9 +229,7 @@ int Evaluator::analyzePosition(const GameState& state, int player) {
         int currentCaptures = state.captures[player - 1];
         int newTotal = currentCaptures + captureCount;
         
-        captureOpportunities += evaluateCaptureContext(
-            state, player, opp.captured, newTotal
-        );
+        addCaptureFeatures(state, player, opp.captured, newTotal, sign, terms);
     }
     
     // DEFENSIVE CAPTURES: Find player's pairs opponent can capture
@@ -186,9 +239,7 @@ int Evaluator::analyzePosition(const GameState& state, int player) {
         int oppCurrentCaptures = state.captures[opponent - 1];
         int oppNewTotal = oppCurrentCaptures + captureCount;
         
-        captureThreats += evaluateCaptureContext(
-            state, opponent, threat.captured, oppNewTotal
-        );
+        addCaptureFeatures(state, opponent, threat.captured, oppNewTotal, -sign, terms);
     }
     
     // ============================================
@@ -198,21 +249,16 @@ int Evaluator::analyzePosition(const GameState& state, int player) {
     int oppCaptures = state.captures[opponent - 1];
     
     // Score my captures (progressive scaling)
-    if (myCaptures >= 9) totalScore += 300000;      // Almost winning
-    else if (myCaptures >= 8) totalScore += 200000;  // Very dangerous
-    else if (myCaptures >= 6) totalScore += 15000;   // Strong
-    else if (myCaptures >= 4) totalScore += 6000;    // Good
-    else totalScore += myCaptures * 500;             // Base value
+    if (myCaptures >= 9) terms[EvalFeatures::HELD_9] += sign;               // Almost winning
+    else if (myCaptures >= 8) terms[EvalFeatures::HELD_8] += sign;          // Very dangerous
+    else if (myCaptures >= 6) terms[EvalFeatures::HELD_6] += sign;          // Strong
+    else if (myCaptures >= 4) terms[EvalFeatures::HELD_4] += sign;          // Good
+    else terms[EvalFeatures::HELD_PAIR] += sign * myCaptures;               // Base value
     
     // Penalize opponent captures (higher penalty)
-    if (oppCaptures >= 9) totalScore -= 400000;      // Almost losing
-    else if (oppCaptures >= 8) totalScore -= 300000;  // Critical danger
-    else if (oppCaptures >= 6) totalScore -= 20000;   // Serious threat
-    else if (oppCaptures >= 4) totalScore -= 8000;    // Concern
-    else totalScore -= oppCaptures * 800;             // Base penalty
-    
-    totalScore += captureOpportunities;
-    totalScore -= captureThreats;
-    
-    return totalScore;
+    if (oppCaptures >= 9) terms[EvalFeatures::LOST_9] -= sign;              // Almost losing
+    else if (oppCaptures >= 8) terms[EvalFeatures::LOST_8] -= sign;         // Critical danger
+    else if (oppCaptures >= 6) terms[EvalFeatures::LOST_6] -= sign;         // Serious threat
+    else if (oppCaptures >= 4) terms[EvalFeatures::LOST_4] -= sign;         // Concern
+    else terms[EvalFeatures::LOST_PAIR] -= sign * oppCaptures;              // Base penalty
 }
@@ -6,6 +6,7 @@
 // ===============================================
 
 #include "../../include/ai/evaluator.hpp"
+#include "../../include/ai/pattern_scanner.hpp"
 #include "../../include/core/game_types.hpp"
 
 using namespace Directions;
@@ -19,6 +20,21 @@ using namespace Directions;
  * Replaces 5 separate countPatternType calls with a single O(19*19*4) pass.
  */
 Evaluator::PatternCounts Evaluator::countAllPatterns(const GameState &state, int player)
+{
+	PatternCounts counts[2];
+	PatternScanner::count(state, counts[0], counts[1]);
+	return counts[player - 1];
+}
+
+void Evaluator::countAllPatterns(const GameState &state, PatternCounts &player1, PatternCounts &player2)
+{
+	PatternScanner::count(state, player1, player2);
+}
+
+/**
+ * Reference scan: analyzeLine at every line start of the player's stones
+ */
+Evaluator::PatternCounts Evaluator::countAllPatternsScan(const GameState &state, int player)
 {
 	PatternCounts counts = {0, 0, 0, 0, 0};
 
@@ -48,7 +64,7 @@ Evaluator::PatternCounts Evaluator::countAllPatterns(const GameState &state, int
 				int fe = pattern.freeEnds;
 				bool gaps = pattern.hasGaps;
 
-				// Classify pattern (mirrors patternToScore logic)
+				// Classify pattern (mirrors patternTerm logic)
 				if (tp >= 4)
 				{
 					if (c == 4 || (tp == 4 && gaps))
@@ -88,35 +104,39 @@ Evaluator::PatternCounts Evaluator::countAllPatterns(const GameState &state, int
 int Evaluator::evaluateThreatsAndCombinations(const GameState &state, int player,
 											  const PatternCounts &counts)
 {
-	int score = 0;
+	int terms[EvalFeatures::TERM_COUNT] = {0};
+	addThreatFeatures(state, player, counts, 1, terms);
+	return EvalFeatures::score(terms, EvalFeatures::DEFAULT_WEIGHTS);
+}
 
+void Evaluator::addThreatFeatures(const GameState &state, int player, const PatternCounts &counts,
+								  int sign, int *terms)
+{
 	// --- Immediate threats (from evaluateImmediateThreats) ---
 
 	if (counts.fourOpen > 0)
-		score += 90000;
+		terms[EvalFeatures::THREAT_FOUR_OPEN] += sign;
 
 	if (counts.fourHalf > 0)
-		score += 40000;
+		terms[EvalFeatures::THREAT_FOUR_HALF] += sign;
 
 	if (counts.threeOpen >= 2)
-		score += 50000;
+		terms[EvalFeatures::THREAT_DOUBLE_THREE] += sign;
 
 	// --- Combinations / forks (from evaluateCombinations) ---
 
 	// FOUR_HALF + THREE_OPEN fork
 	if (counts.fourHalf >= 1 && counts.threeOpen >= 1)
-		score += 80000;
+		terms[EvalFeatures::FORK_FOUR_THREE] += sign;
 
 	// Double FOUR_HALF
 	if (counts.fourHalf >= 2)
-		score += 70000;
+		terms[EvalFeatures::FORK_DOUBLE_FOUR] += sign;
 
 	// Capture synergy
 	int myCaptures = state.captures[player - 1];
 	if (myCaptures >= 8 && counts.threeOpen >= 1)
-		score += 60000;
-
-	return score;
+		terms[EvalFeatures::FORK_CAPTURES_THREE] += sign;
 }
 
 // ===============================================
@@ -135,11 +155,11 @@ int Evaluator::evaluateImmediateThreats(const GameState &state, int player)
 	int threeOpen = countPatternType(state, player, 3, 2);
 
 	if (fourOpen > 0)
-		threatScore += 90000;
+		threatScore += EvalWeights::THREAT_FOUR_OPEN;
 	if (fourHalf > 0)
-		threatScore += 40000;
+		threatScore += EvalWeights::THREAT_FOUR_HALF;
 	if (threeOpen >= 2)
-		threatScore += 50000;
+		threatScore += EvalWeights::THREAT_DOUBLE_THREE;
 
 	return threatScore;
 }
@@ -296,14 +316,14 @@ int Evaluator::evaluateCombinations(const GameState &state, int player)
 	//    Opponent must block the four, leaving the three free to extend.
 	if (fourHalf >= 1 && threeOpen >= 1)
 	{
-		comboScore += 80000;
+		comboScore += EvalWeights::FORK_FOUR_THREE;
 	}
 
 	// 2. Double FOUR_HALF:
 	//    Opponent can only block one four at a time → guaranteed win next move.
 	if (fourHalf >= 2)
 	{
-		comboScore += 70000;
+		comboScore += EvalWeights::FORK_DOUBLE_FOUR;
 	}
 
 	// 3. Capture synergy:
@@ -312,7 +332,7 @@ int Evaluator::evaluateCombinations(const GameState &state, int player)
 	int myCaptures = state.captures[player - 1];
 	if (myCaptures >= 8 && threeOpen >= 1)
 	{
-		comboScore += 60000;
+		comboScore += EvalWeights::FORK_CAPTURES_THREE;
 	}
 
 	// 4. THREE_OPEN + FOUR_HALF already covered above.
@@ -327,36 +347,36 @@ int Evaluator::evaluateCombinations(const GameState &state, int player)
 // ===============================================
 
 /**
- * Evaluate capture in context of game state
+ * Terms of a capture in context of game state
  * Considers proximity to victory, pattern disruption, tactical value
  */
-int Evaluator::evaluateCaptureContext(const GameState &state, int player, 
-									  const std::vector<Move> &capturedPieces, 
-									  int newCaptureCount)
+void Evaluator::addCaptureFeatures(const GameState &state, int player,
+								   const std::vector<Move> &capturedPieces,
+								   int newCaptureCount, int sign, int *terms)
 {
-	int value = 0;
 	int opponent = state.getOpponent(player);
 
 	// 1. BASE VALUE: Proximity to capture victory
 	if (newCaptureCount >= 10)
 	{
-		return 500000; // IMMEDIATE VICTORY!
+		terms[EvalFeatures::CAPTURE_WIN] += sign; // IMMEDIATE VICTORY!
+		return;
 	}
 	else if (newCaptureCount == 9)
 	{
-		value += 100000; // One more capture and we win
+		terms[EvalFeatures::CAPTURE_TO_9] += sign; // One more capture and we win
 	}
 	else if (newCaptureCount >= 8)
 	{
-		value += 50000; // Very close
+		terms[EvalFeatures::CAPTURE_TO_8] += sign; // Very close
 	}
 	else if (newCaptureCount >= 6)
 	{
-		value += 15000; // Considerable pressure
+		terms[EvalFeatures::CAPTURE_TO_6] += sign; // Considerable pressure
 	}
 	else
 	{
-		value += newCaptureCount * 2000; // Normal development
+		terms[EvalFeatures::CAPTURE_PAIRS] += sign * newCaptureCount; // Normal development
 	}
 
 	// 2. DEFENSIVE VALUE: Does it break opponent patterns?
@@ -375,15 +395,15 @@ int Evaluator::evaluateCaptureContext(const GameState &state, int player,
 			// Scoring based on how dangerous the pattern was
 			if (patternSize >= 4)
 			{
-				value += 30000; // Broke a 4-in-row!
+				terms[EvalFeatures::BREAKS_FOUR] += sign; // Broke a 4-in-row!
 			}
 			else if (patternSize == 3)
 			{
-				value += 12000; // Broke a 3-in-row
+				terms[EvalFeatures::BREAKS_THREE] += sign; // Broke a 3-in-row
 			}
 			else if (patternSize == 2)
 			{
-				value += 3000; // Broke a 2-in-row
+				terms[EvalFeatures::BREAKS_TWO] += sign; // Broke a 2-in-row
 			}
 		}
 	}
@@ -409,7 +429,7 @@ int Evaluator::evaluateCaptureContext(const GameState &state, int player,
 
 			if (hasMyPieceAdjacent)
 			{
-				value += 1500; // Creates tactical opportunities
+				terms[EvalFeatures::OPENS_LINE] += sign; // Creates tactical opportunities
 			}
 		}
 	}
@@ -419,10 +439,8 @@ int Evaluator::evaluateCaptureContext(const GameState &state, int player,
 	if (opponentCaptures >= 8)
 	{
 		// Critical defensive capture if it prevents more captures
-		value += 25000;
+		terms[EvalFeatures::CAPTURE_UNDER_PRESSURE] += sign;
 	}
-
-	return value;
 }
 
 // ===============================================
@@ -0,0 +1,117 @@
+// ===============================================
+// AI Engine - Game Analyzer Module
+// ===============================================
+// Handles: Re-search of recorded games, played move vs engine move
+// Dependencies: TranspositionSearch, Evaluator, RuleEngine, GameRecord
+// ===============================================
+
+#include "../../include/ai/game_analyzer.hpp"
+#include "../../include/ai/evaluator.hpp"
+#include "../../include/rules/rule_engine.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+// findBestMoveIterative stops deepening once a score is past this: a
+// deeper search would keep the win or loss
+static const int DECISIVE_SCORE = 300000;
+
+// ===============================================
+// POSITION SEARCH
+// ===============================================
+
+struct SearchedPosition
+{
+	Move best;
+	int score; // For the player to move
+	int depth;
+	int nodes;
+	std::vector<int> iterationScores; // [d - 1]: score of iteration d, same side
+};
+
+static SearchedPosition searchPosition(TranspositionSearch &search, const GameState &state, int depth)
+{
+	SearchResult result = search.findBestMoveIterative(state, depth);
+	const std::vector<SearchStats> &iterations = search.getLastSearchStats();
+	SearchedPosition position;
+	// No candidates on the empty board: the engine plays the centre
+	position.best = result.bestMove.isValid() ? result.bestMove : RuleEngine::findCentralLegalMove(state);
+	position.score = search.scoreForPlayerToMove(state, result.score);
+	position.depth = iterations.empty() ? 1 : iterations.back().depth;
+	position.nodes = result.nodesEvaluated;
+	for (const SearchStats &iteration : iterations)
+		position.iterationScores.push_back(TranspositionSearch::forPlayerToMove(state, iteration.score));
+	return position;
+}
+
+/**
+ * Score of a searched position seen `horizon` plies deep: the deepest
+ * completed iteration up to it (a mate can end the search early), the
+ * static evaluation for horizon 0
+ */
+static int scoreAtHorizon(const GameState &state, const SearchedPosition &position, int horizon)
+{
+	if (horizon <= 0)
+		return TranspositionSearch::forPlayerToMove(state, Evaluator::evaluate(state));
+	if (position.iterationScores.empty())
+		return position.score; // Immediate win, found at any depth
+	size_t iterations = std::min(position.iterationScores.size(), (size_t)horizon);
+	return position.iterationScores[iterations - 1];
+}
+
+// ===============================================
+// GAME ANALYSIS
+// ===============================================
+
+GameAnalyzer::Result GameAnalyzer::analyze(TranspositionSearch &search, const GameRecord &record, int depth)
+{
+	Result analysis;
+	search.clearCache();
+
+	GameState state;
+	SearchedPosition current = searchPosition(search, state, depth);
+	analysis.nodes += current.nodes;
+
+	for (size_t ply = 0; ply < record.moves.size(); ply++)
+	{
+		const Move &played = record.moves[ply].move;
+		int mover = state.currentPlayer;
+		GameState next = state;
+		if (!GameRecordReader::applyMove(next, record.moves[ply]))
+		{
+			analysis.complete = false;
+			break;
+		}
+
+		// The next position is searched anyway, except after the last move;
+		// its iterations also give the played move's score one ply short of
+		// the root's depth
+		bool moverWon = RuleEngine::checkWin(next, mover);
+		bool needNext = !moverWon && (ply + 1 < record.moves.size() || !(played == current.best));
+		SearchedPosition after = {Move(), 0, 0, 0, {}};
+		if (needNext)
+		{
+			after = searchPosition(search, next, depth);
+			analysis.nodes += after.nodes;
+		}
+
+		MoveAnalysis move;
+		move.player = mover;
+		move.played = played;
+		move.best = current.best;
+		move.score = current.score;
+		move.playedScore = current.score;
+		if (!(played == current.best))
+		{
+			int horizon = (std::abs(current.score) > DECISIVE_SCORE ? depth : current.depth) - 1;
+			move.playedScore = moverWon ? Evaluator::WIN : -scoreAtHorizon(next, after, horizon);
+		}
+		move.loss = std::max(0, move.score - move.playedScore);
+		move.depth = current.depth;
+		move.nodes = current.nodes;
+		analysis.moves.push_back(move);
+
+		state = next;
+		current = after;
+	}
+	return analysis;
+}
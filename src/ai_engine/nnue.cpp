@@ -0,0 +1,373 @@
+// ===============================================
+// AI Engine - NNUE Evaluator Module
+// ===============================================
+// Handles: Network weights (load / save), accumulator refresh and
+//          incremental update, forward pass with SIMD kernels
+// Dependencies: GameState
+// ===============================================
+
+#include "../../include/ai/nnue.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define NNUE_X86 1
+#include <immintrin.h>
+#endif
+
+static const char MAGIC[4] = {'G', 'M', 'K', 'N'};
+static const uint8_t FORMAT_VERSION = 1;
+static const size_t HEADER_BYTES = 20;
+static const size_t FILE_BYTES = HEADER_BYTES +
+								 2 * NnueNetwork::HIDDEN +
+								 2 * (size_t)NnueNetwork::INPUTS * NnueNetwork::HIDDEN +
+								 4 * NnueNetwork::L1 +
+								 (size_t)NnueNetwork::L1 * NnueNetwork::L1_INPUTS +
+								 4 + NnueNetwork::L1;
+
+// ===============================================
+// 128 -> 16 LAYER KERNELS
+// ===============================================
+// out[j] = bias[j] + sum of input[i] * weights[j][i]. Inputs are 0..127 and
+// weights int8, so the pairwise int16 sums of maddubs cannot saturate and
+// every kernel returns the scalar result exactly.
+
+typedef void (*AffineKernel)(const uint8_t *input, const int8_t *weights,
+							 const int32_t *bias, int32_t *output);
+
+static void affineScalar(const uint8_t *input, const int8_t *weights,
+						 const int32_t *bias, int32_t *output)
+{
+	for (int j = 0; j < NnueNetwork::L1; j++)
+	{
+		const int8_t *row = weights + j * NnueNetwork::L1_INPUTS;
+		int32_t sum = bias[j];
+		for (int i = 0; i < NnueNetwork::L1_INPUTS; i++)
+			sum += input[i] * row[i];
+		output[j] = sum;
+	}
+}
+
+#ifdef NNUE_X86
+__attribute__((target("ssse3"))) static void affineSsse3(const uint8_t *input, const int8_t *weights,
+														 const int32_t *bias, int32_t *output)
+{
+	const __m128i ones = _mm_set1_epi16(1);
+	for (int j = 0; j < NnueNetwork::L1; j++)
+	{
+		const int8_t *row = weights + j * NnueNetwork::L1_INPUTS;
+		__m128i sum = _mm_setzero_si128();
+		for (int i = 0; i < NnueNetwork::L1_INPUTS; i += 16)
+		{
+			__m128i x = _mm_loadu_si128((const __m128i *)(input + i));
+			__m128i w = _mm_loadu_si128((const __m128i *)(row + i));
+			sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_maddubs_epi16(x, w), ones));
+		}
+		sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+		sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+		output[j] = bias[j] + _mm_cvtsi128_si32(sum);
+	}
+}
+
+__attribute__((target("avx2"))) static void affineAvx2(const uint8_t *input, const int8_t *weights,
+													   const int32_t *bias, int32_t *output)
+{
+	const __m256i ones = _mm256_set1_epi16(1);
+	for (int j = 0; j < NnueNetwork::L1; j++)
+	{
+		const int8_t *row = weights + j * NnueNetwork::L1_INPUTS;
+		__m256i sum = _mm256_setzero_si256();
+		for (int i = 0; i < NnueNetwork::L1_INPUTS; i += 32)
+		{
+			__m256i x = _mm256_loadu_si256((const __m256i *)(input + i));
+			__m256i w = _mm256_loadu_si256((const __m256i *)(row + i));
+			sum = _mm256_add_epi32(sum, _mm256_madd_epi16(_mm256_maddubs_epi16(x, w), ones));
+		}
+		__m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+		half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0x4E));
+		half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0xB1));
+		output[j] = bias[j] + _mm_cvtsi128_si32(half);
+	}
+}
+#endif
+
+static AffineKernel affineKernel(NnueNetwork::Kernel kernel)
+{
+#ifdef NNUE_X86
+	if (kernel == NnueNetwork::AVX2)
+		return affineAvx2;
+	if (kernel == NnueNetwork::SSSE3)
+		return affineSsse3;
+#endif
+	(void)kernel;
+	return affineScalar;
+}
+
+bool NnueNetwork::kernelSupported(Kernel kernel)
+{
+	if (kernel == SCALAR)
+		return true;
+#ifdef NNUE_X86
+	if (kernel == SSSE3)
+		return __builtin_cpu_supports("ssse3");
+	if (kernel == AVX2)
+		return __builtin_cpu_supports("avx2");
+#endif
+	return false;
+}
+
+const char *NnueNetwork::kernelName(Kernel kernel)
+{
+	switch (kernel)
+	{
+	case AVX2:
+		return "AVX2";
+	case SSSE3:
+		return "SSSE3";
+	default:
+		return "scalar";
+	}
+}
+
+bool NnueNetwork::setKernel(Kernel newKernel)
+{
+	if (!kernelSupported(newKernel))
+		return false;
+	kernel = newKernel;
+	return true;
+}
+
+// ===============================================
+// WEIGHTS
+// ===============================================
+
+NnueNetwork::NnueNetwork()
+	: ftBias(HIDDEN, 0), ftWeights((size_t)INPUTS * HIDDEN, 0), l1Bias(L1, 0),
+	  l1Weights((size_t)L1 * L1_INPUTS, 0), outBias(0), outWeights(L1, 0),
+	  outputScale(OUTPUT_DIVISOR), kernel(SCALAR), weightsId(nextWeightsId())
+{
+	if (kernelSupported(AVX2))
+		kernel = AVX2;
+	else if (kernelSupported(SSSE3))
+		kernel = SSSE3;
+}
+
+uint32_t NnueNetwork::nextWeightsId()
+{
+	static std::atomic<uint32_t> counter(0);
+	return ++counter;
+}
+
+void NnueNetwork::randomize(uint64_t seed)
+{
+	weightsId = nextWeightsId();
+	std::mt19937_64 random(seed);
+	auto uniform = [&random](int low, int high)
+	{ return std::uniform_int_distribution<int>(low, high)(random); };
+
+	for (int16_t &value : ftBias)
+		value = (int16_t)uniform(0, 64);
+	for (int16_t &value : ftWeights)
+		value = (int16_t)uniform(-24, 24);
+	for (int32_t &value : l1Bias)
+		value = uniform(-2048, 2048);
+	for (int8_t &value : l1Weights)
+		value = (int8_t)uniform(-64, 64);
+	outBias = uniform(-512, 512);
+	for (int8_t &value : outWeights)
+		value = (int8_t)uniform(-127, 127);
+	outputScale = 4096;
+}
+
+static uint32_t readLE(const uint8_t *bytes, int size)
+{
+	uint32_t value = 0;
+	for (int i = 0; i < size; i++)
+		value |= (uint32_t)bytes[i] << (i * 8);
+	return value;
+}
+
+static void writeLE(std::vector<uint8_t> &bytes, uint32_t value, int size)
+{
+	for (int i = 0; i < size; i++)
+		bytes.push_back((uint8_t)(value >> (i * 8)));
+}
+
+bool NnueNetwork::load(const std::string &filename)
+{
+	std::ifstream file(filename, std::ios::binary);
+	if (!file.is_open())
+	{
+		std::cerr << "Error: Could not open network file " << filename << std::endl;
+		return false;
+	}
+	std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	if (bytes.size() != FILE_BYTES || std::memcmp(bytes.data(), MAGIC, 4) != 0 ||
+		bytes[4] != FORMAT_VERSION || bytes[5] != GameState::BOARD_SIZE ||
+		readLE(&bytes[8], 2) != INPUTS || readLE(&bytes[10], 2) != HIDDEN || readLE(&bytes[12], 2) != L1)
+	{
+		std::cerr << "Error: " << filename << " is not a " << INPUTS << "x" << HIDDEN << "x" << L1
+				  << " network file" << std::endl;
+		return false;
+	}
+
+	weightsId = nextWeightsId();
+	const uint8_t *cursor = &bytes[16];
+	outputScale = (int32_t)readLE(cursor, 4);
+	cursor += 4;
+	for (int16_t &value : ftBias)
+	{
+		value = (int16_t)readLE(cursor, 2);
+		cursor += 2;
+	}
+	for (int16_t &value : ftWeights)
+	{
+		value = (int16_t)readLE(cursor, 2);
+		cursor += 2;
+	}
+	for (int32_t &value : l1Bias)
+	{
+		value = (int32_t)readLE(cursor, 4);
+		cursor += 4;
+	}
+	for (int8_t &value : l1Weights)
+		value = (int8_t)*cursor++;
+	outBias = (int32_t)readLE(cursor, 4);
+	cursor += 4;
+	for (int8_t &value : outWeights)
+		value = (int8_t)*cursor++;
+	return true;
+}
+
+bool NnueNetwork::save(const std::string &filename) const
+{
+	std::vector<uint8_t> bytes(MAGIC, MAGIC + 4);
+	bytes.reserve(FILE_BYTES);
+	bytes.push_back(FORMAT_VERSION);
+	bytes.push_back((uint8_t)GameState::BOARD_SIZE);
+	writeLE(bytes, 0, 2);
+	writeLE(bytes, INPUTS, 2);
+	writeLE(bytes, HIDDEN, 2);
+	writeLE(bytes, L1, 2);
+	writeLE(bytes, 0, 2);
+	writeLE(bytes, (uint32_t)outputScale, 4);
+	for (int16_t value : ftBias)
+		writeLE(bytes, (uint16_t)value, 2);
+	for (int16_t value : ftWeights)
+		writeLE(bytes, (uint16_t)value, 2);
+	for (int32_t value : l1Bias)
+		writeLE(bytes, (uint32_t)value, 4);
+	for (int8_t value : l1Weights)
+		bytes.push_back((uint8_t)value);
+	writeLE(bytes, (uint32_t)outBias, 4);
+	for (int8_t value : outWeights)
+		bytes.push_back((uint8_t)value);
+
+	std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+	if (!file.is_open() || !file.write((const char *)bytes.data(), bytes.size()))
+	{
+		std::cerr << "Warning: Could not write network file " << filename << std::endl;
+		return false;
+	}
+	return true;
+}
+
+// ===============================================
+// ACCUMULATOR
+// ===============================================
+// Plain loops over 64 int16: the compiler vectorises them with the
+// baseline SSE2 already. Sums wrap like int16, so an incremental update
+// always lands on the same values as a refresh.
+
+int NnueNetwork::stoneFeature(int view, int piece, int cell)
+{
+	return (piece - 1 == view ? 0 : CELLS) + cell;
+}
+
+int NnueNetwork::captureFeature(int view, int player, int count)
+{
+	return CAPTURE_FEATURES + (player - 1 == view ? 0 : CAPTURE_STATES) + count;
+}
+
+void NnueNetwork::addFeature(NnueAccumulator &accumulator, int view, int feature) const
+{
+	int16_t *values = accumulator.values[view];
+	const int16_t *column = &ftWeights[(size_t)feature * HIDDEN];
+	for (int i = 0; i < HIDDEN; i++)
+		values[i] = (int16_t)(values[i] + column[i]);
+}
+
+void NnueNetwork::subFeature(NnueAccumulator &accumulator, int view, int feature) const
+{
+	int16_t *values = accumulator.values[view];
+	const int16_t *column = &ftWeights[(size_t)feature * HIDDEN];
+	for (int i = 0; i < HIDDEN; i++)
+		values[i] = (int16_t)(values[i] - column[i]);
+}
+
+void NnueNetwork::refresh(const GameState &state, NnueAccumulator &accumulator) const
+{
+	for (int view = 0; view < 2; view++)
+	{
+		std::copy(ftBias.begin(), ftBias.end(), accumulator.values[view]);
+		for (int cell = 0; cell < CELLS; cell++)
+		{
+			int piece = state.board[cell / GameState::BOARD_SIZE][cell % GameState::BOARD_SIZE];
+			if (piece != GameState::EMPTY)
+				addFeature(accumulator, view, stoneFeature(view, piece, cell));
+		}
+		for (int player = GameState::PLAYER1; player <= GameState::PLAYER2; player++)
+			addFeature(accumulator, view, captureFeature(view, player, state.captures[player - 1]));
+	}
+	accumulator.key = state.zobristHash;
+	accumulator.weightsId = weightsId;
+}
+
+void NnueNetwork::update(NnueAccumulator &accumulator, const Move &move, int player,
+						 const std::vector<Move> &capturedPieces, int oldCaptures, int newCaptures) const
+{
+	int opponent = player == GameState::PLAYER1 ? GameState::PLAYER2 : GameState::PLAYER1;
+	for (int view = 0; view < 2; view++)
+	{
+		addFeature(accumulator, view, stoneFeature(view, player, move.x * GameState::BOARD_SIZE + move.y));
+		for (const Move &captured : capturedPieces)
+			subFeature(accumulator, view, stoneFeature(view, opponent, captured.x * GameState::BOARD_SIZE + captured.y));
+		if (newCaptures != oldCaptures)
+		{
+			subFeature(accumulator, view, captureFeature(view, player, oldCaptures));
+			addFeature(accumulator, view, captureFeature(view, player, newCaptures));
+		}
+	}
+}
+
+// ===============================================
+// FORWARD PASS
+// ===============================================
+
+int NnueNetwork::evaluate(const GameState &state) const
+{
+	if (state.nnue.weightsId != weightsId || state.nnue.key != state.zobristHash)
+		refresh(state, state.nnue);
+
+	int us = state.currentPlayer - 1;
+	alignas(32) uint8_t input[L1_INPUTS];
+	for (int i = 0; i < HIDDEN; i++)
+	{
+		input[i] = (uint8_t)std::max(0, std::min(127, (int)state.nnue.values[us][i]));
+		input[HIDDEN + i] = (uint8_t)std::max(0, std::min(127, (int)state.nnue.values[1 - us][i]));
+	}
+
+	int32_t hidden[L1];
+	affineKernel(kernel)(input, l1Weights.data(), l1Bias.data(), hidden);
+
+	int64_t output = outBias;
+	for (int j = 0; j < L1; j++)
+		output += std::max(0, std::min(127, hidden[j] >> L1_SHIFT)) * outWeights[j];
+	output = output * outputScale / OUTPUT_DIVISOR;
+	return (int)std::max<int64_t>(-MAX_SCORE, std::min<int64_t>(MAX_SCORE, output));
+}
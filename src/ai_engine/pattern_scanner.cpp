@@ -0,0 +1,343 @@
+// ===============================================
+// AI Engine - Pattern Scanner Module
+// ===============================================
+// Handles: Bitwise run classification on the board's line bitsets,
+//          scalar per run or SIMD across lines
+// Dependencies: Evaluator (PatternCounts), game types
+// ===============================================
+// Mirrors analyzeLine + countAllPatternsScan: any change to how a run is
+// measured or classified there must be made in both countLine and
+// classifyLines here (the Pattern Scanner tests compare all three).
+
+#include "../../include/ai/pattern_scanner.hpp"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SCANNER_X86 1
+#endif
+
+// ===============================================
+// RUN CLASSIFICATION
+// ===============================================
+
+/**
+ * Counts the runs of `own` stones on one line, as countAllPatternsScan
+ * does for each line start. Bit i is the i-th cell in the line's
+ * direction; `empty` holds empty cells only, so any bit in neither mask
+ * (opponent stone, past the end of the line) blocks.
+ */
+static void countLine(uint32_t own, uint32_t empty, Evaluator::PatternCounts &counts)
+{
+	uint32_t blocked = ~(own | empty);
+	uint32_t starts = own & ~(own << 1);
+	while (starts)
+	{
+		int k = __builtin_ctz(starts);
+		starts &= starts - 1;
+
+		// analyzeLine looks at six cells from the start
+		uint32_t windowOwn = (own >> k) & 63;
+		int consecutive = __builtin_ctz(~windowOwn);
+		if (consecutive >= 5)
+			continue; // A five: decided before the counts are used
+		uint32_t window = (1u << __builtin_ctz(((blocked >> k) & 63) | 64)) - 1;
+		uint32_t pieces = windowOwn & window;
+		int totalPieces = __builtin_popcount(pieces);
+		int span = 32 - __builtin_clz(pieces);
+		bool hasGaps = ((empty >> k) & window) != 0 && totalPieces > consecutive;
+
+		int front = k + span;
+		int freeEnds = (k > 0 ? (empty >> (k - 1)) & 1 : 0) + ((empty >> front) & 1);
+
+		// Own or empty cells reachable around the span (maxReachable)
+		uint32_t blockedBehind = blocked & ((1u << k) - 1);
+		int behind = blockedBehind ? k - 1 - (31 - __builtin_clz(blockedBehind)) : k;
+		int ahead = __builtin_ctz(blocked >> front);
+		if (span + behind + ahead < 5)
+			continue;
+
+		if (totalPieces >= 4 && (consecutive == 4 || (totalPieces == 4 && hasGaps)))
+		{
+			if (freeEnds == 2) counts.fourOpen++;
+			else if (freeEnds == 1) counts.fourHalf++;
+		}
+		if (totalPieces == 3 && (consecutive == 3 || hasGaps))
+		{
+			if (freeEnds == 2) counts.threeOpen++;
+			else if (freeEnds == 1) counts.threeHalf++;
+		}
+		if (totalPieces == 2 && freeEnds == 2)
+			counts.twoOpen++;
+	}
+}
+
+// ===============================================
+// LINE-PARALLEL CLASSIFICATION
+// ===============================================
+// The same rules as countLine, rewritten without the loop over starts:
+// every expression below holds at each bit k at once and is only read
+// where k is a run start. Bits past a line are in neither mask, as for
+// countLine. Each step is a shift or a logic op on whole words, so W can
+// be one line (uint32_t) or several lines in the lanes of a GCC vector.
+
+typedef uint32_t Lines4 __attribute__((vector_size(16)));
+typedef uint32_t Lines8 __attribute__((vector_size(32)));
+
+enum ShapeMask
+{
+	FOUR_OPEN,
+	FOUR_HALF,
+	THREE_OPEN,
+	THREE_HALF,
+	TWO_OPEN,
+	SHAPE_MASKS
+};
+
+// Sum and carry of three one-bit masks
+template <typename W>
+static inline __attribute__((always_inline)) void addBits(const W &a, const W &b, const W &c, W &sum, W &carry)
+{
+	W ab = a ^ b;
+	sum = ab ^ c;
+	carry = (a & b) | (ab & c);
+}
+
+/**
+ * Bit k of shapes[s] is set when a run of `own` starting at k counts as
+ * shape s: the starts countLine would count, one per bit
+ */
+template <typename W>
+static inline __attribute__((always_inline)) void classifyLines(const W &own, const W &empty, W shapes[SHAPE_MASKS])
+{
+	W open = own | empty;
+
+	// Pieces of analyzeLine's six-cell window: piece j counts while no
+	// blocked cell lies between it and the start
+	W piece[6];
+	W clear = open >> 1;
+	piece[0] = own;
+	piece[1] = own >> 1;
+	piece[2] = (own >> 2) & clear;
+	clear &= open >> 2;
+	piece[3] = (own >> 3) & clear;
+	clear &= open >> 3;
+	piece[4] = (own >> 4) & clear;
+	clear &= open >> 4;
+	piece[5] = (own >> 5) & clear;
+
+	// totalPieces as three bit planes
+	W sumLow, carryLow, sumHigh, carryHigh, pieces1, pieces2;
+	addBits(piece[0], piece[1], piece[2], sumLow, carryLow);
+	addBits(piece[3], piece[4], piece[5], sumHigh, carryHigh);
+	W pieces0 = sumLow ^ sumHigh;
+	addBits(carryLow, carryHigh, sumLow & sumHigh, pieces1, pieces2);
+	W twoPieces = ~pieces2 & pieces1 & ~pieces0;
+	W threePieces = ~pieces2 & pieces1 & pieces0;
+	W fourPieces = pieces2 & ~pieces1 & ~pieces0;
+	W morePieces = pieces2 & (pieces1 | pieces0);
+
+	// Free ends: the cell before the start and the one after the last piece
+	W frontFree = piece[5] & (empty >> 6);
+	W later = piece[5];
+	for (int j = 4; j >= 0; j--)
+	{
+		frontFree |= piece[j] & ~later & (empty >> (j + 1));
+		later |= piece[j];
+	}
+	W backFree = empty << 1;
+	W bothFree = backFree & frontFree;
+	W oneFree = backFree ^ frontFree;
+
+	// Reach: the start lies in an own-or-empty stretch of five or more
+	W stretch = clear & open;
+	W reach = stretch | (stretch << 1) | (stretch << 2) | (stretch << 3) | (stretch << 4);
+
+	// Fives are decided before the counts are used. A gap within the
+	// window is implied by more pieces than consecutive stones, so four
+	// pieces always count and five or six only behind four in a row.
+	W four = own & (own >> 1) & (own >> 2) & (own >> 3);
+	W five = four & (own >> 4);
+	W starts = own & ~(own << 1) & ~five & reach;
+	W fours = starts & (fourPieces | (morePieces & four));
+	W threes = starts & threePieces;
+
+	shapes[FOUR_OPEN] = fours & bothFree;
+	shapes[FOUR_HALF] = fours & oneFree;
+	shapes[THREE_OPEN] = threes & bothFree;
+	shapes[THREE_HALF] = threes & oneFree;
+	shapes[TWO_OPEN] = starts & twoPieces & bothFree;
+}
+
+// Line words of a board, padded with empty lines to whole vectors
+static const int PADDED_LINES = (BoardLines::COUNT + 7) / 8 * 8;
+
+struct LineWords
+{
+	alignas(32) uint32_t stones[2][PADDED_LINES]; // PLAYER1, PLAYER2
+	alignas(32) uint32_t empty[PADDED_LINES];
+};
+
+static void addShapes(const uint32_t shapes[SHAPE_MASKS], Evaluator::PatternCounts &counts)
+{
+	counts.fourOpen += __builtin_popcount(shapes[FOUR_OPEN]);
+	counts.fourHalf += __builtin_popcount(shapes[FOUR_HALF]);
+	counts.threeOpen += __builtin_popcount(shapes[THREE_OPEN]);
+	counts.threeHalf += __builtin_popcount(shapes[THREE_HALF]);
+	counts.twoOpen += __builtin_popcount(shapes[TWO_OPEN]);
+}
+
+// Classifies W-wide groups of lines, then counts each lane's starts
+template <typename W>
+static inline __attribute__((always_inline)) void countLinesParallel(const LineWords &words,
+																		Evaluator::PatternCounts counts[2])
+{
+	const int lanes = sizeof(W) / sizeof(uint32_t);
+	for (int line = 0; line < PADDED_LINES; line += lanes)
+	{
+		W empty;
+		std::memcpy(&empty, words.empty + line, sizeof(W));
+		for (int player = 0; player < 2; player++)
+		{
+			// Groups without a stone of the player: nothing starts there
+			uint32_t stones = 0;
+			for (int lane = 0; lane < lanes; lane++)
+				stones |= words.stones[player][line + lane];
+			if (!stones)
+				continue;
+
+			W own, shapes[SHAPE_MASKS];
+			std::memcpy(&own, words.stones[player] + line, sizeof(W));
+			classifyLines(own, empty, shapes);
+
+			W any = shapes[FOUR_OPEN] | shapes[FOUR_HALF] | shapes[THREE_OPEN] | shapes[THREE_HALF] |
+					shapes[TWO_OPEN];
+			for (int lane = 0; lane < lanes; lane++)
+			{
+				if (!any[lane])
+					continue;
+				uint32_t laneShapes[SHAPE_MASKS];
+				for (int s = 0; s < SHAPE_MASKS; s++)
+					laneShapes[s] = shapes[s][lane];
+				addShapes(laneShapes, counts[player]);
+			}
+		}
+	}
+}
+
+// ===============================================
+// KERNELS
+// ===============================================
+
+typedef void (*LineKernel)(const LineWords &words, Evaluator::PatternCounts counts[2]);
+
+static void countScalar(const LineWords &words, Evaluator::PatternCounts counts[2])
+{
+	for (int line = 0; line < BoardLines::COUNT; line++)
+	{
+		for (int player = 0; player < 2; player++)
+			if (words.stones[player][line])
+				countLine(words.stones[player][line], words.empty[line], counts[player]);
+	}
+}
+
+#ifdef SCANNER_X86
+__attribute__((target("sse2"))) static void countSse2(const LineWords &words, Evaluator::PatternCounts counts[2])
+{
+	countLinesParallel<Lines4>(words, counts);
+}
+
+__attribute__((target("avx2"))) static void countAvx2(const LineWords &words, Evaluator::PatternCounts counts[2])
+{
+	countLinesParallel<Lines8>(words, counts);
+}
+#endif
+
+static LineKernel lineKernel(PatternScanner::Kernel kernel)
+{
+#ifdef SCANNER_X86
+	if (kernel == PatternScanner::AVX2)
+		return countAvx2;
+	if (kernel == PatternScanner::SSE2)
+		return countSse2;
+#endif
+	(void)kernel;
+	return countScalar;
+}
+
+static PatternScanner::Kernel bestKernel()
+{
+	if (PatternScanner::kernelSupported(PatternScanner::AVX2))
+		return PatternScanner::AVX2;
+	if (PatternScanner::kernelSupported(PatternScanner::SSE2))
+		return PatternScanner::SSE2;
+	return PatternScanner::SCALAR;
+}
+
+static PatternScanner::Kernel g_kernel = bestKernel();
+static LineKernel g_lineKernel = lineKernel(g_kernel);
+
+bool PatternScanner::kernelSupported(Kernel kernel)
+{
+	if (kernel == SCALAR)
+		return true;
+#ifdef SCANNER_X86
+	__builtin_cpu_init(); // Also called before main, for g_kernel
+	if (kernel == SSE2)
+		return __builtin_cpu_supports("sse2");
+	if (kernel == AVX2)
+		return __builtin_cpu_supports("avx2");
+#endif
+	return false;
+}
+
+const char *PatternScanner::kernelName(Kernel kernel)
+{
+	switch (kernel)
+	{
+	case AVX2:
+		return "AVX2";
+	case SSE2:
+		return "SSE2";
+	default:
+		return "scalar";
+	}
+}
+
+PatternScanner::Kernel PatternScanner::getKernel()
+{
+	return g_kernel;
+}
+
+bool PatternScanner::setKernel(Kernel kernel)
+{
+	if (!kernelSupported(kernel))
+		return false;
+	g_kernel = kernel;
+	g_lineKernel = lineKernel(kernel);
+	return true;
+}
+
+// ===============================================
+// BOARD SCAN
+// ===============================================
+
+void PatternScanner::count(const GameState &state, Evaluator::PatternCounts &player1,
+						   Evaluator::PatternCounts &player2)
+{
+	// Lines read along their direction, so that a run starts at its lowest
+	// bit as it does for isLineStart / analyzeLine. Diagonals shorter than
+	// five never pass the reach check.
+	LineWords words;
+	for (int line = 0; line < PADDED_LINES; line++)
+	{
+		bool real = line < BoardLines::COUNT;
+		words.stones[0][line] = real ? state.board.stones(line, GameState::PLAYER1) : 0;
+		words.stones[1][line] = real ? state.board.stones(line, GameState::PLAYER2) : 0;
+		words.empty[line] = real ? state.board.empty(line) : 0;
+	}
+
+	Evaluator::PatternCounts counts[2] = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 0}};
+	g_lineKernel(words, counts);
+	player1 = counts[0];
+	player2 = counts[1];
+}
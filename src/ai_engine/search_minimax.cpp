@@ -6,6 +6,8 @@
 
 #include "../../include/ai/transposition_search.hpp"
 #include "../../include/debug/debug_analyzer.hpp"
+#include "../../include/utils/profiler.hpp"
+#include "../../include/utils/trace_recorder.hpp"
 #include <algorithm>
 #include <limits>
 #include <iostream>
@@ -13,16 +15,78 @@
 #include <chrono>
 #include <iomanip>
 
+/**
+ * Trace event arguments for a move and its score
+ */
+static std::string traceMoveArgs(const Move &move, int score)
+{
+	std::string args = "\"move\":\"";
+	args += char('A' + move.y);
+	args += std::to_string(move.x + 1) + "\",\"score\":" + std::to_string(score);
+	return args;
+}
+
+/**
+ * Telemetry for a beta cutoff: was it the first move, a killer,
+ * or a move the history table already liked?
+ */
+void TranspositionSearch::recordCutoff(const Move &move, int depth, int moveIndex)
+{
+	iterationStats.betaCutoffs++;
+	if (moveIndex == 0)
+		iterationStats.firstMoveCutoffs++;
+	if (historyTable[move.x][move.y] > 0)
+		iterationStats.historyHits++;
+	if (depth < MAX_SEARCH_DEPTH &&
+		((killerMoves[depth][0].x == move.x && killerMoves[depth][0].y == move.y) ||
+		 (killerMoves[depth][1].x == move.x && killerMoves[depth][1].y == move.y)))
+		iterationStats.killerHits++;
+}
+
+/**
+ * Profiling builds only: print the flat profile of this search and reset
+ * the calling thread's accumulators
+ */
+void TranspositionSearch::reportProfile(uint64_t searchStartCycles)
+{
+	if constexpr (Profiler::ENABLED)
+	{
+		Profiler::record(Profiler::SEARCH, Profiler::readCycles() - searchStartCycles);
+		Profiler::report(std::cout);
+		Profiler::reset();
+	}
+	else
+	{
+		(void)searchStartCycles;
+	}
+}
+
 int TranspositionSearch::minimax(GameState &state, int depth, int alpha, int beta,
 								 bool maximizing, int originalMaxDepth, Move *bestMove)
 {
+	// Out of time: unwind without touching the table, the caller
+	// discards this iteration
+	if (searchAborted)
+		return 0;
+
 	nodesEvaluated++;
+	iterationStats.nodes++;
 
-	// Log stats every 10000 nodes
-	if (nodesEvaluated % 10000 == 0)
+	if (timeLimitMs > 0 && originalMaxDepth > 1 && (nodesEvaluated % TIME_CHECK_NODES) == 0 &&
+		std::chrono::steady_clock::now() >= searchDeadline)
 	{
-		DEBUG_LOG_STATS("Nodes evaluated: " + std::to_string(nodesEvaluated) +
-						", Cache hits: " + std::to_string(cacheHits));
+		searchAborted = true;
+		return 0;
+	}
+
+	// Log stats every 10000 nodes (debug builds only)
+	if constexpr (DebugConfig::SEARCH_INSTRUMENTATION)
+	{
+		if (nodesEvaluated % 10000 == 0)
+		{
+			DEBUG_LOG_STATS("Nodes evaluated: " + std::to_string(nodesEvaluated) +
+							", Cache hits: " + std::to_string(cacheHits));
+		}
 	}
 
 	// CRITICAL: Detect 5-in-a-row BEFORE transposition lookup.
@@ -41,9 +105,11 @@ int TranspositionSearch::minimax(GameState &state, int depth, int alpha, int bet
 	// Check transposition table first
 	uint64_t zobristKey = state.getZobristHash();
 	CacheEntry entry;
+	iterationStats.ttProbes++;
 	if (lookupTransposition(zobristKey, entry))
 	{
 		cacheHits++;
+		iterationStats.ttHits++;
 
 		if (entry.depth >= depth)
 		{
@@ -53,14 +119,17 @@ int TranspositionSearch::minimax(GameState &state, int depth, int alpha, int bet
 				{
 					*bestMove = entry.bestMove;
 				}
+				iterationStats.ttCutoffsExact++;
 				return entry.score;
 			}
 			else if (entry.type == CacheEntry::LOWER_BOUND && entry.score >= beta)
 			{
+				iterationStats.ttCutoffsLower++;
 				return beta;
 			}
 			else if (entry.type == CacheEntry::UPPER_BOUND && entry.score <= alpha)
 			{
+				iterationStats.ttCutoffsUpper++;
 				return alpha;
 			}
 		}
@@ -76,7 +145,7 @@ int TranspositionSearch::minimax(GameState &state, int depth, int alpha, int bet
 	if (depth == 0 || RuleEngine::checkWin(state, GameState::PLAYER1) ||
 		RuleEngine::checkWin(state, GameState::PLAYER2))
 	{
-
+		iterationStats.leafEvals++;
 		int score = Evaluator::evaluate(state, originalMaxDepth, originalMaxDepth - depth);
 		storeTransposition(zobristKey, score, depth, Move(), CacheEntry::EXACT);
 		return score;
@@ -87,6 +156,7 @@ int TranspositionSearch::minimax(GameState &state, int depth, int alpha, int bet
 
 	if (moves.empty())
 	{
+		iterationStats.leafEvals++;
 		int score = Evaluator::evaluate(state, originalMaxDepth, originalMaxDepth - depth);
 		storeTransposition(zobristKey, score, depth, Move(), CacheEntry::EXACT);
 		return score;
@@ -131,13 +201,19 @@ int TranspositionSearch::minimax(GameState &state, int depth, int alpha, int bet
 				continue;
 
 			// Enable debug capture before recursive evaluation
-			if (g_debugAnalyzer && depth == originalMaxDepth)
+			if constexpr (DebugConfig::SEARCH_INSTRUMENTATION)
 			{
-				g_evalDebug.reset();
-				g_evalDebug.active = true;
-				g_evalDebug.currentMove = move;
+				if (g_debugAnalyzer && depth == originalMaxDepth)
+				{
+					g_evalDebug.reset();
+					g_evalDebug.active = true;
+					g_evalDebug.currentMove = move;
+				}
 			}
 
+			// Trace span for each root move's subtree (no-op unless tracing)
+			TraceScope rootMoveSpan(depth == originalMaxDepth ? "root move" : nullptr, "search");
+
 			// Late Move Reduction: search late moves at reduced depth first
 			int eval;
 			bool needsFullSearch = true;
@@ -147,34 +223,45 @@ int TranspositionSearch::minimax(GameState &state, int depth, int alpha, int bet
 				eval = minimax(newState, depth - 2, alpha, beta, false, originalMaxDepth, nullptr);
 				// Only re-search at full depth if it improves alpha
 				needsFullSearch = (eval > alpha);
+				iterationStats.lmrReductions++;
+				if (needsFullSearch)
+					iterationStats.lmrResearches++;
 			}
 			if (needsFullSearch)
 			{
 				eval = minimax(newState, depth - 1, alpha, beta, false, originalMaxDepth, nullptr);
 			}
+			if (searchAborted)
+				return 0;
 
 			// Capture debug data after evaluation
-			if (g_debugAnalyzer && depth == originalMaxDepth && g_evalDebug.active)
+			if constexpr (DebugConfig::SEARCH_INSTRUMENTATION)
 			{
-				std::ostringstream heuristicInfo;
-
-				// Show board state after the move
-				heuristicInfo << "\n=== EVALUATING MOVE " << g_debugAnalyzer->formatMove(move) << " ===\n";
-				heuristicInfo << g_debugAnalyzer->formatBoard(newState);
-
-				heuristicInfo << "Score:" << eval;
-				heuristicInfo << " [REAL_DATA: 3Open:" << g_evalDebug.aiThreeOpen
-							  << "(" << g_evalDebug.aiThreeOpen * Evaluator::THREE_OPEN << ")";
-				heuristicInfo << " 4Half:" << g_evalDebug.aiFourHalf
-							  << "(" << g_evalDebug.aiFourHalf * Evaluator::FOUR_HALF << ")";
-				heuristicInfo << " 4Open:" << g_evalDebug.aiFourOpen
-							  << "(" << g_evalDebug.aiFourOpen * Evaluator::FOUR_OPEN << ")";
-				heuristicInfo << " 2Open:" << g_evalDebug.aiTwoOpen
-							  << "(" << g_evalDebug.aiTwoOpen * Evaluator::TWO_OPEN << ")]\n";
-				g_debugAnalyzer->logToFile(heuristicInfo.str());
-				g_evalDebug.active = false;
+				if (g_debugAnalyzer && depth == originalMaxDepth && g_evalDebug.active)
+				{
+					std::ostringstream heuristicInfo;
+
+					// Show board state after the move
+					heuristicInfo << "\n=== EVALUATING MOVE " << g_debugAnalyzer->formatMove(move) << " ===\n";
+					heuristicInfo << g_debugAnalyzer->formatBoard(newState);
+
+					heuristicInfo << "Score:" << eval;
+					heuristicInfo << " [REAL_DATA: 3Open:" << g_evalDebug.aiThreeOpen
+								  << "(" << g_evalDebug.aiThreeOpen * Evaluator::THREE_OPEN << ")";
+					heuristicInfo << " 4Half:" << g_evalDebug.aiFourHalf
+								  << "(" << g_evalDebug.aiFourHalf * Evaluator::FOUR_HALF << ")";
+					heuristicInfo << " 4Open:" << g_evalDebug.aiFourOpen
+								  << "(" << g_evalDebug.aiFourOpen * Evaluator::FOUR_OPEN << ")";
+					heuristicInfo << " 2Open:" << g_evalDebug.aiTwoOpen
+								  << "(" << g_evalDebug.aiTwoOpen * Evaluator::TWO_OPEN << ")]\n";
+					g_debugAnalyzer->logToFile(heuristicInfo.str());
+					g_evalDebug.active = false;
+				}
 			}
 
+			if (rootMoveSpan.isActive())
+				rootMoveSpan.setArgs(traceMoveArgs(move, eval));
+
 			// Update best move from recursive evaluation
 			if (eval > maxEval)
 			{
@@ -188,6 +275,8 @@ int TranspositionSearch::minimax(GameState &state, int depth, int alpha, int bet
 			// Alpha-beta pruning
 			if (beta <= alpha)
 			{
+				recordCutoff(move, depth, moveIndex);
+
 				// History heuristic: reward move that caused cutoff
 				if (currentBestMove.isValid())
 				{
@@ -245,13 +334,19 @@ int TranspositionSearch::minimax(GameState &state, int depth, int alpha, int bet
 				continue;
 
 			// Enable debug capture before recursive evaluation
-			if (g_debugAnalyzer && depth == originalMaxDepth)
+			if constexpr (DebugConfig::SEARCH_INSTRUMENTATION)
 			{
-				g_evalDebug.reset();
-				g_evalDebug.active = true;
-				g_evalDebug.currentMove = move;
+				if (g_debugAnalyzer && depth == originalMaxDepth)
+				{
+					g_evalDebug.reset();
+					g_evalDebug.active = true;
+					g_evalDebug.currentMove = move;
+				}
 			}
 
+			// Trace span for each root move's subtree (no-op unless tracing)
+			TraceScope rootMoveSpan(depth == originalMaxDepth ? "root move" : nullptr, "search");
+
 			// Late Move Reduction: search late moves at reduced depth first
 			int eval;
 			bool needsFullSearch = true;
@@ -259,34 +354,45 @@ int TranspositionSearch::minimax(GameState &state, int depth, int alpha, int bet
 			{
 				eval = minimax(newState, depth - 2, alpha, beta, true, originalMaxDepth, nullptr);
 				needsFullSearch = (eval < beta);
+				iterationStats.lmrReductions++;
+				if (needsFullSearch)
+					iterationStats.lmrResearches++;
 			}
 			if (needsFullSearch)
 			{
 				eval = minimax(newState, depth - 1, alpha, beta, true, originalMaxDepth, nullptr);
 			}
+			if (searchAborted)
+				return 0;
 
 			// Capture debug data after evaluation
-			if (g_debugAnalyzer && depth == originalMaxDepth && g_evalDebug.active)
+			if constexpr (DebugConfig::SEARCH_INSTRUMENTATION)
 			{
-				std::ostringstream heuristicInfo;
-
-				// Show board state after the move
-				heuristicInfo << "\n=== EVALUATING MOVE " << g_debugAnalyzer->formatMove(move) << " ===\n";
-				heuristicInfo << g_debugAnalyzer->formatBoard(newState);
-
-				heuristicInfo << "Score:" << eval;
-				heuristicInfo << " [REAL_DATA: 3Open:" << g_evalDebug.humanThreeOpen
-							  << "(" << g_evalDebug.humanThreeOpen * Evaluator::THREE_OPEN << ")";
-				heuristicInfo << " 4Half:" << g_evalDebug.humanFourHalf
-							  << "(" << g_evalDebug.humanFourHalf * Evaluator::FOUR_HALF << ")";
-				heuristicInfo << " 4Open:" << g_evalDebug.humanFourOpen
-							  << "(" << g_evalDebug.humanFourOpen * Evaluator::FOUR_OPEN << ")";
-				heuristicInfo << " 2Open:" << g_evalDebug.humanTwoOpen
-							  << "(" << g_evalDebug.humanTwoOpen * Evaluator::TWO_OPEN << ")]\n";
-				g_debugAnalyzer->logToFile(heuristicInfo.str());
-				g_evalDebug.active = false;
+				if (g_debugAnalyzer && depth == originalMaxDepth && g_evalDebug.active)
+				{
+					std::ostringstream heuristicInfo;
+
+					// Show board state after the move
+					heuristicInfo << "\n=== EVALUATING MOVE " << g_debugAnalyzer->formatMove(move) << " ===\n";
+					heuristicInfo << g_debugAnalyzer->formatBoard(newState);
+
+					heuristicInfo << "Score:" << eval;
+					heuristicInfo << " [REAL_DATA: 3Open:" << g_evalDebug.humanThreeOpen
+								  << "(" << g_evalDebug.humanThreeOpen * Evaluator::THREE_OPEN << ")";
+					heuristicInfo << " 4Half:" << g_evalDebug.humanFourHalf
+								  << "(" << g_evalDebug.humanFourHalf * Evaluator::FOUR_HALF << ")";
+					heuristicInfo << " 4Open:" << g_evalDebug.humanFourOpen
+								  << "(" << g_evalDebug.humanFourOpen * Evaluator::FOUR_OPEN << ")";
+					heuristicInfo << " 2Open:" << g_evalDebug.humanTwoOpen
+								  << "(" << g_evalDebug.humanTwoOpen * Evaluator::TWO_OPEN << ")]\n";
+					g_debugAnalyzer->logToFile(heuristicInfo.str());
+					g_evalDebug.active = false;
+				}
 			}
 
+			if (rootMoveSpan.isActive())
+				rootMoveSpan.setArgs(traceMoveArgs(move, eval));
+
 			// Update best move from recursive evaluation
 			if (eval < minEval)
 			{
@@ -300,6 +406,8 @@ int TranspositionSearch::minimax(GameState &state, int depth, int alpha, int bet
 			// Alpha-beta pruning
 			if (beta <= alpha)
 			{
+				recordCutoff(move, depth, moveIndex);
+
 				// History heuristic: reward move that caused cutoff
 				if (currentBestMove.isValid())
 				{
@@ -348,12 +456,18 @@ int TranspositionSearch::minimax(GameState &state, int depth, int alpha, int bet
 TranspositionSearch::SearchResult TranspositionSearch::findBestMoveIterative(
     const GameState &state, int maxDepth)
 {
+    TRACE_SCOPE("findBestMoveIterative", "search");
     auto startTime = std::chrono::high_resolution_clock::now();
+    uint64_t profileStart = Profiler::ENABLED ? Profiler::readCycles() : 0;
     SearchResult bestResult;
 
     nodesEvaluated = 0;
     cacheHits = 0;
     currentGeneration++;
+    searchCount++;
+    lastSearchStats.clear();
+    searchAborted = false;
+    searchDeadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeLimitMs);
 
     if (g_debugAnalyzer && g_debugAnalyzer->isEnabled()) {
         std::cout << "Iterative search up to depth " << maxDepth << std::endl;
@@ -395,7 +509,8 @@ TranspositionSearch::SearchResult TranspositionSearch::findBestMoveIterative(
                 DEBUG_CHOSEN_MOVE(move, winResult.score);
                 DEBUG_SNAPSHOT(state, elapsedTime, allCandidates.size());
             }
-            
+
+            reportProfile(profileStart);
             return winResult;
         }
     }
@@ -411,6 +526,12 @@ TranspositionSearch::SearchResult TranspositionSearch::findBestMoveIterative(
     {
         auto iterationStart = std::chrono::high_resolution_clock::now();
 
+        // Each iteration usually costs more than all the previous ones
+        // together: past half the budget the next one would not finish
+        if (timeLimitMs > 0 && depth > 1 &&
+            std::chrono::duration_cast<std::chrono::milliseconds>(iterationStart - startTime).count() * 2 >= timeLimitMs)
+            break;
+
         // Age history table: halve values between iterations so that
         // recent cutoff information dominates over stale data
         for (int i = 0; i < GameState::BOARD_SIZE; i++)
@@ -421,6 +542,10 @@ TranspositionSearch::SearchResult TranspositionSearch::findBestMoveIterative(
             previousBestMove = bestResult.bestMove;
         }
 
+        TraceScope iterationSpan("iteration", "search");
+        iterationStats.reset();
+        iterationStats.depth = depth;
+
         Move bestMove;
         GameState mutableState = state; // Mutable copy for minimax
         int score = minimax(mutableState, depth,
@@ -429,6 +554,10 @@ TranspositionSearch::SearchResult TranspositionSearch::findBestMoveIterative(
                             state.currentPlayer == GameState::PLAYER2,
                             depth, &bestMove);
 
+        // Keep the last completed iteration
+        if (searchAborted)
+            break;
+
         auto iterationEnd = std::chrono::high_resolution_clock::now();
         auto iterationTime = std::chrono::duration_cast<std::chrono::milliseconds>(
             iterationEnd - iterationStart);
@@ -440,6 +569,20 @@ TranspositionSearch::SearchResult TranspositionSearch::findBestMoveIterative(
         bestResult.cacheHitRate = nodesEvaluated > 0 ?
             (float)cacheHits / nodesEvaluated : 0.0f;
 
+        iterationStats.bestMove = bestMove;
+        iterationStats.score = score;
+        iterationStats.wallTimeMs = std::chrono::duration<double, std::milli>(
+            iterationEnd - iterationStart).count();
+        iterationStats.nodesPerSecond = iterationStats.wallTimeMs > 0.0 ?
+            iterationStats.nodes * 1000.0 / iterationStats.wallTimeMs : 0.0;
+        lastSearchStats.push_back(iterationStats);
+
+        if (iterationSpan.isActive()) {
+            iterationSpan.setArgs("\"depth\":" + std::to_string(depth) +
+                                  ",\"nodes\":" + std::to_string(iterationStats.nodes) + "," +
+                                  traceMoveArgs(bestMove, score));
+        }
+
         if (g_debugAnalyzer && g_debugAnalyzer->isEnabled()) {
             std::cout << "Depth " << depth
                       << ": " << char('A' + bestMove.y) << (bestMove.x + 1)
@@ -469,10 +612,29 @@ TranspositionSearch::SearchResult TranspositionSearch::findBestMoveIterative(
         std::cout << "Search completed in " << elapsedTime << "ms total" << std::endl;
     }
 
+    if (!statsLogFile.empty() &&
+        !SearchStats::appendJsonLines(statsLogFile, lastSearchStats, searchCount, state.turnCount)) {
+        std::cerr << "Warning: Could not write search stats to " << statsLogFile << std::endl;
+    }
+
     if (g_debugAnalyzer) {
         DEBUG_CHOSEN_MOVE(bestResult.bestMove, bestResult.score);
         DEBUG_SNAPSHOT(state, elapsedTime, nodesEvaluated);
     }
 
+    reportProfile(profileStart);
     return bestResult;
 }
+
+int TranspositionSearch::forPlayerToMove(const GameState &state, int score)
+{
+    return state.currentPlayer == GameState::PLAYER2 ? score : -score;
+}
+
+int TranspositionSearch::scoreForPlayerToMove(const GameState &state, int score) const
+{
+    // The immediate-win shortcut returns exactly WIN for whoever is to move
+    // and completes no iteration
+    bool immediateWin = score == Evaluator::WIN && lastSearchStats.empty();
+    return immediateWin ? score : forPlayerToMove(state, score);
+}
@@ -5,6 +5,8 @@
 // ============================================
 
 #include "../../include/ai/transposition_search.hpp"
+#include "../../include/ai/threat_scanner.hpp"
+#include "../../include/utils/profiler.hpp"
 #include <algorithm>
 #include <cmath>
 
@@ -24,6 +26,8 @@ std::vector<Move> TranspositionSearch::generateOrderedMoves(const GameState &sta
 
 void TranspositionSearch::orderMovesWithPreviousBest(std::vector<Move> &moves, const GameState &state)
 {
+	PROFILE_SCOPE(ORDER_MOVES);
+
 	// If we have the best move from previous iteration, place it first
 	if (previousBestMove.isValid())
 	{
@@ -133,60 +137,38 @@ int TranspositionSearch::quickEvaluateMove(const GameState& state, const Move& m
     }
     
     // ============================================
-    // 4. SIMPLE PATTERNS (O(4) - very cheap)
+    // 4. SHAPES (O(1) - threat map)
     // ============================================
-    // Count consecutive pieces without checking open ends
-    int maxMyLine = 0;
-    int maxOppLine = 0;
+    // Best shape the stone would make, open ends and gaps included; the
+    // opponent's shape on the same cell is what playing there blocks
+    uint8_t myThreats = ThreatScanner::entry(state, currentPlayer, move.x, move.y);
+    uint8_t oppThreats = ThreatScanner::entry(state, opponent, move.x, move.y);
     
-    for (int d = 0; d < MAIN_COUNT; d++) {
-        int dx = MAIN[d][0];
-        int dy = MAIN[d][1];
-        
-        // Contar hacia ambos lados
-        int myCount = 1;  // The piece being placed
-        myCount += countConsecutiveInDirection(state, move.x, move.y, dx, dy, currentPlayer, 4);
-        myCount += countConsecutiveInDirection(state, move.x, move.y, -dx, -dy, currentPlayer, 4);
-        maxMyLine = std::max(maxMyLine, myCount);
-        
-        // Count opponent lines (for blocking evaluation)
-        int oppCount = 0;
-        oppCount += countConsecutiveInDirection(state, move.x, move.y, dx, dy, opponent, 4);
-        oppCount += countConsecutiveInDirection(state, move.x, move.y, -dx, -dy, opponent, 4);
-        maxOppLine = std::max(maxOppLine, oppCount);
+    switch (ThreatMap::shape(myThreats)) {
+        case ThreatMap::FIVE:       score += 100000; break;  // Win
+        case ThreatMap::OPEN_FOUR:  score += 20000;  break;  // Unstoppable without a capture
+        case ThreatMap::FOUR:       score += 6000;   break;  // Forces a reply
+        case ThreatMap::OPEN_THREE: score += 4000;   break;  // Forces a reply or an open four
+        case ThreatMap::THREE:      score += 500;    break;  // Development
+        case ThreatMap::TWO:        score += 100;    break;
+        default: break;
     }
     
-    // Exponential scoring for long lines
-    if (maxMyLine >= 5) score += 100000;      // Win
-    else if (maxMyLine == 4) score += 10000;  // Very dangerous
-    else if (maxMyLine == 3) score += 1000;   // Dangerous
-    else if (maxMyLine == 2) score += 100;    // Development
-    
     // Blocking
-    if (maxOppLine >= 4) score += 8000;       // Critical block
-    else if (maxOppLine == 3) score += 800;   // Important block
+    switch (ThreatMap::shape(oppThreats)) {
+        case ThreatMap::FIVE:       score += 50000; break;   // Critical block
+        case ThreatMap::OPEN_FOUR:  score += 8000;  break;   // Stops an open three
+        case ThreatMap::FOUR:       score += 1500;  break;   // Stops a three
+        case ThreatMap::OPEN_THREE: score += 800;   break;   // Important block
+        default: break;
+    }
     
     // ============================================
-    // 5. QUICK CAPTURE CHECK (O(8) - cheap)
+    // 5. QUICK CAPTURE CHECK (O(1) - threat map)
     // ============================================
     // Only check if a capture exists, without evaluating context
-    for (int d = 0; d < ALL_COUNT; d++) {
-        int dx = ALL[d][0];
-        int dy = ALL[d][1];
-        
-        // Pattern: NEW + OPP + OPP + OWN
-        int x1 = move.x + dx, y1 = move.y + dy;
-        int x2 = move.x + 2*dx, y2 = move.y + 2*dy;
-        int x3 = move.x + 3*dx, y3 = move.y + 3*dy;
-        
-        if (state.isValid(x1, y1) && state.isValid(x2, y2) && state.isValid(x3, y3)) {
-            if (state.getPiece(x1, y1) == opponent &&
-                state.getPiece(x2, y2) == opponent &&
-                state.getPiece(x3, y3) == currentPlayer) {
-                score += 2000;  // Capture available
-                break;  // Stop searching
-            }
-        }
+    if (ThreatMap::captures(myThreats)) {
+        score += 2000;  // Capture available
     }
     
     // ============================================
@@ -202,113 +184,6 @@ int TranspositionSearch::quickEvaluateMove(const GameState& state, const Move& m
 // PATTERN DETECTION HELPERS
 // ============================================
 
-bool TranspositionSearch::wouldCreateFiveInRow(const GameState& state, const Move& move, int player) {
-    // Check 4 main directions
-    for (int d = 0; d < MAIN_COUNT; d++) {
-        int dx = MAIN[d][0], dy = MAIN[d][1];
-        
-        int count = 1; // The piece being placed
-        count += countConsecutiveInDirection(state, move.x, move.y, dx, dy, player, 4);
-        count += countConsecutiveInDirection(state, move.x, move.y, -dx, -dy, player, 4);
-        
-        if (count >= 5) return true;
-    }
-    
-    return false;
-}
-
-bool TranspositionSearch::createsFourInRow(const GameState& state, const Move& move, int player) {
-    for (int d = 0; d < MAIN_COUNT; d++) {
-        int dx = MAIN[d][0], dy = MAIN[d][1];
-        
-        int count = 1;
-        count += countConsecutiveInDirection(state, move.x, move.y, dx, dy, player, 3);
-        count += countConsecutiveInDirection(state, move.x, move.y, -dx, -dy, player, 3);
-        
-        if (count == 4) {
-            // Verify at least one end is open (to be a real threat)
-            int startX = move.x - (count - 1) * dx;
-            int startY = move.y - (count - 1) * dy;
-            int endX = move.x + (count - 1) * dx;
-            int endY = move.y + (count - 1) * dy;
-            
-            bool startFree = state.isValid(startX - dx, startY - dy) && 
-                           state.isEmpty(startX - dx, startY - dy);
-            bool endFree = state.isValid(endX + dx, endY + dy) && 
-                         state.isEmpty(endX + dx, endY + dy);
-            
-            if (startFree || endFree) return true;
-        }
-    }
-    
-    return false;
-}
-
-bool TranspositionSearch::createsThreeInRow(const GameState& state, const Move& move, int player) {
-    for (int d = 0; d < MAIN_COUNT; d++) {
-        int dx = MAIN[d][0], dy = MAIN[d][1];
-        
-        int count = 1;
-        count += countConsecutiveInDirection(state, move.x, move.y, dx, dy, player, 2);
-        count += countConsecutiveInDirection(state, move.x, move.y, -dx, -dy, player, 2);
-        
-        if (count == 3) {
-            // Verify both ends are open (free-three)
-            int forward = countConsecutiveInDirection(state, move.x, move.y, dx, dy, player, 2);
-            int backward = countConsecutiveInDirection(state, move.x, move.y, -dx, -dy, player, 2);
-            
-            int startX = move.x - backward * dx;
-            int startY = move.y - backward * dy;
-            int endX = move.x + forward * dx;
-            int endY = move.y + forward * dy;
-            
-            bool startFree = state.isValid(startX - dx, startY - dy) && 
-                           state.isEmpty(startX - dx, startY - dy);
-            bool endFree = state.isValid(endX + dx, endY + dy) && 
-                         state.isEmpty(endX + dx, endY + dy);
-            
-            if (startFree && endFree) return true;
-        }
-    }
-    
-    return false;
-}
-
-bool TranspositionSearch::hasImmediateCapture(const GameState& state, const Move& move, int player) {
-    int opponent = state.getOpponent(player);
-    
-    // Check capture pattern in 8 directions: NEW + OPP + OPP + OWN
-    for (int d = 0; d < ALL_COUNT; d++) {
-        int dx = ALL[d][0], dy = ALL[d][1];
-        
-        // Forward pattern: NEW + OPP + OPP + OWN
-        if (state.isValid(move.x + dx, move.y + dy) &&
-            state.isValid(move.x + 2*dx, move.y + 2*dy) &&
-            state.isValid(move.x + 3*dx, move.y + 3*dy)) {
-            
-            if (state.getPiece(move.x + dx, move.y + dy) == opponent &&
-                state.getPiece(move.x + 2*dx, move.y + 2*dy) == opponent &&
-                state.getPiece(move.x + 3*dx, move.y + 3*dy) == player) {
-                return true;
-            }
-        }
-        
-        // Backward pattern: OWN + OPP + OPP + NEW
-        if (state.isValid(move.x - dx, move.y - dy) &&
-            state.isValid(move.x - 2*dx, move.y - 2*dy) &&
-            state.isValid(move.x - 3*dx, move.y - 3*dy)) {
-            
-            if (state.getPiece(move.x - dx, move.y - dy) == opponent &&
-                state.getPiece(move.x - 2*dx, move.y - 2*dy) == opponent &&
-                state.getPiece(move.x - 3*dx, move.y - 3*dy) == player) {
-                return true;
-            }
-        }
-    }
-    
-    return false;
-}
-
 bool TranspositionSearch::isNearExistingPieces(const GameState& state, const Move& move) {
     // Check for pieces within radius 2
     for (int dx = -2; dx <= 2; dx++) {
@@ -323,34 +198,6 @@ bool TranspositionSearch::isNearExistingPieces(const GameState& state, const Mov
     return false;
 }
 
-bool TranspositionSearch::blocksOpponentWin(const GameState& state, const Move& move, int opponent) {
-    // Check if this position would create a win for the opponent
-    return wouldCreateFiveInRow(state, move, opponent);
-}
-
-bool TranspositionSearch::blocksOpponentFour(const GameState& state, const Move& move, int opponent) {
-    return createsFourInRow(state, move, opponent);
-}
-
-bool TranspositionSearch::blocksOpponentThree(const GameState& state, const Move& move, int opponent) {
-    return createsThreeInRow(state, move, opponent);
-}
-
-int TranspositionSearch::countConsecutiveInDirection(const GameState& state, int x, int y, 
-                                                   int dx, int dy, int player, int maxCount) {
-    int count = 0;
-    x += dx;
-    y += dy;
-    
-    while (count < maxCount && state.isValid(x, y) && state.getPiece(x, y) == player) {
-        count++;
-        x += dx;
-        y += dy;
-    }
-    
-    return count;
-}
-
 // ============================================
 // THREAT COUNTING HELPERS
 // ============================================
@@ -428,6 +275,7 @@ int TranspositionSearch::countInDirection(const GameState &state, int x, int y,
 
 std::vector<Move> TranspositionSearch::generateCandidatesAdaptiveRadius(const GameState &state)
 {
+    PROFILE_SCOPE(GENERATE_CANDIDATES);
     std::vector<Move> candidates;
     int searchRadius = getSearchRadiusForGamePhase(state.turnCount);
     
@@ -477,6 +325,27 @@ std::vector<Move> TranspositionSearch::generateCandidatesAdaptiveRadius(const Ga
         }
     }
     
+    // Forced replies (threat map): with a five to make, only the fives;
+    // against an opponent's five, only the cells that block it and the
+    // captures, which may break its line or win on pairs
+    int player = state.currentPlayer;
+    int opponent = state.getOpponent(player);
+    std::vector<Move> fives, replies;
+    bool opponentFive = false;
+    for (const Move &move : candidates) {
+        uint8_t mine = ThreatScanner::entry(state, player, move.x, move.y);
+        bool blocksFive = ThreatMap::shape(ThreatScanner::entry(state, opponent, move.x, move.y)) == ThreatMap::FIVE;
+        opponentFive |= blocksFive;
+        if (ThreatMap::shape(mine) == ThreatMap::FIVE)
+            fives.push_back(move);
+        else if (blocksFive || ThreatMap::captures(mine))
+            replies.push_back(move);
+    }
+    if (!fives.empty())
+        candidates.swap(fives);
+    else if (opponentFive)
+        candidates.swap(replies);
+    
     // Sort with move ordering
     orderMovesWithPreviousBest(candidates, state);
     
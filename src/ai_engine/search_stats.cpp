@@ -0,0 +1,66 @@
+// ===============================================
+// AI Engine - Search Statistics Module
+// ===============================================
+// Handles: per-iteration search counters, JSON lines export
+// Dependencies: SearchStats
+// ===============================================
+
+#include "../../include/ai/search_stats.hpp"
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+void SearchStats::reset()
+{
+	depth = 0;
+	bestMove = Move();
+	score = 0;
+	nodes = leafEvals = 0;
+	ttProbes = ttHits = 0;
+	ttCutoffsExact = ttCutoffsLower = ttCutoffsUpper = 0;
+	betaCutoffs = firstMoveCutoffs = killerHits = historyHits = 0;
+	lmrReductions = lmrResearches = 0;
+	wallTimeMs = 0.0;
+	nodesPerSecond = 0.0;
+}
+
+std::string SearchStats::toJson(int searchId, int turn) const
+{
+	std::ostringstream json;
+	json << std::fixed << std::setprecision(3);
+	json << "{\"search\":" << searchId
+		 << ",\"turn\":" << turn
+		 << ",\"depth\":" << depth
+		 << ",\"best_move\":[" << bestMove.x << "," << bestMove.y << "]"
+		 << ",\"score\":" << score
+		 << ",\"nodes\":" << nodes
+		 << ",\"leaf_evals\":" << leafEvals
+		 << ",\"tt_probes\":" << ttProbes
+		 << ",\"tt_hits\":" << ttHits
+		 << ",\"tt_cutoffs\":{\"exact\":" << ttCutoffsExact
+		 << ",\"lower\":" << ttCutoffsLower
+		 << ",\"upper\":" << ttCutoffsUpper << "}"
+		 << ",\"beta_cutoffs\":" << betaCutoffs
+		 << ",\"first_move_cutoffs\":" << firstMoveCutoffs
+		 << ",\"first_move_cutoff_rate\":" << firstMoveCutoffRate()
+		 << ",\"killer_hits\":" << killerHits
+		 << ",\"history_hits\":" << historyHits
+		 << ",\"lmr_reductions\":" << lmrReductions
+		 << ",\"lmr_researches\":" << lmrResearches
+		 << ",\"time_ms\":" << wallTimeMs
+		 << ",\"nps\":" << std::setprecision(0) << nodesPerSecond
+		 << "}";
+	return json.str();
+}
+
+bool SearchStats::appendJsonLines(const std::string &filename, const std::vector<SearchStats> &iterations,
+								  int searchId, int turn)
+{
+	std::ofstream file(filename, std::ios::out | std::ios::app);
+	if (!file.is_open())
+		return false;
+
+	for (const SearchStats &stats : iterations)
+		file << stats.toJson(searchId, turn) << '\n';
+	return true;
+}
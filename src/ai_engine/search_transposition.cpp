@@ -4,6 +4,7 @@
 // ============================================
 
 #include "../../include/ai/transposition_search.hpp"
+#include "../../include/utils/trace_recorder.hpp"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
@@ -11,7 +12,8 @@
 #include <cstring>
 
 TranspositionSearch::TranspositionSearch(size_t tableSizeMB)
-	: currentGeneration(1), nodesEvaluated(0), cacheHits(0)
+	: currentGeneration(1), nodesEvaluated(0), cacheHits(0), searchCount(0),
+	  timeLimitMs(0), searchAborted(false)
 {
 	initializeTranspositionTable(tableSizeMB);
 	std::memset(historyTable, 0, sizeof(historyTable));
@@ -62,6 +64,14 @@ void TranspositionSearch::initializeTranspositionTable(size_t sizeInMB)
 	// TranspositionTable initialization will be logged from main
 }
 
+void TranspositionSearch::resizeTable(size_t sizeInMB)
+{
+	// Release the old table first so both never coexist in memory
+	std::vector<CacheEntry>().swap(transpositionTable);
+	initializeTranspositionTable(sizeInMB);
+	currentGeneration = 1;
+}
+
 bool TranspositionSearch::lookupTransposition(uint64_t zobristKey, CacheEntry &entry)
 {
 	size_t index = zobristKey & tableSizeMask;
@@ -142,11 +152,13 @@ void TranspositionSearch::storeTransposition(uint64_t zobristKey, int score, int
 
 void TranspositionSearch::clearCache()
 {
+	TRACE_SCOPE("tt clear", "tt");
 	std::fill(transpositionTable.begin(), transpositionTable.end(), CacheEntry());
 	currentGeneration = 1; // Reset generation
 	std::memset(historyTable, 0, sizeof(historyTable));
 	for (int i = 0; i < MAX_SEARCH_DEPTH; i++)
 		killerMoves[i][0] = killerMoves[i][1] = Move();
+	previousBestMove = Move();
 	std::cout << "TranspositionTable: Cache cleared (" << transpositionTable.size() << " entries)" << std::endl;
 }
 
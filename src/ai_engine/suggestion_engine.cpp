@@ -6,11 +6,13 @@
 // ===============================================
 
 #include "../../include/ai/suggestion_engine.hpp"
+#include "../../include/utils/trace_recorder.hpp"
 #include <algorithm>
 #include <limits>
 #include <iostream>
 
 Move SuggestionEngine::getSuggestion(const GameState& state, int depth) {
+    TRACE_SCOPE("suggestion", "suggestion");
     // Use the main AI with the specified depth
     AI suggestionAI(depth);
     
@@ -0,0 +1,162 @@
+// ===============================================
+// AI Engine - Threat Scanner Module
+// ===============================================
+// Handles: Per-cell threat map build and incremental update
+// Dependencies: Board line bitsets, game types
+// ===============================================
+
+#include "../../include/ai/threat_scanner.hpp"
+
+// A shape through a cell spans at most 4 cells each way and a capture 3:
+// no cell further away changes an entry
+static const int REACH = 4;
+
+// ===============================================
+// CELL CLASSIFICATION
+// ===============================================
+
+// Shape and capture of one stone, as they are combined over lines
+struct CellThreats
+{
+	int shape = ThreatMap::NONE;
+	bool captures = false;
+
+	uint8_t entry() const
+	{
+		return (uint8_t)(shape | (captures ? ThreatMap::CAPTURE : 0));
+	}
+};
+
+/**
+ * Best shape of a stone at `bit` of one line, from the five-cell windows
+ * through it that the opponent and the board edge leave free: 5 stones
+ * make a five, 4 a four (two distinct cells to complete make it open),
+ * 3 a three and 2 a two. A three is open when a six-cell window has both
+ * ends empty and the stone among three inside, one gap left
+ */
+static int lineShape(uint32_t own, uint32_t empty, int bit)
+{
+	// Most lines have no own stone within reach: a lone stone makes nothing
+	uint32_t reach = bit >= 4 ? 0x1FFu << (bit - 4) : 0x1FFu >> (4 - bit);
+	if (!(own & reach & ~(1u << bit)))
+		return ThreatMap::NONE;
+
+	uint32_t mine = own | 1u << bit;
+	uint32_t usable = mine | empty;
+	uint32_t completions = 0;
+	int shape = ThreatMap::NONE;
+
+	for (int start = bit > 4 ? bit - 4 : 0; start <= bit; start++)
+	{
+		uint32_t window = 0x1Fu << start;
+		if ((usable & window) != window)
+			continue;
+		int stones = __builtin_popcount(mine & window);
+		if (stones == 5)
+			return ThreatMap::FIVE;
+		if (stones == 4)
+			completions |= window & ~mine;
+		else if (stones == 3 && shape < ThreatMap::THREE)
+			shape = ThreatMap::THREE;
+		else if (stones == 2 && shape < ThreatMap::TWO)
+			shape = ThreatMap::TWO;
+	}
+	if (completions)
+		return __builtin_popcount(completions) >= 2 ? ThreatMap::OPEN_FOUR : ThreatMap::FOUR;
+
+	for (int start = bit > 4 ? bit - 4 : 0; start < bit; start++)
+	{
+		uint32_t ends = 1u << start | 1u << (start + 5);
+		uint32_t inside = 0x0Fu << (start + 1);
+		if ((empty & ends) == ends && (usable & inside) == inside && __builtin_popcount(mine & inside) == 3)
+			return ThreatMap::OPEN_THREE;
+	}
+	return shape;
+}
+
+/**
+ * Adds what a stone of the `own` player at `bit` of one line would make
+ * (the cell itself is not read)
+ */
+static void addLine(CellThreats &threats, uint32_t own, uint32_t opponent, uint32_t empty, int bit)
+{
+	int shape = lineShape(own, empty, bit);
+	if (shape > threats.shape)
+		threats.shape = shape;
+
+	// Stone-OPP-OPP-OWN either way along the line
+	threats.captures |= (((opponent >> (bit + 1)) & 3) == 3 && ((own >> (bit + 3)) & 1)) ||
+						(bit >= 3 && ((opponent >> (bit - 2)) & 3) == 3 && ((own >> (bit - 3)) & 1));
+}
+
+void ThreatScanner::classify(const GameState &state, int x, int y, uint8_t &player1, uint8_t &player2)
+{
+	CellThreats threats1, threats2;
+	for (int d = 0; d < 4; d++)
+	{
+		const BoardLines::Point &point = Board::point(x, y, d);
+		uint32_t stones1 = state.board.stones(point.line, GameState::PLAYER1);
+		uint32_t stones2 = state.board.stones(point.line, GameState::PLAYER2);
+		uint32_t empty = state.board.empty(point.line);
+		addLine(threats1, stones1, stones2, empty, point.bit);
+		addLine(threats2, stones2, stones1, empty, point.bit);
+	}
+	player1 = threats1.entry();
+	player2 = threats2.entry();
+}
+
+// ===============================================
+// MAP MAINTENANCE
+// ===============================================
+// Only empty cells are kept; entry() classifies an occupied one on demand
+
+void ThreatScanner::refresh(const GameState &state, ThreatMap &map)
+{
+	for (int x = 0; x < GameState::BOARD_SIZE; x++)
+		for (int y = 0; y < GameState::BOARD_SIZE; y++)
+			if (state.board[x][y] == GameState::EMPTY)
+				classify(state, x, y, map.cells[0][x][y], map.cells[1][x][y]);
+	map.pendingCount = 0;
+	map.revision = state.board.revision();
+	map.valid = true;
+}
+
+void ThreatScanner::update(const GameState &state, ThreatMap &map, const Move &changed)
+{
+	for (int d = 0; d < 4; d++)
+	{
+		const BoardLines::Point &point = Board::point(changed.x, changed.y, d);
+		uint32_t cells = state.board.empty(point.line);
+		int first = point.bit > REACH ? point.bit - REACH : 0;
+		cells &= (2u << (point.bit + REACH)) - (1u << first);
+		// The changed cell itself is on all four lines: done once
+		if (d > 0)
+			cells &= ~(1u << point.bit);
+		while (cells)
+		{
+			int bit = __builtin_ctz(cells);
+			cells &= cells - 1;
+			int x, y;
+			Board::cellAt(point.line, bit, x, y);
+			classify(state, x, y, map.cells[0][x][y], map.cells[1][x][y]);
+		}
+	}
+}
+
+uint8_t ThreatScanner::entry(const GameState &state, int player, int x, int y)
+{
+	if (state.board[x][y] != GameState::EMPTY)
+	{
+		uint8_t player1, player2;
+		classify(state, x, y, player1, player2);
+		return player == GameState::PLAYER1 ? player1 : player2;
+	}
+
+	ThreatMap &map = state.threats;
+	if (!map.valid || map.revision != state.board.revision())
+		refresh(state, map);
+	for (int i = 0; i < map.pendingCount; i++)
+		update(state, map, Move(map.pending[i] / GameState::BOARD_SIZE, map.pending[i] % GameState::BOARD_SIZE));
+	map.pendingCount = 0;
+	return map.cells[player - 1][x][y];
+}
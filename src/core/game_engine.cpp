@@ -11,6 +11,9 @@ void GameEngine::newGame()
 {
 	state = GameState(); // Reset to initial state
 	lastHumanMove = Move(-1, -1); // Also reset the local field
+	// A game left unfinished is closed as such; the next one starts with its first move
+	recordWriter.endGame(GameRecord::UNFINISHED);
+	gameRecord.clear();
 }
 
 bool GameEngine::makeHumanMove(const Move& move) {
@@ -23,8 +26,10 @@ bool GameEngine::makeHumanMove(const Move& move) {
     // the player CAN choose to capture, but it's not mandatory.
     // If they don't capture, they simply lose the game.
     bool ignoredCapture = false;
+    bool hadCaptureOpportunity = !state.forcedCaptureMoves.empty() &&
+                                 state.forcedCapturePlayer == state.currentPlayer;
 
-    if (!state.forcedCaptureMoves.empty() && state.forcedCapturePlayer == state.currentPlayer) {
+    if (hadCaptureOpportunity) {
         bool isCapturingMove = false;
         for (const Move& capturePos : state.forcedCaptureMoves) {
             if (capturePos.x == move.x && capturePos.y == move.y) {
@@ -62,6 +67,7 @@ bool GameEngine::makeHumanMove(const Move& move) {
         } else {
             checkAndSetForcedCaptures();
         }
+        recordMove(move, result, hadCaptureOpportunity);
     }
     
     return result.success;
@@ -107,7 +113,7 @@ Move GameEngine::makeAIMove() {
             }
         }
         
-        RuleEngine::applyMove(state, bestMove);
+        RuleEngine::MoveResult result = RuleEngine::applyMove(state, bestMove);
         
         if (hadCaptureOpportunity && !isCapture) {
             // AI chose not to break the 5-in-a-row — pendingWinPlayer
@@ -117,11 +123,42 @@ Move GameEngine::makeAIMove() {
         } else {
             checkAndSetForcedCaptures();
         }
+        if (result.success)
+            recordMove(bestMove, result, hadCaptureOpportunity);
     }
     
     return bestMove;
 }
 
+void GameEngine::recordMove(const Move& move, const RuleEngine::MoveResult& result, bool hadCaptureOpportunity) {
+    uint16_t flags = 0;
+    if (!result.myCapturedPieces.empty())
+        flags |= RecordedMove::CAPTURED;
+    if (hadCaptureOpportunity)
+        flags |= RecordedMove::FORCED_CAPTURE;
+    gameRecord.moves.push_back(RecordedMove(move, flags));
+    recordWriter.recordMove(gameRecord.moves.back());
+
+    if (isGameOver()) {
+        gameRecord.result = getWinner() == GameState::PLAYER1 ? GameRecord::PLAYER1_WINS : GameRecord::PLAYER2_WINS;
+        recordWriter.endGame(gameRecord.result);
+    }
+}
+
+bool GameEngine::playRandomOpening(int plies, std::mt19937_64& random) {
+    std::uniform_int_distribution<int> offset(-OPENING_RADIUS, OPENING_RADIUS);
+    for (int ply = 0; ply < plies; ply++) {
+        bool played = false;
+        for (int attempt = 0; attempt < 100 && !played; attempt++) {
+            Move move(GameState::BOARD_CENTER + offset(random), GameState::BOARD_CENTER + offset(random));
+            played = RuleEngine::isLegalMove(state, move) && makeHumanMove(move);
+        }
+        if (!played || isGameOver())
+            return false;
+    }
+    return true;
+}
+
 bool GameEngine::isGameOver() const
 {
 	// If there's a pending win that wasn't broken by capture, game is over
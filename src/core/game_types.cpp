@@ -1,18 +1,13 @@
 #include "../../include/core/game_types.hpp"
 #include "../../include/utils/zobrist_hasher.hpp"
+#include "../../include/ai/nnue.hpp"
 #include <iostream>
-#include <cstring>
 
 // Static hasher initialization
 const ZobristHasher* GameState::hasher = nullptr;
+const NnueNetwork* GameState::network = nullptr;
 
 GameState::GameState() {
-    for (int i = 0; i < BOARD_SIZE; i++) {
-        for (int j = 0; j < BOARD_SIZE; j++) {
-            board[i][j] = EMPTY;
-        }
-    }
-    
     // Initialize last human move as invalid
     lastHumanMove = Move(-1, -1);
     
@@ -40,7 +35,7 @@ GameState::GameState(const GameState& other) {
 
 GameState& GameState::operator=(const GameState& other) {
     if (this != &other) {
-        std::memcpy(board, other.board, sizeof(board));
+        board = other.board;
         captures[0] = other.captures[0];
         captures[1] = other.captures[1];
         currentPlayer = other.currentPlayer;
@@ -53,6 +48,18 @@ GameState& GameState::operator=(const GameState& other) {
         forcedCaptureMoves = other.forcedCaptureMoves;
         forcedCapturePlayer = other.forcedCapturePlayer;
         pendingWinPlayer = other.pendingWinPlayer;
+        
+        // Accumulator only copied when there is one to keep
+        if (other.nnue.weightsId)
+            nnue = other.nnue;
+        else
+            nnue.weightsId = 0;
+        
+        // Same for the threat map
+        if (other.threats.valid)
+            threats = other.threats;
+        else
+            threats.valid = false;
     }
     return *this;
 }
@@ -80,6 +87,11 @@ void GameState::initializeHasher() {
     }
 }
 
+void GameState::initializeHasher(uint64_t seed) {
+    cleanupHasher();
+    hasher = new ZobristHasher(seed);
+}
+
 void GameState::cleanupHasher() {
     if (hasher) {
         delete hasher;
@@ -102,6 +114,38 @@ void GameState::updateHashAfterMove(const Move& move, int player,
                                             capturedPieces, oldCaptures, newCaptures);
 }
 
+void GameState::updateNnueAfterMove(const Move& move, int player,
+                                    const std::vector<Move>& capturedPieces,
+                                    int oldCaptures, uint64_t oldHash) {
+    if (!network) {
+        return;
+    }
+    
+    if (nnue.weightsId == network->getWeightsId() && nnue.key == oldHash) {
+        network->update(nnue, move, player, capturedPieces, oldCaptures, captures[player - 1]);
+        nnue.key = zobristHash;
+    } else {
+        network->refresh(*this, nnue);
+    }
+}
+
+void GameState::updateThreatsAfterMove(const Move& move,
+                                       const std::vector<Move>& capturedPieces,
+                                       uint32_t oldRevision) {
+    if (!threats.valid || threats.revision != oldRevision)
+        return;
+    
+    // Too many changes queued: cheaper to rebuild on the next read
+    if (threats.pendingCount + 1 + (int)capturedPieces.size() > ThreatMap::MAX_PENDING) {
+        threats.valid = false;
+        return;
+    }
+    threats.pending[threats.pendingCount++] = (uint16_t)(move.x * BOARD_SIZE + move.y);
+    for (const Move& captured : capturedPieces)
+        threats.pending[threats.pendingCount++] = (uint16_t)(captured.x * BOARD_SIZE + captured.y);
+    threats.revision = board.revision();
+}
+
 void GameState::recalculateHash() {
     if (!hasher) {
         std::cerr << "ERROR: Hasher no inicializado. Llama GameState::initializeHasher() primero." << std::endl;
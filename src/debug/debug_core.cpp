@@ -6,7 +6,6 @@
 #include "../../include/debug/debug_analyzer.hpp"
 #include "../../include/ai/evaluator.hpp"
 #include <iostream>
-#include <fstream>
 #include <sstream>
 
 // Access to the evaluator's debug system
@@ -16,23 +15,17 @@ extern EvaluationDebugCapture g_evalDebug;
 DebugAnalyzer* g_debugAnalyzer = nullptr;
 
 DebugAnalyzer::DebugAnalyzer(DebugLevel level) : 
-    currentLevel(level), fileLoggingEnabled(false) {
+    currentLevel(level), logWriter(new DebugLogWriter()), fileLoggingEnabled(false) {
     clear();
 }
 
 DebugAnalyzer::~DebugAnalyzer() {
-    if (debugFile.is_open()) {
-        debugFile.close();
-    }
+    // Drains everything still queued before the writer thread exits
+    logWriter->close();
 }
 
 void DebugAnalyzer::enableFileLogging(const std::string& filename) {
-    if (debugFile.is_open()) {
-        debugFile.close();
-    }
-    
-    debugFile.open(filename, std::ios::out | std::ios::app);
-    if (debugFile.is_open()) {
+    if (logWriter->open(filename)) {
         fileLoggingEnabled = true;
         logToFile("=== GOMOKU DEBUG SESSION START ===");
     } else {
@@ -42,17 +35,24 @@ void DebugAnalyzer::enableFileLogging(const std::string& filename) {
 }
 
 void DebugAnalyzer::disableFileLogging() {
-    if (debugFile.is_open()) {
+    if (logWriter->isOpen()) {
         logToFile("=== GOMOKU DEBUG SESSION END ===");
-        debugFile.close();
+        logWriter->close();
     }
     fileLoggingEnabled = false;
 }
 
+void DebugAnalyzer::flushLog() {
+    logWriter->flush();
+}
+
+uint64_t DebugAnalyzer::getDroppedLogRecords() const {
+    return logWriter->getDroppedCount();
+}
+
 void DebugAnalyzer::logToFile(const std::string& message) const {
-    if (fileLoggingEnabled && debugFile.is_open()) {
-        const_cast<std::ofstream&>(debugFile) << message << std::endl;
-        const_cast<std::ofstream&>(debugFile).flush();
+    if (fileLoggingEnabled) {
+        logWriter->push(message);
     }
 }
 
@@ -0,0 +1,198 @@
+// ============================================
+// DEBUG_LOG_WRITER.CPP
+// Bounded MPSC ring buffer + background file writer
+// ============================================
+
+#include "../../include/debug/debug_log_writer.hpp"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+DebugLogWriter::DebugLogWriter(size_t requestedCapacity)
+	: capacity(2), mask(1), enqueuePos(0), dequeuePos(0), writtenPos(0),
+	  droppedRecords(0), truncatedRecords(0), reportedDrops(0),
+	  running(false), stopRequested(false)
+{
+	while (capacity < requestedCapacity)
+		capacity <<= 1;
+	mask = capacity - 1;
+	slots.reset(new Slot[capacity]);
+	resetSlots();
+}
+
+DebugLogWriter::~DebugLogWriter()
+{
+	close();
+}
+
+void DebugLogWriter::resetSlots()
+{
+	for (size_t i = 0; i < capacity; i++)
+	{
+		slots[i].sequence.store(i, std::memory_order_relaxed);
+		slots[i].length = 0;
+	}
+	enqueuePos.store(0, std::memory_order_relaxed);
+	dequeuePos = 0;
+	writtenPos.store(0, std::memory_order_relaxed);
+}
+
+bool DebugLogWriter::open(const std::string &filename)
+{
+	close();
+
+	file.open(filename, std::ios::out | std::ios::app);
+	if (!file.is_open())
+		return false;
+
+	resetSlots();
+	stopRequested.store(false, std::memory_order_relaxed);
+	running.store(true, std::memory_order_release);
+	writerThread = std::thread(&DebugLogWriter::writerLoop, this);
+	return true;
+}
+
+void DebugLogWriter::close()
+{
+	if (!running.load(std::memory_order_acquire))
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(wakeMutex);
+		stopRequested.store(true, std::memory_order_release);
+	}
+	wakeCondition.notify_all();
+
+	if (writerThread.joinable())
+		writerThread.join();
+
+	running.store(false, std::memory_order_release);
+	file.close();
+}
+
+// ============================================
+// PRODUCER SIDE (lock-free)
+// ============================================
+
+bool DebugLogWriter::push(const std::string &message)
+{
+	if (!running.load(std::memory_order_acquire))
+		return false;
+
+	size_t pos = enqueuePos.load(std::memory_order_relaxed);
+	Slot *slot;
+	for (;;)
+	{
+		slot = &slots[pos & mask];
+		size_t seq = slot->sequence.load(std::memory_order_acquire);
+		intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+		if (diff == 0)
+		{
+			if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				break;
+		}
+		else if (diff < 0)
+		{
+			// Ring full: never block the search on disk I/O
+			droppedRecords.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		else
+		{
+			pos = enqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+
+	size_t length = message.size();
+	if (length > MAX_MESSAGE)
+	{
+		length = MAX_MESSAGE;
+		truncatedRecords.fetch_add(1, std::memory_order_relaxed);
+	}
+	std::memcpy(slot->text, message.data(), length);
+	slot->length = (uint32_t)length;
+	slot->sequence.store(pos + 1, std::memory_order_release);
+	return true;
+}
+
+void DebugLogWriter::flush()
+{
+	if (!running.load(std::memory_order_acquire))
+		return;
+
+	size_t target = enqueuePos.load(std::memory_order_acquire);
+	std::unique_lock<std::mutex> lock(wakeMutex);
+	wakeCondition.notify_all();
+	wakeCondition.wait(lock, [&]() {
+		return writtenPos.load(std::memory_order_acquire) >= target ||
+			   stopRequested.load(std::memory_order_acquire);
+	});
+}
+
+// ============================================
+// WRITER THREAD
+// ============================================
+
+size_t DebugLogWriter::drainBatch(std::string &batch)
+{
+	size_t count = 0;
+	for (;;)
+	{
+		Slot &slot = slots[dequeuePos & mask];
+		size_t seq = slot.sequence.load(std::memory_order_acquire);
+		if (seq != dequeuePos + 1)
+			break;
+
+		batch.append(slot.text, slot.length);
+		batch.push_back('\n');
+		slot.sequence.store(dequeuePos + capacity, std::memory_order_release);
+		dequeuePos++;
+		count++;
+	}
+	return count;
+}
+
+void DebugLogWriter::writerLoop()
+{
+	std::string batch;
+	batch.reserve(capacity * 64);
+
+	for (;;)
+	{
+		bool stopping = stopRequested.load(std::memory_order_acquire);
+
+		batch.clear();
+		size_t count = drainBatch(batch);
+
+		uint64_t dropped = droppedRecords.load(std::memory_order_relaxed);
+		if (dropped != reportedDrops)
+		{
+			batch += "[LOG] " + std::to_string(dropped - reportedDrops) +
+					 " records dropped (ring buffer full)\n";
+			reportedDrops = dropped;
+		}
+
+		if (!batch.empty())
+		{
+			file.write(batch.data(), (std::streamsize)batch.size());
+			file.flush();
+		}
+
+		if (count > 0 || writtenPos.load(std::memory_order_relaxed) != dequeuePos)
+		{
+			{
+				std::lock_guard<std::mutex> lock(wakeMutex);
+				writtenPos.store(dequeuePos, std::memory_order_release);
+			}
+			wakeCondition.notify_all();
+			continue; // Keep draining while producers are busy
+		}
+
+		if (stopping)
+			break;
+
+		std::unique_lock<std::mutex> lock(wakeMutex);
+		wakeCondition.wait_for(lock, std::chrono::milliseconds(IDLE_WAIT_MS));
+	}
+}
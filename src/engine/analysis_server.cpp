@@ -0,0 +1,656 @@
+// ============================================
+// ANALYSIS_SERVER.CPP
+// Sessions, engine worker pool, bounded think queue
+// Line-delimited JSON over a Unix domain socket
+// ============================================
+
+#include "../../include/engine/analysis_server.hpp"
+#include "../../include/rules/rule_engine.hpp"
+#include "../../include/utils/position_io.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static const int MAX_BUDGET_MS = 60000;
+static const int MAX_DEPTH = 20;
+// A request line longer than this closes the connection
+static const size_t MAX_REQUEST_BYTES = 64 * 1024;
+// Accept loop wake-up interval, to notice stop()
+static const int ACCEPT_POLL_MS = 100;
+
+// ============================================
+// Minimal JSON: flat objects of strings, numbers and booleans
+// ============================================
+
+/**
+ * Parses {"key":value,...} into raw value texts (strings keep their
+ * quotes); nested objects and arrays are rejected
+ */
+static bool parseFlatObject(const std::string &text, std::map<std::string, std::string> &fields)
+{
+	size_t i = 0;
+	auto skipSpace = [&]() {
+		while (i < text.size() && std::isspace((unsigned char)text[i]))
+			i++;
+	};
+	// Returns the end of the string starting at text[i] == '"' (one past the closing quote)
+	auto stringEnd = [&](size_t start) -> size_t {
+		for (size_t j = start + 1; j < text.size(); j++)
+		{
+			if (text[j] == '\\')
+				j++;
+			else if (text[j] == '"')
+				return j + 1;
+		}
+		return std::string::npos;
+	};
+
+	skipSpace();
+	if (i >= text.size() || text[i] != '{')
+		return false;
+	i++;
+	skipSpace();
+	// Nothing but whitespace may follow the closing brace
+	auto closes = [&]() {
+		i++;
+		skipSpace();
+		return i == text.size();
+	};
+	if (i < text.size() && text[i] == '}')
+		return closes();
+
+	while (i < text.size())
+	{
+		skipSpace();
+		if (i >= text.size() || text[i] != '"')
+			return false;
+		size_t keyEnd = stringEnd(i);
+		if (keyEnd == std::string::npos)
+			return false;
+		std::string key = text.substr(i + 1, keyEnd - i - 2);
+		i = keyEnd;
+
+		skipSpace();
+		if (i >= text.size() || text[i] != ':')
+			return false;
+		i++;
+		skipSpace();
+		if (i >= text.size() || text[i] == '{' || text[i] == '[')
+			return false;
+
+		size_t valueEnd;
+		if (text[i] == '"')
+			valueEnd = stringEnd(i);
+		else
+			valueEnd = text.find_first_of(",} \t\r\n", i);
+		if (valueEnd == std::string::npos || valueEnd == i)
+			return false;
+		fields[key] = text.substr(i, valueEnd - i);
+		i = valueEnd;
+
+		skipSpace();
+		if (i < text.size() && text[i] == ',')
+		{
+			i++;
+			continue;
+		}
+		if (i < text.size() && text[i] == '}')
+			return closes();
+		return false;
+	}
+	return false;
+}
+
+// Raw JSON string -> its contents (\" and \\ unescaped)
+static std::string decodeString(const std::string &raw)
+{
+	std::string value;
+	for (size_t i = 1; i + 1 < raw.size(); i++)
+	{
+		if (raw[i] == '\\' && i + 2 < raw.size())
+			i++;
+		value += raw[i];
+	}
+	return value;
+}
+
+static std::string encodeString(const std::string &value)
+{
+	std::string raw = "\"";
+	for (char c : value)
+	{
+		if (c == '"' || c == '\\')
+			raw += '\\';
+		raw += c;
+	}
+	return raw + "\"";
+}
+
+static bool getInt(const std::map<std::string, std::string> &fields, const std::string &key, int &value)
+{
+	auto it = fields.find(key);
+	if (it == fields.end())
+		return false;
+	char *end = nullptr;
+	long parsed = std::strtol(it->second.c_str(), &end, 10);
+	if (end == it->second.c_str() || *end != '\0')
+		return false;
+	value = (int)parsed;
+	return true;
+}
+
+/**
+ * True for a raw value that can be echoed as the reply id: a JSON string
+ * with valid escapes and no control characters, or a JSON number
+ */
+static bool isValidId(const std::string &raw)
+{
+	if (raw.size() >= 2 && raw.front() == '"' && raw.back() == '"')
+	{
+		for (size_t i = 1; i + 1 < raw.size(); i++)
+		{
+			if ((unsigned char)raw[i] < 0x20)
+				return false;
+			if (raw[i] != '\\')
+				continue;
+			i++;
+			if (i + 1 >= raw.size())
+				return false;
+			if (raw[i] == 'u')
+			{
+				if (i + 5 >= raw.size())
+					return false;
+				for (int k = 1; k <= 4; k++)
+					if (!std::isxdigit((unsigned char)raw[i + k]))
+						return false;
+				i += 4;
+			}
+			else if (std::string("\"\\/bfnrt").find(raw[i]) == std::string::npos)
+				return false;
+		}
+		return true;
+	}
+
+	// -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+	size_t i = 0;
+	auto digits = [&]() {
+		size_t start = i;
+		while (i < raw.size() && std::isdigit((unsigned char)raw[i]))
+			i++;
+		return i - start;
+	};
+	if (i < raw.size() && raw[i] == '-')
+		i++;
+	if (i < raw.size() && raw[i] == '0')
+		i++;
+	else if (digits() == 0)
+		return false;
+	if (i < raw.size() && raw[i] == '.')
+	{
+		i++;
+		if (digits() == 0)
+			return false;
+	}
+	if (i < raw.size() && (raw[i] == 'e' || raw[i] == 'E'))
+	{
+		i++;
+		if (i < raw.size() && (raw[i] == '+' || raw[i] == '-'))
+			i++;
+		if (digits() == 0)
+			return false;
+	}
+	return i == raw.size();
+}
+
+// {"id":<id>, body}
+static std::string makeReply(const std::string &id, const std::string &body)
+{
+	return id.empty() ? "{" + body + "}" : "{\"id\":" + id + "," + body + "}";
+}
+
+static std::string errorReply(const std::string &id, const std::string &message)
+{
+	return makeReply(id, "\"ok\":false,\"error\":" + encodeString(message));
+}
+
+// ============================================
+// Lifecycle
+// ============================================
+
+AnalysisServer::AnalysisServer(const Config &config)
+	: config(config), nextSessionId(1), shuttingDown(false), stopRequested(false),
+	  activeSearches(0), thinksCompleted(0), thinksRejected(0), nodesSearched(0), thinkMicroseconds(0)
+{
+	if (this->config.workers < 1)
+		this->config.workers = 1;
+
+	// AI always allocates its C++ table; with Rust the budget covers both
+	size_t perWorker = this->config.tableMB / this->config.workers;
+	if (this->config.implementation == RUST_IMPLEMENTATION)
+		perWorker /= 2;
+	tableMBPerWorker = std::max<size_t>(1, perWorker);
+
+	for (int i = 0; i < this->config.workers; i++)
+		workers.emplace_back(&AnalysisServer::workerLoop, this);
+}
+
+AnalysisServer::~AnalysisServer()
+{
+	std::deque<ThinkJob> pending;
+	{
+		std::lock_guard<std::mutex> lock(queueMutex);
+		shuttingDown = true;
+		pending.swap(queue);
+	}
+	queueReady.notify_all();
+	for (const ThinkJob &job : pending)
+		job.sink(errorReply(job.requestId, "server shutting down"));
+	for (std::thread &worker : workers)
+		worker.join();
+}
+
+// ============================================
+// Requests
+// ============================================
+
+void AnalysisServer::handleRequest(const std::string &line, const ReplySink &sink)
+{
+	std::map<std::string, std::string> request;
+	if (!parseFlatObject(line, request))
+	{
+		sink(errorReply("", "malformed request"));
+		return;
+	}
+	std::string id = request.count("id") ? request["id"] : "";
+	if (!id.empty() && !isValidId(id))
+	{
+		sink(errorReply("", "id must be a string or a number"));
+		return;
+	}
+	std::string command = request.count("cmd") ? decodeString(request["cmd"]) : "";
+
+	std::string reply;
+	if (command == "new")
+		reply = newSession(request, id);
+	else if (command == "move")
+		reply = playMove(request, id);
+	else if (command == "think")
+		reply = queueThink(request, id, sink);
+	else if (command == "close")
+		reply = closeSession(request, id);
+	else if (command == "stats")
+		reply = makeReply(id, statsJson());
+	else
+		reply = errorReply(id, "unknown cmd");
+
+	// Empty: a worker replies when the search is done
+	if (!reply.empty())
+		sink(reply);
+}
+
+std::shared_ptr<AnalysisServer::Session> AnalysisServer::findSession(
+	const std::map<std::string, std::string> &request)
+{
+	int sessionId = 0;
+	if (!getInt(request, "session", sessionId))
+		return nullptr;
+	std::lock_guard<std::mutex> lock(sessionMutex);
+	auto it = sessions.find(sessionId);
+	return it == sessions.end() ? nullptr : it->second;
+}
+
+std::string AnalysisServer::newSession(const std::map<std::string, std::string> &request, const std::string &id)
+{
+	auto session = std::make_shared<Session>();
+	auto position = request.find("position");
+	if (position != request.end())
+	{
+		std::istringstream in(decodeString(position->second));
+		if (!PositionIO::read(in, session->state))
+			return errorReply(id, "invalid position");
+	}
+
+	std::lock_guard<std::mutex> lock(sessionMutex);
+	if (sessions.size() >= config.maxSessions)
+		return errorReply(id, "too many sessions");
+	int sessionId = nextSessionId++;
+	sessions[sessionId] = session;
+	return makeReply(id, "\"ok\":true,\"session\":" + std::to_string(sessionId));
+}
+
+std::string AnalysisServer::playMove(const std::map<std::string, std::string> &request, const std::string &id)
+{
+	std::shared_ptr<Session> session = findSession(request);
+	if (!session)
+		return errorReply(id, "unknown session");
+	int x = -1, y = -1;
+	if (!getInt(request, "x", x) || !getInt(request, "y", y))
+		return errorReply(id, "expected x and y");
+
+	std::lock_guard<std::mutex> lock(sessionMutex);
+	if (session->thinking)
+		return errorReply(id, "session busy");
+	if (!session->state.isValid(x, y))
+		return errorReply(id, "illegal move");
+
+	GameState &state = session->state;
+	RuleEngine::MoveResult result = RuleEngine::applyMove(state, Move(x, y));
+	if (!result.success)
+		return errorReply(id, "illegal move");
+	state.lastHumanMove = Move(x, y);
+
+	std::ostringstream body;
+	body << "\"ok\":true,\"captures\":[" << state.captures[0] << "," << state.captures[1]
+		 << "],\"win\":" << (result.createsWin ? "true" : "false") << ",\"turn\":" << state.turnCount;
+	return makeReply(id, body.str());
+}
+
+std::string AnalysisServer::queueThink(const std::map<std::string, std::string> &request, const std::string &id,
+									   const ReplySink &sink)
+{
+	std::shared_ptr<Session> session = findSession(request);
+	if (!session)
+		return errorReply(id, "unknown session");
+
+	ThinkJob job;
+	job.session = session;
+	job.requestId = id;
+	job.budgetMs = config.defaultBudgetMs;
+	job.depth = config.defaultDepth;
+	auto play = request.find("play");
+	job.play = play != request.end() && play->second == "true";
+	job.sink = sink;
+	if (request.count("budget_ms") && (!getInt(request, "budget_ms", job.budgetMs) ||
+									   job.budgetMs < 1 || job.budgetMs > MAX_BUDGET_MS))
+		return errorReply(id, "budget_ms must be 1-" + std::to_string(MAX_BUDGET_MS));
+	if (request.count("depth") && (!getInt(request, "depth", job.depth) || job.depth < 1 || job.depth > MAX_DEPTH))
+		return errorReply(id, "depth must be 1-" + std::to_string(MAX_DEPTH));
+
+	// Admission control: never wait for room, reject instead
+	std::lock_guard<std::mutex> sessionLock(sessionMutex);
+	if (session->thinking)
+	{
+		thinksRejected++;
+		return errorReply(id, "session busy");
+	}
+	{
+		std::lock_guard<std::mutex> queueLock(queueMutex);
+		if (shuttingDown || queue.size() >= config.queueLimit)
+		{
+			thinksRejected++;
+			return errorReply(id, "queue full");
+		}
+		queue.push_back(job);
+	}
+	session->thinking = true;
+	queueReady.notify_one();
+	return "";
+}
+
+std::string AnalysisServer::closeSession(const std::map<std::string, std::string> &request, const std::string &id)
+{
+	int sessionId = 0;
+	if (!getInt(request, "session", sessionId))
+		return errorReply(id, "unknown session");
+	std::lock_guard<std::mutex> lock(sessionMutex);
+	// A search in progress keeps its own reference and still replies
+	if (sessions.erase(sessionId) == 0)
+		return errorReply(id, "unknown session");
+	return makeReply(id, "\"ok\":true");
+}
+
+std::string AnalysisServer::statsJson() const
+{
+	size_t sessionCount, queued;
+	{
+		std::lock_guard<std::mutex> lock(sessionMutex);
+		sessionCount = sessions.size();
+	}
+	{
+		std::lock_guard<std::mutex> lock(queueMutex);
+		queued = queue.size();
+	}
+	uint64_t completed = thinksCompleted.load();
+
+	std::ostringstream body;
+	body << "\"ok\":true,\"sessions\":" << sessionCount
+		 << ",\"workers\":" << config.workers
+		 << ",\"active\":" << activeSearches.load()
+		 << ",\"queued\":" << queued
+		 << ",\"queue_limit\":" << config.queueLimit
+		 << ",\"completed\":" << completed
+		 << ",\"rejected\":" << thinksRejected.load()
+		 << ",\"nodes\":" << nodesSearched.load()
+		 << ",\"avg_think_ms\":" << (completed > 0 ? thinkMicroseconds.load() / completed / 1000 : 0)
+		 << ",\"tt_mb_per_worker\":" << tableMBPerWorker;
+	return body.str();
+}
+
+// ============================================
+// Worker pool
+// ============================================
+
+void AnalysisServer::workerLoop()
+{
+	// One engine per worker for the whole server lifetime
+	AI ai(config.defaultDepth, config.implementation, tableMBPerWorker);
+
+	while (true)
+	{
+		ThinkJob job;
+		{
+			std::unique_lock<std::mutex> lock(queueMutex);
+			queueReady.wait(lock, [this] { return shuttingDown || !queue.empty(); });
+			if (shuttingDown)
+				return;
+			job = queue.front();
+			queue.pop_front();
+		}
+		activeSearches++;
+		std::string reply = runThink(ai, job);
+		activeSearches--;
+		job.sink(reply);
+	}
+}
+
+std::string AnalysisServer::runThink(AI &ai, const ThinkJob &job)
+{
+	GameState position;
+	{
+		std::lock_guard<std::mutex> lock(sessionMutex);
+		position = job.session->state;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	ai.setTimeLimit(job.budgetMs);
+	TranspositionSearch::SearchResult result = ai.findBestMoveIterative(position, job.depth);
+	if (!result.bestMove.isValid() || !RuleEngine::isLegalMove(position, result.bestMove))
+		result.bestMove = RuleEngine::findCentralLegalMove(position);
+	int64_t elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now() - start).count();
+	int depthReached = ai.getLastSearchStats().empty() ? 0 : ai.getLastSearchStats().back().depth;
+
+	std::string reply;
+	{
+		std::lock_guard<std::mutex> lock(sessionMutex);
+		job.session->thinking = false;
+		if (!result.bestMove.isValid() ||
+			(job.play && !RuleEngine::applyMove(job.session->state, result.bestMove).success))
+			reply = errorReply(job.requestId, "no legal move");
+	}
+
+	thinksCompleted++;
+	nodesSearched += result.nodesEvaluated;
+	thinkMicroseconds += elapsedUs;
+
+	if (reply.empty())
+	{
+		std::ostringstream body;
+		body << "\"ok\":true,\"x\":" << result.bestMove.x << ",\"y\":" << result.bestMove.y
+			 << ",\"score\":" << result.score << ",\"depth\":" << depthReached
+			 << ",\"nodes\":" << result.nodesEvaluated << ",\"ms\":" << elapsedUs / 1000;
+		reply = makeReply(job.requestId, body.str());
+	}
+	return reply;
+}
+
+// ============================================
+// Unix socket front end
+// ============================================
+
+namespace
+{
+// Shared by a connection thread and the workers replying to it: replies
+// that arrive after the connection ended are dropped
+struct ConnectionWriter
+{
+	std::mutex mutex;
+	int fd;
+	bool open;
+
+	explicit ConnectionWriter(int fd) : fd(fd), open(true) {}
+
+	void write(const std::string &line)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		std::string data = line + "\n";
+		size_t sent = 0;
+		while (open && sent < data.size())
+		{
+			ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+			if (n < 0 && errno == EINTR)
+				continue;
+			if (n <= 0)
+				open = false;
+			else
+				sent += n;
+		}
+	}
+
+	void close()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		open = false;
+	}
+};
+
+struct Connection
+{
+	int fd;
+	std::thread thread;
+	std::shared_ptr<std::atomic<bool>> finished;
+};
+}
+
+bool AnalysisServer::serve(const std::string &socketPath)
+{
+	sockaddr_un address;
+	std::memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	if (socketPath.size() >= sizeof(address.sun_path))
+	{
+		std::cerr << "Error: socket path too long: " << socketPath << std::endl;
+		return false;
+	}
+	std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+	int listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listenFd < 0)
+	{
+		std::cerr << "Error: socket(): " << std::strerror(errno) << std::endl;
+		return false;
+	}
+	::unlink(socketPath.c_str());
+	if (::bind(listenFd, (sockaddr *)&address, sizeof(address)) < 0 || ::listen(listenFd, SOMAXCONN) < 0)
+	{
+		std::cerr << "Error: cannot listen on " << socketPath << ": " << std::strerror(errno) << std::endl;
+		::close(listenFd);
+		return false;
+	}
+
+	std::vector<Connection> connections;
+	auto reap = [&connections](bool all) {
+		for (auto it = connections.begin(); it != connections.end();)
+		{
+			if (!all && !it->finished->load())
+			{
+				++it;
+				continue;
+			}
+			if (all)
+				::shutdown(it->fd, SHUT_RDWR);
+			it->thread.join();
+			::close(it->fd);
+			it = connections.erase(it);
+		}
+	};
+
+	while (!stopRequested.load())
+	{
+		pollfd listener = {listenFd, POLLIN, 0};
+		int ready = ::poll(&listener, 1, ACCEPT_POLL_MS);
+		reap(false);
+		if (ready <= 0)
+			continue;
+		int fd = ::accept(listenFd, nullptr, nullptr);
+		if (fd < 0)
+			continue;
+
+		Connection connection;
+		connection.fd = fd;
+		connection.finished = std::make_shared<std::atomic<bool>>(false);
+		std::shared_ptr<std::atomic<bool>> finished = connection.finished;
+		connection.thread = std::thread([this, fd, finished] {
+			serveConnection(fd);
+			finished->store(true);
+		});
+		connections.push_back(std::move(connection));
+	}
+
+	reap(true);
+	::close(listenFd);
+	::unlink(socketPath.c_str());
+	return true;
+}
+
+void AnalysisServer::serveConnection(int fd)
+{
+	auto writer = std::make_shared<ConnectionWriter>(fd);
+	ReplySink sink = [writer](const std::string &line) { writer->write(line); };
+
+	std::string buffer;
+	char chunk[4096];
+	while (true)
+	{
+		ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			break;
+		buffer.append(chunk, n);
+
+		size_t newline;
+		while ((newline = buffer.find('\n')) != std::string::npos)
+		{
+			std::string line = buffer.substr(0, newline);
+			buffer.erase(0, newline + 1);
+			if (line.find_first_not_of(" \t\r") != std::string::npos)
+				handleRequest(line, sink);
+		}
+		if (buffer.size() > MAX_REQUEST_BYTES)
+		{
+			sink(errorReply("", "request too long"));
+			break;
+		}
+	}
+	writer->close();
+}
@@ -0,0 +1,63 @@
+// ============================================
+// ENGINE_MAIN.CPP
+// Headless engine: Piskvork protocol on stdin / stdout
+// No SFML, no audio; for tournament managers and batch runs
+// ============================================
+
+#include "../../include/engine/piskvork_protocol.hpp"
+#include "../../include/core/game_types.hpp"
+#include "../../include/ai/evaluator.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+int main(int argc, char **argv)
+{
+	AIImplementation implementation = CPP_IMPLEMENTATION;
+	int maxDepth = PiskvorkProtocol::DEFAULT_MAX_DEPTH;
+	int threads = 1;
+	const char *networkFile = nullptr;
+
+	bool validArgs = true;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		if (arg == "--rust")
+			implementation = RUST_IMPLEMENTATION;
+		else if (arg == "--depth" && i + 1 < argc)
+			maxDepth = std::atoi(argv[++i]);
+		else if (arg == "--threads" && i + 1 < argc)
+			threads = std::atoi(argv[++i]);
+		else if (arg == "--nnue" && i + 1 < argc)
+			networkFile = argv[++i];
+		else
+			validArgs = false;
+	}
+	if (!validArgs || maxDepth < 1 || maxDepth > 20 || threads < 1)
+	{
+		std::cerr << "Usage: " << argv[0] << " [--rust] [--depth 1-20] [--threads N] [--nnue FILE]" << std::endl;
+		return 2;
+	}
+
+	// Search and table code log to std::cout: send all of it to stderr so
+	// that stdout carries protocol replies only
+	std::ostream protocolOut(std::cout.rdbuf());
+	std::streambuf *consoleBuffer = std::cout.rdbuf(std::cerr.rdbuf());
+
+	GameState::initializeHasher();
+	if (networkFile && !Evaluator::loadNetwork(networkFile))
+	{
+		GameState::cleanupHasher();
+		std::cout.rdbuf(consoleBuffer);
+		return 2;
+	}
+	{
+		PiskvorkProtocol protocol(protocolOut, implementation, maxDepth);
+		protocol.setRustThreads(threads);
+		protocol.run(std::cin);
+	}
+	GameState::cleanupHasher();
+
+	std::cout.rdbuf(consoleBuffer);
+	return 0;
+}
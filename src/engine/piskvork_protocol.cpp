@@ -0,0 +1,390 @@
+// ============================================
+// PISKVORK_PROTOCOL.CPP
+// Gomocup / Piskvork brain protocol
+// Command parsing, position set-up, time and memory limits
+// ============================================
+
+#include "../../include/engine/piskvork_protocol.hpp"
+#include "../../include/rules/rule_engine.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <sstream>
+
+// Moves the remaining match time is spread over
+static const int MOVES_TO_GO = 20;
+// Kept back from every move budget for replying and process scheduling
+static const int SAFETY_MARGIN_MS = 50;
+// max_memory minus this is left for the transposition table
+static const long long MEMORY_RESERVE_MB = 16;
+// Table of the engine that is not searching (AI holds both)
+static const size_t UNUSED_TABLE_MB = 1;
+
+PiskvorkProtocol::PiskvorkProtocol(std::ostream &out, AIImplementation impl, int maxDepth)
+	: out(out), implementation(impl), maxDepth(maxDepth), rustThreads(1), aiTableMB(0),
+	  ownPlayer(GameState::PLAYER1), readingBoard(false),
+	  turnTimeoutMs(DEFAULT_TURN_MS), matchTimeoutMs(0), timeLeftMs(-1), maxMemoryBytes(0)
+{
+}
+
+// ============================================
+// Command dispatch
+// ============================================
+
+void PiskvorkProtocol::run(std::istream &in)
+{
+	std::string line;
+	while (std::getline(in, line))
+	{
+		if (!handleLine(line))
+			break;
+	}
+}
+
+bool PiskvorkProtocol::handleLine(const std::string &line)
+{
+	size_t start = line.find_first_not_of(" \t\r");
+	if (start == std::string::npos)
+		return true;
+	size_t end = line.find_last_not_of(" \t\r");
+	std::string text = line.substr(start, end - start + 1);
+
+	size_t split = text.find_first_of(" \t");
+	std::string command = text.substr(0, split);
+	std::string args = split == std::string::npos ? "" : text.substr(text.find_first_not_of(" \t", split));
+	std::transform(command.begin(), command.end(), command.begin(),
+				   [](unsigned char c) { return std::toupper(c); });
+
+	if (readingBoard)
+	{
+		if (command != "DONE")
+		{
+			boardLines.push_back(text);
+			return true;
+		}
+		readingBoard = false;
+		if (setUpBoard())
+			replyWithMove();
+		else
+			reply("ERROR invalid BOARD position");
+		return true;
+	}
+
+	if (command == "END")
+		return false;
+	handleCommand(command, args);
+	return true;
+}
+
+void PiskvorkProtocol::handleCommand(const std::string &command, const std::string &args)
+{
+	std::vector<int> values;
+
+	if (command == "START" || command == "RECTSTART")
+	{
+		bool square = parseCoordinates(args, values) &&
+					  ((command == "START" && values.size() == 1) ||
+					   (command == "RECTSTART" && values.size() == 2 && values[0] == values[1]));
+		if (!square || values[0] != GameState::BOARD_SIZE)
+		{
+			reply("ERROR only 19x19 boards are supported");
+			return;
+		}
+		newGame();
+		reply("OK");
+	}
+	else if (command == "RESTART")
+	{
+		newGame();
+		reply("OK");
+	}
+	else if (command == "BEGIN")
+	{
+		replyWithMove();
+	}
+	else if (command == "TURN")
+	{
+		if (!parseCoordinates(args, values) || values.size() != 2)
+		{
+			reply("ERROR expected TURN x,y");
+			return;
+		}
+		Move move(values[1], values[0]);
+		if (!playMove(move))
+		{
+			reply("ERROR illegal move " + args);
+			return;
+		}
+		state.lastHumanMove = move;
+		replyWithMove();
+	}
+	else if (command == "BOARD")
+	{
+		readingBoard = true;
+		boardLines.clear();
+	}
+	else if (command == "TAKEBACK")
+	{
+		if (history.empty())
+		{
+			reply("ERROR nothing to take back");
+			return;
+		}
+		// Only the last stone can be taken back: the one cell that is
+		// empty before it and occupied after it (captures only empty cells)
+		if (!parseCoordinates(args, values) || values.size() != 2 ||
+			!state.isValid(values[1], values[0]) ||
+			!history.back().isEmpty(values[1], values[0]) || state.isEmpty(values[1], values[0]))
+		{
+			reply("ERROR TAKEBACK " + args + " is not the last move");
+			return;
+		}
+		state = history.back();
+		history.pop_back();
+		reply("OK");
+	}
+	else if (command == "INFO")
+	{
+		handleInfo(args);
+	}
+	else if (command == "ABOUT")
+	{
+		reply("name=\"Gomoku\", version=\"1.0\"");
+	}
+	else
+	{
+		reply("UNKNOWN " + command);
+	}
+}
+
+void PiskvorkProtocol::handleInfo(const std::string &args)
+{
+	std::istringstream in(args);
+	std::string key;
+	long long value;
+	if (!(in >> key >> value))
+		return; // Non-numeric keys (folder, ...) are not used
+
+	if (key == "timeout_turn")
+		turnTimeoutMs = (int)std::max(0LL, value);
+	else if (key == "timeout_match")
+		matchTimeoutMs = (int)std::max(0LL, value);
+	else if (key == "time_left")
+		timeLeftMs = (int)std::max(0LL, value);
+	else if (key == "max_memory")
+		maxMemoryBytes = std::max(0LL, value);
+}
+
+void PiskvorkProtocol::newGame()
+{
+	state = GameState();
+	history.clear();
+	ownPlayer = GameState::PLAYER1;
+	readingBoard = false;
+	if (ai)
+		ai->clearCache();
+}
+
+// ============================================
+// Position
+// ============================================
+
+/**
+ * Rebuilds the state from the BOARD lines: stones are placed as given
+ * (captures already happened) and the engine is to move. The lines need
+ * not be in move order, so who moved first comes from the owner codes:
+ * counting the stones each side lost to captures, the engine has played
+ * as many stones as the opponent (it began, PLAYER1) or one fewer
+ * (the opponent began)
+ */
+bool PiskvorkProtocol::setUpBoard()
+{
+	struct Stone
+	{
+		Move move;
+		int who;
+	};
+	std::vector<Stone> stones;
+	int ownCaptures = 0;
+	int opponentCaptures = 0;
+
+	for (const std::string &line : boardLines)
+	{
+		std::vector<int> values;
+		if (line.compare(0, 8, "CAPTURES") == 0 || line.compare(0, 8, "captures") == 0)
+		{
+			if (!parseCoordinates(line.substr(8), values) || values.size() != 2 ||
+				values[0] < 0 || values[0] > 10 || values[1] < 0 || values[1] > 10)
+				return false;
+			ownCaptures = values[0];
+			opponentCaptures = values[1];
+			continue;
+		}
+		if (!parseCoordinates(line, values) || values.size() != 3 ||
+			(values[2] != 1 && values[2] != 2))
+			return false;
+		stones.push_back({Move(values[1], values[0]), values[2]});
+	}
+
+	int ownPlayed = 2 * opponentCaptures;
+	int opponentPlayed = 2 * ownCaptures;
+	for (const Stone &stone : stones)
+		(stone.who == 1 ? ownPlayed : opponentPlayed)++;
+	if (ownPlayed != opponentPlayed && ownPlayed + 1 != opponentPlayed)
+		return false;
+
+	GameState position;
+	ownPlayer = ownPlayed == opponentPlayed ? GameState::PLAYER1 : GameState::PLAYER2;
+	int opponent = position.getOpponent(ownPlayer);
+
+	for (const Stone &stone : stones)
+	{
+		if (!position.isEmpty(stone.move.x, stone.move.y))
+			return false;
+		int player = stone.who == 1 ? ownPlayer : opponent;
+		position.board[stone.move.x][stone.move.y] = player;
+		if (player == opponent)
+			position.lastHumanMove = stone.move;
+	}
+	position.captures[ownPlayer - 1] = ownCaptures;
+	position.captures[opponent - 1] = opponentCaptures;
+	position.currentPlayer = ownPlayer;
+	position.turnCount = (int)stones.size() + 2 * (ownCaptures + opponentCaptures);
+	position.recalculateHash();
+
+	state = position;
+	history.clear();
+	return true;
+}
+
+bool PiskvorkProtocol::playMove(const Move &move, std::vector<Move> *captured)
+{
+	if (!state.isValid(move.x, move.y))
+		return false;
+
+	history.push_back(state);
+	RuleEngine::MoveResult result = RuleEngine::applyMove(state, move);
+	if (!result.success)
+	{
+		history.pop_back();
+		return false;
+	}
+	if (captured)
+		*captured = result.myCapturedPieces;
+	return true;
+}
+
+// ============================================
+// Engine move
+// ============================================
+
+void PiskvorkProtocol::replyWithMove()
+{
+	ownPlayer = state.currentPlayer;
+	Move move = chooseMove();
+	std::vector<Move> captured;
+	if (!move.isValid() || !playMove(move, &captured))
+	{
+		reply("ERROR no legal move");
+		return;
+	}
+
+	if (!captured.empty())
+	{
+		std::string message = "MESSAGE CAPTURED";
+		for (const Move &stone : captured)
+			message += " " + formatMove(stone);
+		reply(message);
+	}
+	reply(formatMove(move));
+}
+
+Move PiskvorkProtocol::chooseMove()
+{
+	AI &engine = getAI();
+	engine.setTimeLimit(getMoveTimeLimit());
+	Move move = engine.findBestMoveIterative(state, maxDepth).bestMove;
+	if (move.isValid() && RuleEngine::isLegalMove(state, move))
+		return move;
+
+	return RuleEngine::findCentralLegalMove(state);
+}
+
+AI &PiskvorkProtocol::getAI()
+{
+	// Only the searching engine's table gets the budget; the Rust table is
+	// allocated on its first search, so it costs nothing when C++ plays
+	size_t tableMB = getTableSizeMB();
+	size_t cppTableMB = implementation == RUST_IMPLEMENTATION ? UNUSED_TABLE_MB : tableMB;
+	if (!ai)
+	{
+		ai.reset(new AI(maxDepth, implementation, cppTableMB));
+		if (implementation == RUST_IMPLEMENTATION)
+			ai->setTableSizes(cppTableMB, tableMB);
+		ai->setRustThreads(rustThreads);
+		aiTableMB = tableMB;
+	}
+	else if (tableMB != aiTableMB)
+	{
+		ai->setTableSizes(cppTableMB, tableMB);
+		aiTableMB = tableMB;
+	}
+	return *ai;
+}
+
+// ============================================
+// Limits
+// ============================================
+
+int PiskvorkProtocol::getMoveTimeLimit() const
+{
+	// timeout_turn 0: as fast as possible, depth 1 only
+	if (turnTimeoutMs == 0)
+		return 1;
+
+	int budget = turnTimeoutMs;
+	if (matchTimeoutMs > 0 && timeLeftMs >= 0)
+		budget = std::min(budget, timeLeftMs / MOVES_TO_GO);
+	budget -= std::min(SAFETY_MARGIN_MS, budget / 4);
+	return std::max(budget, 1);
+}
+
+/**
+ * Transposition table size (MB) of the searching engine for max_memory,
+ * 0 = engine default
+ */
+size_t PiskvorkProtocol::getTableSizeMB() const
+{
+	if (maxMemoryBytes == 0)
+		return 0;
+
+	long long megabytes = maxMemoryBytes / (1024 * 1024) - MEMORY_RESERVE_MB;
+	return (size_t)std::max(1LL, std::min(megabytes, (long long)TranspositionSearch::DEFAULT_TABLE_MB));
+}
+
+// ============================================
+// Helpers
+// ============================================
+
+void PiskvorkProtocol::reply(const std::string &line)
+{
+	out << line << std::endl;
+}
+
+// "a,b,c" or "a b c" -> {a, b, c}
+bool PiskvorkProtocol::parseCoordinates(const std::string &text, std::vector<int> &values)
+{
+	std::string spaced = text;
+	std::replace(spaced.begin(), spaced.end(), ',', ' ');
+	std::istringstream in(spaced);
+	values.clear();
+	int value;
+	while (in >> value)
+		values.push_back(value);
+	return in.eof() && !values.empty();
+}
+
+std::string PiskvorkProtocol::formatMove(const Move &move)
+{
+	return std::to_string(move.y) + "," + std::to_string(move.x);
+}
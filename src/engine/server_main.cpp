@@ -0,0 +1,77 @@
+// ============================================
+// SERVER_MAIN.CPP
+// gomoku-server: AnalysisServer on a Unix domain socket
+// Stops cleanly on SIGINT / SIGTERM
+// ============================================
+
+#include "../../include/engine/analysis_server.hpp"
+#include "../../include/core/game_types.hpp"
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+static AnalysisServer *g_server = nullptr;
+
+static void handleStopSignal(int)
+{
+	// stop() only stores an atomic flag
+	if (g_server)
+		g_server->stop();
+}
+
+int main(int argc, char **argv)
+{
+	AnalysisServer::Config config;
+	config.workers = std::max(1u, std::thread::hardware_concurrency());
+	std::string socketPath = "/tmp/gomoku.sock";
+
+	bool validArgs = true;
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (arg == "--socket" && hasValue)
+			socketPath = argv[++i];
+		else if (arg == "--workers" && hasValue)
+			config.workers = std::atoi(argv[++i]);
+		else if (arg == "--tt-mb" && hasValue)
+			config.tableMB = std::strtoul(argv[++i], nullptr, 10);
+		else if (arg == "--queue" && hasValue)
+			config.queueLimit = std::strtoul(argv[++i], nullptr, 10);
+		else if (arg == "--max-sessions" && hasValue)
+			config.maxSessions = std::strtoul(argv[++i], nullptr, 10);
+		else if (arg == "--rust")
+			config.implementation = RUST_IMPLEMENTATION;
+		else
+			validArgs = false;
+	}
+	if (!validArgs || config.workers < 1 || config.tableMB < 1 || config.queueLimit < 1 || config.maxSessions < 1)
+	{
+		std::cerr << "Usage: " << argv[0] << " [--socket PATH] [--workers N] [--tt-mb TOTAL]"
+				  << " [--queue N] [--max-sessions N] [--rust]" << std::endl;
+		return 2;
+	}
+
+	GameState::initializeHasher();
+	int status = 0;
+	{
+		AnalysisServer server(config);
+		g_server = &server;
+		std::signal(SIGINT, handleStopSignal);
+		std::signal(SIGTERM, handleStopSignal);
+
+		std::cerr << "gomoku-server: " << socketPath << ", " << config.workers << " workers, "
+				  << server.getTableMBPerWorker() << " MB table each, queue " << config.queueLimit << std::endl;
+		if (!server.serve(socketPath))
+			status = 1;
+
+		std::signal(SIGINT, SIG_DFL);
+		std::signal(SIGTERM, SIG_DFL);
+		g_server = nullptr;
+	}
+	GameState::cleanupHasher();
+	return status;
+}
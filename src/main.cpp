@@ -3,18 +3,33 @@
 #include "../include/core/game_types.hpp"
 #include "../include/debug/debug_analyzer.hpp"
 #include "../include/ai/suggestion_engine.hpp"
+#include "../include/ai/evaluator.hpp"
+#include "../include/utils/trace_recorder.hpp"
 #include <iostream>
 #include <chrono>
 #include <stdexcept>
 #include <new>
+#include <cstdlib>
+#include <string>
 
-int main()
+int main(int argc, char **argv)
 {
 	try
 	{
 	std::cout << "=== GOMOKU AI WITH ZOBRIST HASHING ===" << std::endl;
 	std::cout << "Initializing..." << std::endl;
 
+	// Optional Chrome trace (--trace <file> or GOMOKU_TRACE=<file>)
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::string(argv[i]) == "--trace" && i + 1 < argc)
+			TraceRecorder::start(argv[++i]);
+	}
+	if (!TraceRecorder::isEnabled())
+		TraceRecorder::startFromEnvironment();
+	if (TraceRecorder::isEnabled())
+		std::cout << "✓ Trace recording enabled" << std::endl;
+
 	// Inicialización del sistema
 	GameState::initializeHasher();
 
@@ -24,6 +39,33 @@ int main()
 	GameEngine game;
 	GuiRenderer renderer;
 
+	// Optional binary game records (--record <file> or GOMOKU_RECORD=<file>)
+	const char *recordFile = std::getenv("GOMOKU_RECORD");
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::string(argv[i]) == "--record" && i + 1 < argc)
+			recordFile = argv[++i];
+	}
+	if (recordFile && game.setGameRecordFile(recordFile))
+		std::cout << "✓ Game records: " << recordFile << std::endl;
+
+	// Optional NNUE evaluation for the C++ AI (--nnue <file> or GOMOKU_NNUE=<file>)
+	const char *networkFile = std::getenv("GOMOKU_NNUE");
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::string(argv[i]) == "--nnue" && i + 1 < argc)
+			networkFile = argv[++i];
+	}
+	if (networkFile && Evaluator::loadNetwork(networkFile))
+		std::cout << "✓ NNUE evaluation: " << networkFile << std::endl;
+
+	// Optional per-iteration search telemetry (JSON lines)
+	if (const char* statsFile = std::getenv("GOMOKU_SEARCH_STATS"))
+	{
+		game.setStatsLogFile(statsFile);
+		std::cout << "✓ Search stats: " << statsFile << std::endl;
+	}
+
 	std::cout << "✓ Game ready\n" << std::endl;
 
 	// Variables de control
@@ -32,6 +74,7 @@ int main()
 
 	while (renderer.isWindowOpen() && gameActive)
 	{
+		TRACE_SCOPE("frame", "gui");
 		renderer.processEvents();
 
 		switch (renderer.getState())
@@ -124,6 +167,10 @@ int main()
 				renderer.setState(GuiRenderer::GAME_OVER);
 				renderer.refreshSelectedMenuOption();
 				renderer.showGameResult(game.getWinner());
+
+				// Make sure the whole game is in gomoku_debug.log
+				if (g_debugAnalyzer)
+					g_debugAnalyzer->flushLog();
 				
 				int winner = game.getWinner();
 				if (winner == GameState::PLAYER1) {
@@ -251,6 +298,7 @@ int main()
 	
 	// Cleanup hasher
 	GameState::cleanupHasher();
+	TraceRecorder::writeAndStop();
 
 	std::cout << "Thanks for playing!" << std::endl;
 	return 0;
@@ -262,6 +310,7 @@ int main()
 			g_debugAnalyzer = nullptr;
 		}
 		GameState::cleanupHasher();
+		TraceRecorder::writeAndStop();
 		return 1;
 	} catch (const std::exception& e) {
 		std::cerr << "Error: " << e.what() << std::endl;
@@ -270,6 +319,7 @@ int main()
 			g_debugAnalyzer = nullptr;
 		}
 		GameState::cleanupHasher();
+		TraceRecorder::writeAndStop();
 		return 1;
 	} catch (...) {
 		std::cerr << "Error: Unknown exception occurred" << std::endl;
@@ -278,6 +328,7 @@ int main()
 			g_debugAnalyzer = nullptr;
 		}
 		GameState::cleanupHasher();
+		TraceRecorder::writeAndStop();
 		return 1;
 	}
 }
@@ -9,35 +9,38 @@
 
 using namespace Directions;
 
+/**
+ * Does `player` capture the pair next to `move` along (dx, dy)
+ * (move-OPP-OPP-MINE)? Reads the bits of the direction's line: past the
+ * board edge there is no bit, so the pattern cannot match there.
+ */
+static bool capturesAlong(const GameState &state, const Move &move, int player, int dx, int dy)
+{
+	int main = Board::mainDirection(dx, dy);
+	const BoardLines::Point &point = Board::point(move.x, move.y, main);
+	uint32_t opp = state.board.stones(point.line, state.getOpponent(player));
+	uint32_t own = state.board.stones(point.line, player);
+	int bit = point.bit;
+
+	if (dx == MAIN[main][0] && dy == MAIN[main][1])
+		return ((opp >> (bit + 1)) & 3) == 3 && ((own >> (bit + 3)) & 1);
+	return bit >= 3 && ((opp >> (bit - 2)) & 3) == 3 && ((own >> (bit - 3)) & 1);
+}
+
 RuleEngine::CaptureInfo RuleEngine::findAllCaptures(const GameState &state, const Move &move, int player)
 {
     CaptureInfo info;
-    int opponent = state.getOpponent(player);
 
     // Search all 8 directions for captures by the current player (X-O-O-X)
     for (int d = 0; d < ALL_COUNT; d++)
     {
-        int dx = ALL[d][0];
-        int dy = ALL[d][1];
-
         // Pattern: move-OPP-OPP-MINE
         // All 8 directions cover both directions of each axis,
         // so a single forward pattern is sufficient.
-        Move opp1(move.x + dx, move.y + dy);
-        Move opp2(move.x + 2 * dx, move.y + 2 * dy);
-        Move myOther(move.x + 3 * dx, move.y + 3 * dy);
-
-        if (state.isValid(opp1.x, opp1.y) && 
-            state.isValid(opp2.x, opp2.y) && 
-            state.isValid(myOther.x, myOther.y))
+        if (capturesAlong(state, move, player, ALL[d][0], ALL[d][1]))
         {
-            if (state.getPiece(opp1.x, opp1.y) == opponent &&
-                state.getPiece(opp2.x, opp2.y) == opponent &&
-                state.getPiece(myOther.x, myOther.y) == player)
-            {
-                info.myCapturedPieces.push_back(opp1);
-                info.myCapturedPieces.push_back(opp2);
-            }
+            info.myCapturedPieces.push_back(Move(move.x + ALL[d][0], move.y + ALL[d][1]));
+            info.myCapturedPieces.push_back(Move(move.x + 2 * ALL[d][0], move.y + 2 * ALL[d][1]));
         }
     }
 
@@ -67,25 +70,12 @@ std::vector<Move> RuleEngine::findCapturesInDirection(const GameState &state,
 													  int dx, int dy)
 {
 	std::vector<Move> captures;
-	int opponent = state.getOpponent(player);
 
 	// Patrón: PLAYER + OPPONENT + OPPONENT + PLAYER
-	Move pos1(move.x + dx, move.y + dy);
-	Move pos2(move.x + 2 * dx, move.y + 2 * dy);
-	Move pos3(move.x + 3 * dx, move.y + 3 * dy);
-
-	if (state.isValid(pos1.x, pos1.y) && state.isValid(pos2.x, pos2.y) &&
-		state.isValid(pos3.x, pos3.y))
+	if (capturesAlong(state, move, player, dx, dy))
 	{
-
-		if (state.getPiece(pos1.x, pos1.y) == opponent &&
-			state.getPiece(pos2.x, pos2.y) == opponent &&
-			state.getPiece(pos3.x, pos3.y) == player)
-		{
-
-			captures.push_back(pos1);
-			captures.push_back(pos2);
-		}
+		captures.push_back(Move(move.x + dx, move.y + dy));
+		captures.push_back(Move(move.x + 2 * dx, move.y + 2 * dy));
 	}
 
 	return captures;
@@ -160,18 +150,16 @@ bool RuleEngine::opponentCanCaptureNextTurn(
     const GameState &state, 
     int opponent
 ) {
-    // Try each empty cell
-    for (int i = 0; i < GameState::BOARD_SIZE; i++) {
-        for (int j = 0; j < GameState::BOARD_SIZE; j++) {
-            if (state.isEmpty(i, j)) {
-                Move testMove(i, j);
-                
-                // Does this move create captures?
-                auto captures = findCaptures(state, testMove, opponent);
-                if (!captures.empty()) {
-                    return true;  // Opponent can capture on the next turn
-                }
-            }
+    // An empty cell, two stones of the other player then one of
+    // `opponent`, or the same mirrored, on any line
+    int victim = state.getOpponent(opponent);
+    for (int line = 0; line < BoardLines::COUNT; line++) {
+        uint32_t empty = state.board.empty(line);
+        uint32_t pairs = state.board.stones(line, victim);
+        pairs &= pairs >> 1;
+        uint32_t capturer = state.board.stones(line, opponent);
+        if ((empty & (pairs >> 1) & (capturer >> 3)) || (capturer & (pairs >> 1) & (empty >> 3))) {
+            return true;  // Opponent can capture on the next turn
         }
     }
     
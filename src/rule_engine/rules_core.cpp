@@ -6,10 +6,14 @@
 
 #include "../../include/rules/rule_engine.hpp"
 #include "../../include/utils/zobrist_hasher.hpp"
+#include "../../include/utils/profiler.hpp"
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
 
 RuleEngine::MoveResult RuleEngine::applyMove(GameState &state, const Move &move)
 {
+    PROFILE_SCOPE(APPLY_MOVE);
     MoveResult result;
 
     // 1. Verify the move is valid
@@ -27,6 +31,7 @@ RuleEngine::MoveResult RuleEngine::applyMove(GameState &state, const Move &move)
     // Save state for Zobrist hash
     int oldMyCaptures = state.captures[state.currentPlayer - 1];
     int currentPlayer = state.currentPlayer;
+    uint32_t oldRevision = state.board.revision();
 
     // 3. Place the piece
     state.board[move.x][move.y] = state.currentPlayer;
@@ -49,8 +54,10 @@ RuleEngine::MoveResult RuleEngine::applyMove(GameState &state, const Move &move)
     // 6. Check for win
     result.createsWin = checkWin(state, state.currentPlayer);
 
-    // 7. Update Zobrist hash
+    // 7. Update Zobrist hash (and the NNUE accumulator keyed by it) and
+    // the threat map
     int newMyCaptures = state.captures[currentPlayer - 1];
+    uint64_t oldHash = state.zobristHash;
     
     if (state.hasher) {
         state.zobristHash = state.hasher->updateHashAfterMove(
@@ -65,6 +72,10 @@ RuleEngine::MoveResult RuleEngine::applyMove(GameState &state, const Move &move)
             state.captures[state.getOpponent(currentPlayer) - 1]  // Unchanged
         );
     }
+    if (GameState::network) {
+        state.updateNnueAfterMove(move, currentPlayer, result.myCapturedPieces, oldMyCaptures, oldHash);
+    }
+    state.updateThreatsAfterMove(move, result.myCapturedPieces, oldRevision);
 
     // 8. Advance turn
     state.currentPlayer = state.getOpponent(state.currentPlayer);
@@ -81,6 +92,26 @@ bool RuleEngine::isLegalMove(const GameState &state, const Move &move)
 	return !createsDoubleFreeThree(state, move, state.currentPlayer);
 }
 
+Move RuleEngine::findCentralLegalMove(const GameState &state)
+{
+	Move best;
+	int bestDistance = GameState::BOARD_SIZE;
+	for (int x = 0; x < GameState::BOARD_SIZE; x++)
+	{
+		for (int y = 0; y < GameState::BOARD_SIZE; y++)
+		{
+			int distance = std::max(std::abs(x - GameState::BOARD_CENTER),
+									std::abs(y - GameState::BOARD_CENTER));
+			if (distance < bestDistance && isLegalMove(state, Move(x, y)))
+			{
+				best = Move(x, y);
+				bestDistance = distance;
+			}
+		}
+	}
+	return best;
+}
+
 int RuleEngine::countInDirection(const GameState &state, const Move &start,
 								 int dx, int dy, int player)
 {
@@ -5,16 +5,16 @@
 // ============================================
 
 #include "../../include/rules/rule_engine.hpp"
+#include "../../include/utils/profiler.hpp"
 
 using namespace Directions;
 
 bool RuleEngine::createsDoubleFreeThree(const GameState &state, const Move &move, int player)
 {
-	// Create temporary copy for testing
-	GameState tempState = state;
-	tempState.board[move.x][move.y] = player;
+	PROFILE_SCOPE(DOUBLE_FREE_THREE);
 
-	auto freeThrees = findFreeThrees(tempState, move, player);
+	// isFreeThree counts the move as the player's stone: no board copy
+	auto freeThrees = findFreeThrees(state, move, player);
 	return freeThrees.size() >= 2;
 }
 
@@ -40,96 +40,52 @@ bool RuleEngine::isFreeThree(const GameState &state, const Move &move,
 	// A free-three is any pattern of 3 pieces in a window of 5 positions
 	// where both ends are free and a threat of 4 can be formed
 	// Includes patterns with gaps such as -XX-X- or -X-XX-
-	
-	// Search all windows of 5 positions containing the move
-	for (int offset = -4; offset <= 0; offset++)
-	{
-		Move windowStart(move.x + offset * dx, move.y + offset * dy);
-		
-		// Verify the window of 5 is within the board
-		bool validWindow = true;
-		for (int i = 0; i < 5; i++)
-		{
-			Move pos(windowStart.x + i * dx, windowStart.y + i * dy);
-			if (!state.isValid(pos.x, pos.y))
-			{
-				validWindow = false;
-				break;
-			}
-		}
-		
-		if (!validWindow) continue;
-		
-		// Verify the move is within this window
-		bool moveInWindow = false;
-		for (int i = 0; i < 5; i++)
-		{
-			Move pos(windowStart.x + i * dx, windowStart.y + i * dy);
-			if (pos.x == move.x && pos.y == move.y)
-			{
-				moveInWindow = true;
-				break;
-			}
-		}
-		
-		if (!moveInWindow) continue;
-		
-		// Create array of window states
-		int windowState[5];
-		for (int i = 0; i < 5; i++)
-		{
-			Move pos(windowStart.x + i * dx, windowStart.y + i * dy);
-			
-			if (pos.x == move.x && pos.y == move.y)
-			{
-				windowState[i] = player; // El movimiento cuenta como ficha del jugador
-			}
-			else
-			{
-				windowState[i] = state.getPiece(pos.x, pos.y);
-			}
-		}
-		
-		// Count player and opponent pieces
-		int playerPieces = 0;
-		int opponentPieces = 0;
-		int emptySpaces = 0;
-		
-		for (int i = 0; i < 5; i++)
+
+	// Bit w set: the 5-cell window whose own stones are the bits of w is
+	// a valid free-three pattern (isValidFreeThreePattern on every window)
+	static const uint32_t validWindows = [] {
+		uint32_t windows = 0;
+		for (uint32_t w = 0; w < 32; w++)
 		{
-			if (windowState[i] == player)
-				playerPieces++;
-			else if (windowState[i] == state.getOpponent(player))
-				opponentPieces++;
-			else
-				emptySpaces++;
+			int windowState[5];
+			for (int i = 0; i < 5; i++)
+				windowState[i] = (w >> i) & 1 ? GameState::PLAYER1 : GameState::EMPTY;
+			if (__builtin_popcount(w) == 3 && isValidFreeThreePattern(windowState, GameState::PLAYER1))
+				windows |= 1u << w;
 		}
-		
+		return windows;
+	}();
+
+	// The move counts as a player's stone whatever its cell holds
+	const BoardLines::Point &point = Board::point(move.x, move.y, Board::mainDirection(dx, dy));
+	uint32_t own = state.board.stones(point.line, player) | (1u << point.bit);
+	uint32_t opponent = state.board.stones(point.line, state.getOpponent(player));
+	uint32_t empty = state.board.empty(point.line) & ~own;
+	uint32_t cells = BOARD_LINES.cells[point.line];
+
+	// Search all windows of 5 positions containing the move; the pattern
+	// table is symmetric, so the direction's sign does not matter
+	int first = point.bit >= 4 ? point.bit - 4 : 0;
+	for (int start = first; start <= point.bit; start++)
+	{
+		// Verify the window of 5 is within the board
+		if (((cells >> start) & 31) != 31)
+			continue;
+
 		// Free-three requires: exactly 3 player pieces, 0 opponent pieces, 2 empty spaces
-		if (playerPieces == 3 && opponentPieces == 0 && emptySpaces == 2)
-		{
-			// Verify both ends are free
-			Move leftExtreme(windowStart.x - dx, windowStart.y - dy);
-			Move rightExtreme(windowStart.x + 5 * dx, windowStart.y + 5 * dy);
-			
-			bool leftFree = state.isValid(leftExtreme.x, leftExtreme.y) && 
-							state.isEmpty(leftExtreme.x, leftExtreme.y);
-			bool rightFree = state.isValid(rightExtreme.x, rightExtreme.y) && 
-							 state.isEmpty(rightExtreme.x, rightExtreme.y);
-			
-			// Both ends must be free to qualify as "free"
-			if (leftFree && rightFree)
-			{
-				// Verify it's a valid free-three pattern
-				// Must be possible to form four consecutive by filling the spaces
-				if (isValidFreeThreePattern(windowState, player))
-				{
-					return true;
-				}
-			}
-		}
+		uint32_t window = (own >> start) & 31;
+		if (((opponent >> start) & 31) || __builtin_popcount(window) != 3)
+			continue;
+
+		// Both ends must be free to qualify as "free"
+		bool leftFree = start > 0 && ((empty >> (start - 1)) & 1);
+		bool rightFree = (empty >> (start + 5)) & 1;
+
+		// Must be possible to form four consecutive by filling the spaces
+		if (leftFree && rightFree && ((validWindows >> window) & 1))
+			return true;
 	}
-	
+
 	return false;
 }
 
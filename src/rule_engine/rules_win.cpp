@@ -19,45 +19,46 @@ bool RuleEngine::checkWin(const GameState &state, int player)
         return true;
     }
 
-    // 2. Win by five in a row (with verification)
-    for (int i = 0; i < GameState::BOARD_SIZE; i++) {
-        for (int j = 0; j < GameState::BOARD_SIZE; j++) {
-            if (state.board[i][j] == player) {
-                Move pos(i, j);
-                
-                // Check for a line of 5 in each direction
-                for (int d = 0; d < MAIN_COUNT; d++) {
-                    int dx = MAIN[d][0];
-                    int dy = MAIN[d][1];
-                    
-                    if (checkLineWinInDirection(state, pos, dx, dy, player)) {
-                        // Found a line of 5
-                        
-                        // Verification 1: Can the opponent break it via capture?
-                        // This will be handled by the game engine setting forced captures
-                        std::vector<Move> captureMoves;
-                        bool canBreak = canBreakLineByCapture(state, pos, dx, dy, player, &captureMoves);
-                        
-                        if (canBreak) {
-                            // NOTE: The game engine will handle setting forced captures
-                            // For now, we treat this as "not a win yet"
-                            continue;
-                        }
-                        
-                        // Verification 2: Is the winning player at risk of losing by capture?
-                        if (state.captures[opponent - 1] >= 8) {
-                            // 4+ pairs captured against the winning player
-                            // Can the opponent capture one more?
-                            if (opponentCanCaptureNextTurn(state, opponent)) {
-                                return false;  // No win, opponent can win by capture
-                            }
-                        }
-                        
-                        // If we reach here, it's a legitimate win
-                        return true;
-                    }
+    // 2. Win by five in a row (with verification), from the line bitsets:
+    // each run of 5+ is checked once, from its first stone
+    for (int line = 0; line < BoardLines::COUNT; line++) {
+        uint32_t own = state.board.stones(line, player);
+        uint32_t fives = own & (own >> 1) & (own >> 2) & (own >> 3) & (own >> 4);
+        uint32_t starts = fives & ~(own << 1);
+        int d = BOARD_LINES.direction[line];
+        int dx = MAIN[d][0];
+        int dy = MAIN[d][1];
+        
+        while (starts) {
+            int bit = __builtin_ctz(starts);
+            starts &= starts - 1;
+            Move pos;
+            Board::cellAt(line, bit, pos.x, pos.y);
+            
+            // Found a line of 5
+            
+            // Verification 1: Can the opponent break it via capture?
+            // This will be handled by the game engine setting forced captures
+            std::vector<Move> captureMoves;
+            bool canBreak = canBreakLineByCapture(state, pos, dx, dy, player, &captureMoves);
+            
+            if (canBreak) {
+                // NOTE: The game engine will handle setting forced captures
+                // For now, we treat this as "not a win yet"
+                continue;
+            }
+            
+            // Verification 2: Is the winning player at risk of losing by capture?
+            if (state.captures[opponent - 1] >= 8) {
+                // 4+ pairs captured against the winning player
+                // Can the opponent capture one more?
+                if (opponentCanCaptureNextTurn(state, opponent)) {
+                    return false;  // No win, opponent can win by capture
                 }
             }
+            
+            // If we reach here, it's a legitimate win
+            return true;
         }
     }
 
@@ -69,17 +70,10 @@ bool RuleEngine::hasFiveInARow(const GameState &state, int player)
 	// Pure line-of-5 check — ignores capture break rule.
 	// This is critical for the AI search: checkWin() returns false
 	// for breakable 5-in-a-row, making them invisible to the search.
-	for (int i = 0; i < GameState::BOARD_SIZE; i++) {
-		for (int j = 0; j < GameState::BOARD_SIZE; j++) {
-			if (state.board[i][j] != player)
-				continue;
-			for (int d = 0; d < MAIN_COUNT; d++) {
-				int dx = MAIN[d][0];
-				int dy = MAIN[d][1];
-				if (checkLineWinInDirection(state, Move(i, j), dx, dy, player))
-					return true;
-			}
-		}
+	for (int line = 0; line < BoardLines::COUNT; line++) {
+		uint32_t own = state.board.stones(line, player);
+		if (own & (own >> 1) & (own >> 2) & (own >> 3) & (own >> 4))
+			return true;
 	}
 	return false;
 }
@@ -110,24 +104,20 @@ bool RuleEngine::checkLineWinInDirection(const GameState &state, const Move &sta
     
     // Only count if 'start' is the actual beginning of the line
     // (to avoid counting the same line multiple times)
+    int d = Board::mainDirection(dx, dy);
+    const BoardLines::Point &point = Board::point(start.x, start.y, d);
+    uint32_t own = state.board.stones(point.line, player);
+    int bit = point.bit;
     
-    // Verify there is no piece of the same player before start
-    Move before(start.x - dx, start.y - dy);
-    if (state.isValid(before.x, before.y) && state.getPiece(before.x, before.y) == player) {
-        return false;  // Not the actual start of the line
-    }
-    
-    // Count consecutive pieces from start
-    int count = 1;  // The piece at 'start'
-    Move current(start.x + dx, start.y + dy);
-    
-    while (state.isValid(current.x, current.y) && 
-           state.getPiece(current.x, current.y) == player) {
-        count++;
-        current.x += dx;
-        current.y += dy;
+    if (dx == MAIN[d][0] && dy == MAIN[d][1]) {
+        // Along the line: no own stone on the bit before, 4 on the next
+        if (bit > 0 && ((own >> (bit - 1)) & 1))
+            return false;  // Not the actual start of the line
+        return ((own >> (bit + 1)) & 15) == 15;
     }
     
-    // Are there 5 or more?
-    return (count >= 5);
+    // Against it: the same, mirrored
+    if ((own >> (bit + 1)) & 1)
+        return false;
+    return bit >= 4 && ((own >> (bit - 4)) & 15) == 15;
 }
@@ -0,0 +1,276 @@
+// ============================================
+// GAME_RECORD.CPP
+// Binary game record writer and streaming reader
+// ============================================
+
+#include "../../include/utils/game_record.hpp"
+#include "../../include/rules/rule_engine.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+static const char MAGIC[4] = {'G', 'M', 'K', 'R'};
+static const uint8_t FORMAT_VERSION = 1;
+static const size_t HEADER_BYTES = 8;
+
+static const uint16_t GAME_START = 0xFFFF;
+static const uint16_t GAME_END = 0xFFF0; // | result (0-3)
+static const uint16_t CELL_MASK = 0x01FF;
+static const uint16_t MOVE_MASK = CELL_MASK | RecordedMove::CAPTURED | RecordedMove::FORCED_CAPTURE;
+
+static const int CELLS = GameState::BOARD_SIZE * GameState::BOARD_SIZE;
+
+// ============================================
+// Writer
+// ============================================
+
+bool GameRecordWriter::open(const std::string &filename)
+{
+	close();
+
+	// An existing file must already be a record file
+	std::ifstream existing(filename, std::ios::binary | std::ios::ate);
+	bool empty = !existing.is_open() || existing.tellg() <= 0;
+	if (!empty)
+	{
+		char header[HEADER_BYTES];
+		existing.seekg(0);
+		if (!existing.read(header, HEADER_BYTES) || std::memcmp(header, MAGIC, 4) != 0 ||
+			(uint8_t)header[4] != FORMAT_VERSION || (uint8_t)header[5] != GameState::BOARD_SIZE)
+		{
+			std::cerr << "Warning: " << filename << " is not a game record file" << std::endl;
+			return false;
+		}
+	}
+	existing.close();
+
+	file.open(filename, std::ios::binary | std::ios::app);
+	if (!file.is_open())
+	{
+		std::cerr << "Warning: Could not open game record file " << filename << std::endl;
+		return false;
+	}
+	buffer.reserve(BUFFER_BYTES);
+	if (empty)
+	{
+		buffer.insert(buffer.end(), MAGIC, MAGIC + 4);
+		buffer.push_back(FORMAT_VERSION);
+		buffer.push_back((uint8_t)GameState::BOARD_SIZE);
+		buffer.push_back(0);
+		buffer.push_back(0);
+	}
+	return true;
+}
+
+void GameRecordWriter::close()
+{
+	if (!file.is_open())
+		return;
+	if (gameOpen)
+		endGame(GameRecord::UNFINISHED);
+	flush();
+	file.close();
+}
+
+void GameRecordWriter::beginGame()
+{
+	if (gameOpen)
+		endGame(GameRecord::UNFINISHED);
+	writeWord(GAME_START);
+	gameOpen = true;
+}
+
+void GameRecordWriter::recordMove(const RecordedMove &move)
+{
+	if (!gameOpen)
+		beginGame();
+	uint16_t cell = (uint16_t)(move.move.x * GameState::BOARD_SIZE + move.move.y);
+	writeWord(cell | (move.flags & (RecordedMove::CAPTURED | RecordedMove::FORCED_CAPTURE)));
+}
+
+void GameRecordWriter::endGame(int result)
+{
+	if (!gameOpen)
+		return;
+	writeWord(GAME_END | (uint16_t)(result & 3));
+	gameOpen = false;
+}
+
+void GameRecordWriter::writeGame(const GameRecord &game)
+{
+	beginGame();
+	for (const RecordedMove &move : game.moves)
+		recordMove(move);
+	endGame(game.result);
+}
+
+void GameRecordWriter::flush()
+{
+	if (!file.is_open() || buffer.empty())
+		return;
+	file.write((const char *)buffer.data(), buffer.size());
+	file.flush();
+	buffer.clear();
+}
+
+void GameRecordWriter::writeWord(uint16_t word)
+{
+	if (!file.is_open())
+		return;
+	buffer.push_back((uint8_t)(word & 0xFF));
+	buffer.push_back((uint8_t)(word >> 8));
+	if (buffer.size() >= BUFFER_BYTES)
+		flush();
+}
+
+// ============================================
+// Reader
+// ============================================
+
+bool GameRecordReader::open(const std::string &filename)
+{
+	file.close();
+	file.clear();
+	buffer.clear();
+	position = 0;
+	failed = false;
+
+	file.open(filename, std::ios::binary);
+	if (!file.is_open())
+	{
+		std::cerr << "Error: Could not open game record file " << filename << std::endl;
+		failed = true;
+		return false;
+	}
+	char header[HEADER_BYTES];
+	if (!file.read(header, HEADER_BYTES) || std::memcmp(header, MAGIC, 4) != 0 ||
+		(uint8_t)header[4] != FORMAT_VERSION || (uint8_t)header[5] != GameState::BOARD_SIZE)
+	{
+		std::cerr << "Error: " << filename << " is not a game record file" << std::endl;
+		failed = true;
+		return false;
+	}
+	buffer.reserve(BUFFER_BYTES);
+	return true;
+}
+
+bool GameRecordReader::readWord(uint16_t &word)
+{
+	if (buffer.size() - position < 2)
+	{
+		// Keep a dangling odd byte, refill behind it
+		buffer.erase(buffer.begin(), buffer.begin() + position);
+		position = 0;
+		size_t kept = buffer.size();
+		buffer.resize(BUFFER_BYTES);
+		file.read((char *)buffer.data() + kept, BUFFER_BYTES - kept);
+		buffer.resize(kept + (size_t)file.gcount());
+		if (buffer.size() < 2)
+			return false;
+	}
+	word = (uint16_t)(buffer[position] | (buffer[position + 1] << 8));
+	position += 2;
+	return true;
+}
+
+bool GameRecordReader::next(GameRecord &game)
+{
+	game.clear();
+	if (failed || !file.is_open())
+		return false;
+
+	uint16_t word;
+	if (!readWord(word))
+		return false; // Clean end of file
+	if (word != GAME_START)
+	{
+		failed = true;
+		return false;
+	}
+
+	while (readWord(word))
+	{
+		if ((word & 0xFFF0) == GAME_END && (word & 0x000F) <= GameRecord::DRAW)
+		{
+			game.result = word & 0x000F;
+			return true;
+		}
+		int cell = word & CELL_MASK;
+		if ((word & ~MOVE_MASK) != 0 || cell >= CELLS)
+		{
+			failed = true;
+			return false;
+		}
+		game.moves.push_back(RecordedMove(Move(cell / GameState::BOARD_SIZE, cell % GameState::BOARD_SIZE),
+										  word & ~CELL_MASK));
+	}
+	return true; // Truncated: the moves written so far
+}
+
+// ============================================
+// Replay
+// ============================================
+
+bool GameRecordReader::applyMove(GameState &state, const RecordedMove &move)
+{
+	RuleEngine::MoveResult result = RuleEngine::applyMove(state, move.move);
+	if (!result.success)
+		return false;
+	return result.myCapturedPieces.empty() == !(move.flags & RecordedMove::CAPTURED);
+}
+
+bool GameRecordReader::replay(const GameRecord &game, GameState &state, size_t plies)
+{
+	state = GameState();
+	size_t count = std::min(plies, game.moves.size());
+	for (size_t i = 0; i < count; i++)
+	{
+		if (!applyMove(state, game.moves[i]))
+			return false;
+	}
+	return true;
+}
+
+// ============================================
+// Piskvork .psq
+// ============================================
+
+bool GameRecordReader::readPsq(std::istream &in, GameRecord &game)
+{
+	game.clear();
+	std::string line;
+	if (!std::getline(in, line) || line.compare(0, 9, "Piskvorky") != 0)
+		return false;
+	// "19x19," or "19x19"
+	std::istringstream header(line.substr(9));
+	std::string size, expected = std::to_string(GameState::BOARD_SIZE) + "x" + std::to_string(GameState::BOARD_SIZE);
+	if (!(header >> size) || size.compare(0, expected.size(), expected) != 0 ||
+		(size.size() > expected.size() && size[expected.size()] != ','))
+		return false;
+
+	GameState state;
+	while (std::getline(in, line))
+	{
+		std::replace(line.begin(), line.end(), ',', ' ');
+		std::istringstream fields(line);
+		int column, row;
+		if (!(fields >> column >> row))
+			break; // Trailer: "-1", engine names, ...
+
+		Move move(row - 1, column - 1);
+		int player = state.currentPlayer;
+		if (!state.isValid(move.x, move.y))
+			return false;
+		RuleEngine::MoveResult result = RuleEngine::applyMove(state, move);
+		if (!result.success)
+			return false;
+		game.moves.push_back(RecordedMove(move, result.myCapturedPieces.empty() ? 0 : RecordedMove::CAPTURED));
+		if (RuleEngine::checkWin(state, player))
+		{
+			game.result = player == GameState::PLAYER1 ? GameRecord::PLAYER1_WINS : GameRecord::PLAYER2_WINS;
+			break;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,112 @@
+// ============================================
+// POSITION_IO.CPP
+// Text serialization of board positions
+// ============================================
+
+#include "../../include/utils/position_io.hpp"
+#include <sstream>
+
+bool PositionIO::parseBoard(const std::string &text, GameState &state)
+{
+	for (int i = 0; i < GameState::BOARD_SIZE; i++)
+		for (int j = 0; j < GameState::BOARD_SIZE; j++)
+			state.board[i][j] = GameState::EMPTY;
+
+	int x = 0, y = 0;
+	for (size_t i = 0; i < text.size(); i++)
+	{
+		char c = text[i];
+		if (c == '/')
+		{
+			if (y != GameState::BOARD_SIZE)
+				return false;
+			x++;
+			y = 0;
+		}
+		else if (c >= '0' && c <= '9')
+		{
+			int run = 0;
+			while (i < text.size() && text[i] >= '0' && text[i] <= '9')
+				run = run * 10 + (text[i++] - '0');
+			i--;
+			y += run;
+		}
+		else if (c == 'X' || c == 'O')
+		{
+			if (x >= GameState::BOARD_SIZE || y >= GameState::BOARD_SIZE)
+				return false;
+			state.board[x][y++] = (c == 'X') ? GameState::PLAYER1 : GameState::PLAYER2;
+		}
+		else
+		{
+			return false;
+		}
+		if (y > GameState::BOARD_SIZE)
+			return false;
+	}
+	return x == GameState::BOARD_SIZE - 1 && y == GameState::BOARD_SIZE;
+}
+
+std::string PositionIO::formatBoard(const GameState &state)
+{
+	std::ostringstream out;
+	for (int x = 0; x < GameState::BOARD_SIZE; x++)
+	{
+		if (x > 0)
+			out << '/';
+		int run = 0;
+		for (int y = 0; y < GameState::BOARD_SIZE; y++)
+		{
+			int piece = state.board[x][y];
+			if (piece == GameState::EMPTY)
+			{
+				run++;
+				continue;
+			}
+			if (run > 0)
+				out << run;
+			run = 0;
+			out << (piece == GameState::PLAYER1 ? 'X' : 'O');
+		}
+		if (run > 0)
+			out << run;
+	}
+	return out.str();
+}
+
+bool PositionIO::read(std::istream &in, GameState &state)
+{
+	std::string side, board;
+	int capturesX, capturesO;
+	if (!(in >> side >> capturesX >> capturesO >> board))
+		return false;
+	if ((side != "X" && side != "O") ||
+		capturesX < 0 || capturesX > GameState::WIN_CAPTURES_NORMAL ||
+		capturesO < 0 || capturesO > GameState::WIN_CAPTURES_NORMAL)
+		return false;
+
+	state = GameState();
+	if (!parseBoard(board, state))
+		return false;
+
+	int stones = 0;
+	for (int i = 0; i < GameState::BOARD_SIZE; i++)
+		for (int j = 0; j < GameState::BOARD_SIZE; j++)
+			stones += state.board[i][j] != GameState::EMPTY;
+
+	state.currentPlayer = (side == "X") ? GameState::PLAYER1 : GameState::PLAYER2;
+	state.captures[0] = capturesX;
+	state.captures[1] = capturesO;
+	state.turnCount = stones + 2 * (capturesX + capturesO);
+	if (GameState::hasher)
+		state.recalculateHash();
+	return true;
+}
+
+std::string PositionIO::format(const GameState &state)
+{
+	std::ostringstream out;
+	out << (state.currentPlayer == GameState::PLAYER1 ? 'X' : 'O') << ' '
+		<< state.captures[0] << ' ' << state.captures[1] << ' ' << formatBoard(state);
+	return out.str();
+}
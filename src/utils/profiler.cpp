@@ -0,0 +1,65 @@
+// ============================================
+// PROFILER.CPP
+// Per-thread cycle accumulators and flat profile report
+// ============================================
+
+#include "../../include/utils/profiler.hpp"
+#include <iomanip>
+#include <sstream>
+
+thread_local Profiler::Counter Profiler::counters[Profiler::SECTION_COUNT] = {};
+
+const char *Profiler::getSectionName(Section section)
+{
+	switch (section)
+	{
+	case SEARCH:
+		return "search (total)";
+	case EVALUATE:
+		return "evaluate";
+	case APPLY_MOVE:
+		return "applyMove";
+	case DOUBLE_FREE_THREE:
+		return "createsDoubleFreeThree";
+	case GENERATE_CANDIDATES:
+		return "generateCandidates";
+	case ORDER_MOVES:
+		return "orderMoves";
+	default:
+		return "unknown";
+	}
+}
+
+void Profiler::report(std::ostream &out)
+{
+	uint64_t total = counters[SEARCH].cycles;
+
+	// Formatted locally so the caller's stream flags stay untouched
+	std::ostringstream table;
+	table << "=== FLAT PROFILE (inclusive) ===\n";
+	table << std::left << std::setw(24) << "section"
+		<< std::right << std::setw(12) << "calls"
+		<< std::setw(16) << "cycles"
+		<< std::setw(14) << "cycles/call"
+		<< std::setw(9) << "%" << "\n";
+
+	for (int s = 0; s < SECTION_COUNT; s++)
+	{
+		const Counter &counter = counters[s];
+		double perCall = counter.calls > 0 ? (double)counter.cycles / counter.calls : 0.0;
+		double percent = total > 0 ? 100.0 * counter.cycles / total : 0.0;
+
+		table << std::left << std::setw(24) << getSectionName((Section)s)
+			<< std::right << std::setw(12) << counter.calls
+			<< std::setw(16) << counter.cycles
+			<< std::setw(14) << std::fixed << std::setprecision(0) << perCall
+			<< std::setw(8) << std::setprecision(1) << percent << "%\n";
+	}
+	out << table.str() << std::flush;
+}
+
+void Profiler::reset()
+{
+	for (int s = 0; s < SECTION_COUNT; s++)
+		counters[s] = Counter{0, 0};
+}
@@ -0,0 +1,129 @@
+// ============================================
+// TRACE_RECORDER.CPP
+// Per-thread trace buffers and Chrome trace_event JSON output
+// ============================================
+
+#include "../../include/utils/trace_recorder.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+std::atomic<bool> TraceRecorder::enabled(false);
+std::mutex TraceRecorder::registryMutex;
+std::vector<std::unique_ptr<TraceRecorder::ThreadBuffer>> TraceRecorder::buffers;
+std::string TraceRecorder::outputFile;
+uint64_t TraceRecorder::originNs = 0;
+
+uint64_t TraceRecorder::nowNanos()
+{
+	return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+			   std::chrono::steady_clock::now().time_since_epoch())
+		.count();
+}
+
+void TraceRecorder::start(const std::string &filename)
+{
+	std::lock_guard<std::mutex> lock(registryMutex);
+	outputFile = filename;
+	originNs = nowNanos();
+	for (auto &buffer : buffers)
+		buffer->events.clear();
+	enabled.store(true, std::memory_order_release);
+}
+
+bool TraceRecorder::startFromEnvironment()
+{
+	const char *path = std::getenv("GOMOKU_TRACE");
+	if (!path || !*path)
+		return false;
+	start(path);
+	return true;
+}
+
+TraceRecorder::ThreadBuffer &TraceRecorder::localBuffer()
+{
+	// Buffers are owned by the registry so they outlive their threads
+	thread_local ThreadBuffer *buffer = nullptr;
+	if (!buffer)
+	{
+		std::lock_guard<std::mutex> lock(registryMutex);
+		buffers.emplace_back(new ThreadBuffer());
+		buffer = buffers.back().get();
+		buffer->tid = (int)buffers.size();
+		buffer->threadName = buffer->tid == 1 ? "main" : "thread " + std::to_string(buffer->tid);
+		buffer->events.reserve(4096);
+	}
+	return *buffer;
+}
+
+void TraceRecorder::setThreadName(const std::string &name)
+{
+	localBuffer().threadName = name;
+}
+
+void TraceRecorder::recordComplete(const char *name, const char *category,
+								   uint64_t startNs, uint64_t endNs, std::string args)
+{
+	if (!isEnabled())
+		return;
+	localBuffer().events.push_back(Event{name, category, startNs, endNs - startNs, std::move(args)});
+}
+
+size_t TraceRecorder::getEventCount()
+{
+	std::lock_guard<std::mutex> lock(registryMutex);
+	size_t count = 0;
+	for (const auto &buffer : buffers)
+		count += buffer->events.size();
+	return count;
+}
+
+static void writeMicros(std::ostream &out, uint64_t ns)
+{
+	char text[32];
+	std::snprintf(text, sizeof(text), "%llu.%03llu",
+				  (unsigned long long)(ns / 1000), (unsigned long long)(ns % 1000));
+	out << text;
+}
+
+bool TraceRecorder::writeAndStop()
+{
+	if (!enabled.exchange(false))
+		return false;
+
+	std::lock_guard<std::mutex> lock(registryMutex);
+	std::ofstream out(outputFile);
+	if (!out.is_open())
+	{
+		std::cerr << "Warning: Could not write trace file " << outputFile << std::endl;
+		return false;
+	}
+
+	out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	bool first = true;
+	for (const auto &buffer : buffers)
+	{
+		out << (first ? "" : ",\n")
+			<< "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->tid
+			<< ",\"args\":{\"name\":\"" << buffer->threadName << "\"}}";
+		first = false;
+
+		for (const Event &event : buffer->events)
+		{
+			uint64_t relativeStart = event.startNs >= originNs ? event.startNs - originNs : 0;
+			out << ",\n{\"name\":\"" << event.name << "\",\"cat\":\"" << event.category
+				<< "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->tid << ",\"ts\":";
+			writeMicros(out, relativeStart);
+			out << ",\"dur\":";
+			writeMicros(out, event.durationNs);
+			if (!event.args.empty())
+				out << ",\"args\":{" << event.args << "}";
+			out << "}";
+		}
+		buffer->events.clear();
+	}
+	out << "\n]}\n";
+	return true;
+}
@@ -0,0 +1,207 @@
+// ============================================
+// TRAINING_DATA.CPP
+// Packed training positions and sharded writer / reader
+// ============================================
+
+#include "../../include/utils/training_data.hpp"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+static const char MAGIC[4] = {'G', 'M', 'K', 'P'};
+static const uint8_t FORMAT_VERSION = 1;
+static const size_t HEADER_BYTES = 8;
+
+static const int CELLS = GameState::BOARD_SIZE * GameState::BOARD_SIZE;
+static const size_t CAPTURES_OFFSET = 91;
+static const size_t FLAGS_OFFSET = 93;
+static const size_t SCORE_OFFSET = 94;
+
+// ============================================
+// PackedPosition
+// ============================================
+
+PackedPosition PackedPosition::pack(const GameState &state, int score, int result)
+{
+	PackedPosition packed;
+	std::memset(packed.bytes, 0, PACKED_BYTES);
+	for (int cell = 0; cell < CELLS; cell++)
+	{
+		int piece = state.board[cell / GameState::BOARD_SIZE][cell % GameState::BOARD_SIZE];
+		packed.bytes[cell >> 2] |= (uint8_t)(piece << ((cell & 3) * 2));
+	}
+	packed.bytes[CAPTURES_OFFSET] = (uint8_t)state.captures[0];
+	packed.bytes[CAPTURES_OFFSET + 1] = (uint8_t)state.captures[1];
+	packed.bytes[FLAGS_OFFSET] = (uint8_t)((state.currentPlayer == GameState::PLAYER2 ? 1 : 0) | ((result & 3) << 1));
+	uint32_t word = (uint32_t)score;
+	for (int i = 0; i < 4; i++)
+		packed.bytes[SCORE_OFFSET + i] = (uint8_t)(word >> (i * 8));
+	return packed;
+}
+
+bool PackedPosition::unpack(GameState &state) const
+{
+	state = GameState();
+	int stones = 0;
+	for (int cell = 0; cell < CELLS; cell++)
+	{
+		int piece = (bytes[cell >> 2] >> ((cell & 3) * 2)) & 3;
+		if (piece > GameState::PLAYER2)
+			return false;
+		state.board[cell / GameState::BOARD_SIZE][cell % GameState::BOARD_SIZE] = piece;
+		stones += piece != GameState::EMPTY;
+	}
+	int capturesX = bytes[CAPTURES_OFFSET], capturesO = bytes[CAPTURES_OFFSET + 1];
+	if (capturesX > GameState::WIN_CAPTURES_NORMAL || capturesO > GameState::WIN_CAPTURES_NORMAL)
+		return false;
+	state.captures[0] = capturesX;
+	state.captures[1] = capturesO;
+	state.currentPlayer = sideToMove();
+	state.turnCount = stones + 2 * (capturesX + capturesO);
+	if (GameState::hasher)
+		state.recalculateHash();
+	return true;
+}
+
+int PackedPosition::score() const
+{
+	uint32_t word = 0;
+	for (int i = 0; i < 4; i++)
+		word |= (uint32_t)bytes[SCORE_OFFSET + i] << (i * 8);
+	return (int32_t)word;
+}
+
+// ============================================
+// Writer
+// ============================================
+
+bool TrainingDataWriter::open(const std::string &filePrefix, size_t perShard)
+{
+	close();
+	prefix = filePrefix;
+	positionsPerShard = perShard > 0 ? perShard : 1;
+	shardIndex = 0;
+	totalPositions = 0;
+	shards.clear();
+	buffer.reserve(BUFFER_BYTES);
+	return openNextShard();
+}
+
+bool TrainingDataWriter::openNextShard()
+{
+	flush();
+	file.close();
+
+	// Skip shards left by earlier runs
+	std::string filename;
+	for (;; shardIndex++)
+	{
+		char suffix[32];
+		std::snprintf(suffix, sizeof(suffix), "-%04d.gpos", shardIndex);
+		filename = prefix + suffix;
+		if (!std::ifstream(filename).is_open())
+			break;
+	}
+	file.open(filename, std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+	{
+		std::cerr << "Warning: Could not open training data file " << filename << std::endl;
+		return false;
+	}
+	shards.push_back(filename);
+	shardIndex++;
+	shardPositions = 0;
+
+	buffer.insert(buffer.end(), MAGIC, MAGIC + 4);
+	buffer.push_back(FORMAT_VERSION);
+	buffer.push_back((uint8_t)GameState::BOARD_SIZE);
+	buffer.push_back(0);
+	buffer.push_back(0);
+	return true;
+}
+
+bool TrainingDataWriter::write(const PackedPosition &position)
+{
+	if (!file.is_open())
+		return false;
+	if (shardPositions >= positionsPerShard && !openNextShard())
+		return false;
+	buffer.insert(buffer.end(), position.bytes, position.bytes + PackedPosition::PACKED_BYTES);
+	shardPositions++;
+	totalPositions++;
+	if (buffer.size() + PackedPosition::PACKED_BYTES > BUFFER_BYTES)
+		flush();
+	return true;
+}
+
+void TrainingDataWriter::flush()
+{
+	if (!file.is_open() || buffer.empty())
+		return;
+	file.write((const char *)buffer.data(), buffer.size());
+	file.flush();
+	buffer.clear();
+}
+
+void TrainingDataWriter::close()
+{
+	if (!file.is_open())
+		return;
+	flush();
+	file.close();
+}
+
+// ============================================
+// Reader
+// ============================================
+
+bool TrainingDataReader::open(const std::string &filename)
+{
+	file.close();
+	file.clear();
+	buffer.clear();
+	position = 0;
+	failed = false;
+
+	file.open(filename, std::ios::binary);
+	if (!file.is_open())
+	{
+		std::cerr << "Error: Could not open training data file " << filename << std::endl;
+		failed = true;
+		return false;
+	}
+	char header[HEADER_BYTES];
+	if (!file.read(header, HEADER_BYTES) || std::memcmp(header, MAGIC, 4) != 0 ||
+		(uint8_t)header[4] != FORMAT_VERSION || (uint8_t)header[5] != GameState::BOARD_SIZE)
+	{
+		std::cerr << "Error: " << filename << " is not a training data file" << std::endl;
+		failed = true;
+		return false;
+	}
+	buffer.reserve(BUFFER_BYTES);
+	return true;
+}
+
+bool TrainingDataReader::next(PackedPosition &packed)
+{
+	if (failed || !file.is_open())
+		return false;
+	if (buffer.size() - position < PackedPosition::PACKED_BYTES)
+	{
+		// Keep a partial record, refill behind it
+		buffer.erase(buffer.begin(), buffer.begin() + position);
+		position = 0;
+		size_t kept = buffer.size();
+		buffer.resize(BUFFER_BYTES);
+		file.read((char *)buffer.data() + kept, BUFFER_BYTES - kept);
+		buffer.resize(kept + (size_t)file.gcount());
+		if (buffer.size() < PackedPosition::PACKED_BYTES)
+		{
+			failed = !buffer.empty(); // Truncated record
+			return false;
+		}
+	}
+	std::memcpy(packed.bytes, buffer.data() + position, PackedPosition::PACKED_BYTES);
+	position += PackedPosition::PACKED_BYTES;
+	return true;
+}
@@ -13,6 +13,11 @@ ZobristHasher::ZobristHasher() {
     initializeZobristTable();
 }
 
+ZobristHasher::ZobristHasher(uint64_t seed) {
+    std::mt19937_64 seeded(seed);
+    fillTables(seeded);
+}
+
 ZobristHasher::~ZobristHasher() {}
 
 void ZobristHasher::initializeZobristTable() {
@@ -29,6 +34,10 @@ void ZobristHasher::initializeZobristTable() {
         // Successful initialization - will be logged from main
     }
     
+    fillTables(rng);
+}
+
+void ZobristHasher::fillTables(std::mt19937_64 &generator) {
     // Initialize main table
     for (int i = 0; i < GameState::BOARD_SIZE; i++) {
         for (int j = 0; j < GameState::BOARD_SIZE; j++) {
@@ -36,27 +45,27 @@ void ZobristHasher::initializeZobristTable() {
             zobristTable[i][j][GameState::EMPTY] = 0;
             
             // Generate unique keys for each player
-            zobristTable[i][j][GameState::PLAYER1] = generateRandomKey();
-            zobristTable[i][j][GameState::PLAYER2] = generateRandomKey();
+            zobristTable[i][j][GameState::PLAYER1] = generateRandomKey(generator);
+            zobristTable[i][j][GameState::PLAYER2] = generateRandomKey(generator);
         }
     }
     
     // Hash for player turn
-    turnHash = generateRandomKey();
+    turnHash = generateRandomKey(generator);
     
     // Hash for captures
     for (int player = 0; player < 2; player++) {
         for (int captures = 0; captures <= 10; captures++) {
-            captureHashes[player][captures] = generateRandomKey();
+            captureHashes[player][captures] = generateRandomKey(generator);
         }
     }
     
     // Zobrist statistics - will be logged from main if needed
 }
 
-ZobristHasher::ZobristKey ZobristHasher::generateRandomKey() {
+ZobristHasher::ZobristKey ZobristHasher::generateRandomKey(std::mt19937_64 &generator) {
     std::uniform_int_distribution<uint64_t> dis;
-    return dis(rng);
+    return dis(generator);
 }
 
 ZobristHasher::ZobristKey ZobristHasher::computeFullHash(const GameState& state) const {
@@ -0,0 +1,249 @@
+// ============================================
+// ANALYZE.CPP - Batch analysis of recorded games
+// ============================================
+// Re-searches every position of every game and writes, per move, what
+// the engine would have played, the score of that move and of the move
+// actually played, and a blunder flag, as CSV.
+//
+// - Inputs: native game record files (include/utils/game_record.hpp) and
+//   Piskvork .psq files, in any mix
+// - Each worker thread owns one TranspositionSearch and takes whole games
+//   from a shared counter, so consecutive positions of a game hit a warm
+//   table; the table is cleared between games, which keeps every row
+//   independent of the thread count and of scheduling
+// - Rows are written in input order as games complete
+// - Zobrist keys come from --seed, so a depth-only run writes the same CSV
+//   every time (the table collides the same way)
+//
+// Scores are from the point of view of the player to move; the played
+// move is scored at the same horizon as the engine's choice and loss =
+// best - played (GameAnalyzer, include/ai/game_analyzer.hpp).
+//
+// Usage: ./analyze FILE... [--depth N] [--ms N] [--threads N] [--tt-mb MB]
+//                          [--blunder LOSS] [--seed S] [--out FILE]
+// ============================================
+
+#include "../include/ai/evaluator.hpp"
+#include "../include/ai/game_analyzer.hpp"
+#include "../include/ai/transposition_search.hpp"
+#include "../include/core/game_types.hpp"
+#include "../include/utils/game_record.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const int DEFAULT_DEPTH = 6;
+static const size_t DEFAULT_TABLE_MB = 16;
+// Losing this much (a half-open four) with one move counts as a blunder
+static const int DEFAULT_BLUNDER_LOSS = Evaluator::FOUR_HALF;
+static const uint64_t DEFAULT_SEED = 0x9E3779B97F4A7C15ULL;
+
+struct AnalyzeOptions {
+    std::vector<std::string> files;
+    int depth = DEFAULT_DEPTH;
+    int timeMs = 0;
+    int threads = 1;
+    size_t tableMB = DEFAULT_TABLE_MB;
+    int blunderLoss = DEFAULT_BLUNDER_LOSS;
+    uint64_t seed = DEFAULT_SEED;
+    std::string outFile;
+};
+
+struct InputGame {
+    std::string source; // file, or file#index for record files
+    GameRecord record;
+};
+
+struct GameAnalysis {
+    std::string csv;
+    int positions = 0;
+    int blunders = 0;
+    uint64_t nodes = 0;
+    bool valid = true;
+};
+
+static std::string moveName(const Move& move) {
+    if (!move.isValid()) return "--";
+    return std::string(1, char('A' + move.y)) + std::to_string(move.x + 1);
+}
+
+static bool hasSuffix(const std::string& text, const std::string& suffix) {
+    return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+static bool loadGames(const std::string& filename, std::vector<InputGame>& games) {
+    if (hasSuffix(filename, ".psq")) {
+        std::ifstream in(filename);
+        InputGame game;
+        game.source = filename;
+        if (!in.is_open() || !GameRecordReader::readPsq(in, game.record)) {
+            std::cerr << "Error: " << filename << ": not a readable 19x19 .psq game" << std::endl;
+            return false;
+        }
+        games.push_back(game);
+        return true;
+    }
+
+    GameRecordReader reader;
+    if (!reader.open(filename))
+        return false;
+    InputGame game;
+    for (int index = 0; reader.next(game.record); index++) {
+        game.source = filename + "#" + std::to_string(index);
+        games.push_back(game);
+    }
+    if (reader.hasError()) {
+        std::cerr << "Error: " << filename << ": malformed game record" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// ============================================
+// Analysis
+// ============================================
+
+static GameAnalysis analyzeGame(TranspositionSearch& search, const InputGame& game, const AnalyzeOptions& options) {
+    GameAnalyzer::Result result = GameAnalyzer::analyze(search, game.record, options.depth);
+    GameAnalysis analysis;
+    analysis.nodes = result.nodes;
+    analysis.valid = result.complete;
+    if (!result.complete) {
+        size_t ply = result.moves.size();
+        std::cerr << "Warning: " << game.source << ": illegal move " << moveName(game.record.moves[ply].move)
+                  << " at ply " << ply + 1 << ", rest of the game skipped" << std::endl;
+    }
+
+    std::ostringstream csv;
+    for (size_t ply = 0; ply < result.moves.size(); ply++) {
+        const GameAnalyzer::MoveAnalysis& move = result.moves[ply];
+        bool blunder = move.loss >= options.blunderLoss;
+        csv << game.source << ',' << ply + 1 << ',' << (move.player == GameState::PLAYER1 ? 'X' : 'O') << ','
+            << moveName(move.played) << ',' << moveName(move.best) << ',' << move.score << ','
+            << move.playedScore << ',' << move.loss << ',' << (blunder ? 1 : 0) << ',' << move.depth << ','
+            << move.nodes << '\n';
+        analysis.positions++;
+        analysis.blunders += blunder;
+    }
+    analysis.csv = csv.str();
+    return analysis;
+}
+
+// ============================================
+// Main
+// ============================================
+
+int main(int argc, char** argv) {
+    AnalyzeOptions options;
+    options.threads = (int)std::max(1u, std::thread::hardware_concurrency());
+
+    bool validArgs = true;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--depth" && hasValue) options.depth = std::atoi(argv[++i]);
+        else if (arg == "--ms" && hasValue) options.timeMs = std::atoi(argv[++i]);
+        else if (arg == "--threads" && hasValue) options.threads = std::atoi(argv[++i]);
+        else if (arg == "--tt-mb" && hasValue) options.tableMB = std::strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--blunder" && hasValue) options.blunderLoss = std::atoi(argv[++i]);
+        else if (arg == "--seed" && hasValue) options.seed = std::strtoull(argv[++i], nullptr, 0);
+        else if (arg == "--out" && hasValue) options.outFile = argv[++i];
+        else if (!arg.empty() && arg[0] != '-') options.files.push_back(arg);
+        else validArgs = false;
+    }
+    if (!validArgs || options.files.empty() || options.depth < 1 || options.depth > 20 || options.timeMs < 0 ||
+        options.threads < 1 || options.tableMB < 1 || options.blunderLoss < 1) {
+        std::cerr << "Usage: " << argv[0] << " FILE... [--depth 1-20] [--ms N] [--threads N] [--tt-mb MB]\n"
+                  << "       [--blunder LOSS] [--seed S] [--out FILE]\n"
+                  << "FILE: game record file, or Piskvork .psq game" << std::endl;
+        return 2;
+    }
+
+    // Search and table code log to std::cout: silence it
+    std::streambuf* consoleBuffer = std::cout.rdbuf(nullptr);
+    std::ofstream outFile;
+    if (!options.outFile.empty()) {
+        outFile.open(options.outFile);
+        if (!outFile.is_open()) {
+            std::cerr << "Error: Could not write " << options.outFile << std::endl;
+            std::cout.rdbuf(consoleBuffer);
+            return 2;
+        }
+    }
+    std::ostream out(options.outFile.empty() ? consoleBuffer : outFile.rdbuf());
+
+    GameState::initializeHasher(options.seed);
+
+    std::vector<InputGame> games;
+    for (const std::string& file : options.files) {
+        if (!loadGames(file, games)) {
+            GameState::cleanupHasher();
+            std::cout.rdbuf(consoleBuffer);
+            return 2;
+        }
+    }
+    options.threads = std::max(1, std::min(options.threads, (int)games.size()));
+    std::cerr << "Analyzing " << games.size() << " games at depth " << options.depth
+              << (options.timeMs > 0 ? ", " + std::to_string(options.timeMs) + " ms/position" : "")
+              << " on " << options.threads << " threads" << std::endl;
+
+    out << "game,ply,player,move,best,score,played_score,loss,blunder,depth,nodes\n";
+
+    std::atomic<size_t> nextGame(0);
+    std::mutex outputMutex;
+    std::map<size_t, GameAnalysis> finished; // Waiting for earlier games
+    size_t nextToWrite = 0;
+    int positions = 0, blunders = 0, invalidGames = 0;
+    uint64_t nodes = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    auto runWorker = [&]() {
+        TranspositionSearch search(options.tableMB);
+        search.setTimeLimit(options.timeMs);
+        for (size_t index = nextGame++; index < games.size(); index = nextGame++) {
+            GameAnalysis analysis = analyzeGame(search, games[index], options);
+
+            std::lock_guard<std::mutex> lock(outputMutex);
+            positions += analysis.positions;
+            blunders += analysis.blunders;
+            nodes += analysis.nodes;
+            invalidGames += !analysis.valid;
+            finished[index] = std::move(analysis);
+            for (auto it = finished.find(nextToWrite); it != finished.end(); it = finished.find(nextToWrite)) {
+                out << it->second.csv;
+                finished.erase(it);
+                nextToWrite++;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < options.threads; i++)
+        threads.emplace_back(runWorker);
+    for (std::thread& thread : threads)
+        thread.join();
+    out.flush();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cerr << std::fixed << std::setprecision(1)
+              << games.size() << " games, " << positions << " positions, " << blunders << " blunders"
+              << (invalidGames > 0 ? " (" + std::to_string(invalidGames) + " games cut at an illegal move)" : "")
+              << " in " << seconds << " s" << std::endl
+              << std::setprecision(0)
+              << "Positions/hour: " << (seconds > 0.0 ? positions * 3600.0 / seconds : 0.0)
+              << ", nodes/s: " << (seconds > 0.0 ? nodes / seconds : 0.0) << std::endl;
+
+    GameState::cleanupHasher();
+    std::cout.rdbuf(consoleBuffer);
+    return invalidGames > 0 ? 1 : 0;
+}
@@ -0,0 +1,188 @@
+// ============================================
+// BENCH.CPP - Reproducible search benchmark
+// ============================================
+// Runs TranspositionSearch::findBestMoveIterative to a fixed depth on every
+// position of a versioned suite (tests/data/bench_suite.txt) with a fixed
+// Zobrist seed. The total node count is the bench signature: it only changes
+// when search behavior changes, never with machine speed.
+//
+// Usage: ./bench [suite] [--depth N] [--seed S] [--hash MB] [--expect NODES]
+// ============================================
+
+#include "../include/ai/transposition_search.hpp"
+#include "../include/core/game_types.hpp"
+#include "../include/utils/position_io.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static const int DEFAULT_DEPTH = 8;
+static const uint64_t DEFAULT_SEED = 0x9E3779B97F4A7C15ULL;
+static const size_t DEFAULT_HASH_MB = 64;
+
+struct BenchPosition {
+    std::string name;
+    std::string category;
+    GameState state;
+};
+
+struct BenchOptions {
+    std::string suiteFile = "data/bench_suite.txt";
+    int depth = DEFAULT_DEPTH;
+    uint64_t seed = DEFAULT_SEED;
+    size_t hashMB = DEFAULT_HASH_MB;
+    uint64_t expectedSignature = 0;
+};
+
+// ============================================
+// Suite parsing
+// ============================================
+
+static bool parsePosition(const std::string& line, BenchPosition& pos) {
+    std::istringstream in(line);
+    return (in >> pos.name >> pos.category) && PositionIO::read(in, pos.state);
+}
+
+static bool loadSuite(const std::string& filename, std::vector<BenchPosition>& positions) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open bench suite " << filename << std::endl;
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        size_t start = line.find_first_not_of(" \t\r");
+        if (start == std::string::npos || line[start] == '#')
+            continue;
+
+        BenchPosition pos;
+        if (!parsePosition(line, pos)) {
+            std::cerr << "Error: " << filename << ":" << lineNumber << ": malformed position" << std::endl;
+            return false;
+        }
+        positions.push_back(pos);
+    }
+    return !positions.empty();
+}
+
+static bool parseOptions(int argc, char** argv, BenchOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--depth" && hasValue) options.depth = std::atoi(argv[++i]);
+        else if (arg == "--seed" && hasValue) options.seed = std::strtoull(argv[++i], nullptr, 0);
+        else if (arg == "--hash" && hasValue) options.hashMB = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--expect" && hasValue) options.expectedSignature = std::strtoull(argv[++i], nullptr, 10);
+        else if (!arg.empty() && arg[0] != '-') options.suiteFile = arg;
+        else return false;
+    }
+    return options.depth >= 1 && options.depth <= 10 && options.hashMB > 0;
+}
+
+static std::string moveName(const Move& move) {
+    if (!move.isValid()) return "--";
+    return std::string(1, char('A' + move.y)) + std::to_string(move.x + 1);
+}
+
+// ============================================
+// Main
+// ============================================
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0]
+                  << " [suite] [--depth 1-10] [--seed S] [--hash MB] [--expect NODES]" << std::endl;
+        return 2;
+    }
+
+    GameState::initializeHasher(options.seed);
+
+    std::vector<BenchPosition> positions;
+    if (!loadSuite(options.suiteFile, positions)) {
+        GameState::cleanupHasher();
+        return 2;
+    }
+
+    std::cout << "=== GOMOKU BENCH ===" << std::endl;
+    std::cout << "Suite: " << options.suiteFile << " (" << positions.size() << " positions)"
+              << "  Depth: " << options.depth
+              << "  Seed: 0x" << std::hex << options.seed << std::dec
+              << "  Hash: " << options.hashMB << " MB" << std::endl << std::endl;
+
+    std::cout << std::left << std::setw(10) << "position" << std::setw(10) << "category"
+              << std::right << std::setw(6) << "move" << std::setw(9) << "score"
+              << std::setw(10) << "nodes" << std::setw(10) << "ms"
+              << std::setw(10) << "nps" << std::setw(8) << "tt-hit" << std::endl;
+
+    uint64_t totalNodes = 0;
+    double totalMs = 0.0;
+    uint64_t totalProbes = 0, totalHits = 0;
+    std::vector<double> depthMs(options.depth + 1, 0.0);
+    std::vector<int> depthCount(options.depth + 1, 0);
+
+    for (const BenchPosition& pos : positions) {
+        // Fresh table, history and killers: each position is independent of the others
+        TranspositionSearch search(options.hashMB);
+
+        auto start = std::chrono::steady_clock::now();
+        TranspositionSearch::SearchResult result = search.findBestMoveIterative(pos.state, options.depth);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        uint64_t probes = 0, hits = 0;
+        double elapsedToDepth = 0.0;
+        for (const SearchStats& it : search.getLastSearchStats()) {
+            probes += it.ttProbes;
+            hits += it.ttHits;
+            elapsedToDepth += it.wallTimeMs;
+            depthMs[it.depth] += elapsedToDepth;
+            depthCount[it.depth]++;
+        }
+
+        uint64_t nodes = (uint64_t)result.nodesEvaluated;
+        totalNodes += nodes;
+        totalMs += ms;
+        totalProbes += probes;
+        totalHits += hits;
+
+        std::cout << std::left << std::setw(10) << pos.name << std::setw(10) << pos.category
+                  << std::right << std::setw(6) << moveName(result.bestMove)
+                  << std::setw(9) << result.score
+                  << std::setw(10) << nodes
+                  << std::setw(10) << std::fixed << std::setprecision(1) << ms
+                  << std::setw(10) << std::setprecision(0) << (ms > 0.0 ? nodes * 1000.0 / ms : 0.0)
+                  << std::setw(7) << std::setprecision(1)
+                  << (probes > 0 ? 100.0 * hits / probes : 0.0) << "%" << std::endl;
+    }
+
+    std::cout << std::endl << "Time to depth (average over positions that reached it):" << std::endl;
+    for (int d = 1; d <= options.depth; d++) {
+        if (depthCount[d] == 0) continue;
+        std::cout << "  depth " << std::setw(2) << d << ": " << std::setw(9) << std::setprecision(1)
+                  << depthMs[d] / depthCount[d] << " ms  (" << depthCount[d] << " positions)" << std::endl;
+    }
+
+    std::cout << std::endl;
+    std::cout << "Total nodes:   " << totalNodes << std::endl;
+    std::cout << "Total time:    " << std::setprecision(0) << totalMs << " ms" << std::endl;
+    std::cout << "Nodes/second:  " << (totalMs > 0.0 ? totalNodes * 1000.0 / totalMs : 0.0) << std::endl;
+    std::cout << "TT hit rate:   " << std::setprecision(1)
+              << (totalProbes > 0 ? 100.0 * totalHits / totalProbes : 0.0) << "%" << std::endl;
+    std::cout << "Bench signature: " << totalNodes << std::endl;
+
+    GameState::cleanupHasher();
+
+    if (options.expectedSignature != 0 && options.expectedSignature != totalNodes) {
+        std::cerr << "Signature mismatch: expected " << options.expectedSignature
+                  << ", got " << totalNodes << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,273 @@
+// ============================================
+// DATAGEN.CPP - Self-play training data generator
+// ============================================
+// Plays fast self-play games with TranspositionSearch at low depth and
+// writes sampled positions, with their search score and the final game
+// result, as packed records (include/utils/training_data.hpp).
+//
+// - Variety: each game starts with a few random plies near the centre,
+//   and later moves are replaced by a random neighbouring move with a
+//   small probability
+// - Games are refereed by a GameEngine, as in selfplay: a five the
+//   opponent can break by capture only wins if the capture is not played,
+//   so the result labels follow the real rules
+// - Each worker thread owns one TranspositionSearch and one referee for
+//   the whole run and keeps only the current game's positions; finished
+//   games go through one shared streaming writer, so memory stays bounded
+// - Not sampled: the opening, positions with a five on the board or a
+//   pending forced capture (PackedPosition does not store that state) and
+//   positions the search already scores as won or lost
+// - Output is split into shards of --shard positions
+//
+// Usage: ./datagen --out PREFIX [--positions N] [--threads N] [--depth N]
+//                  [--ms N] [--tt-mb MB] [--openings PLIES] [--random P]
+//                  [--sample P] [--max-plies N] [--shard N] [--seed S]
+// ============================================
+
+#include "../include/ai/evaluator.hpp"
+#include "../include/ai/transposition_search.hpp"
+#include "../include/core/game_engine.hpp"
+#include "../include/core/game_types.hpp"
+#include "../include/rules/rule_engine.hpp"
+#include "../include/utils/game_record.hpp"
+#include "../include/utils/training_data.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const int DEFAULT_DEPTH = 3;
+static const size_t DEFAULT_TABLE_MB = 4;
+static const uint64_t DEFAULT_SEED = 0x9E3779B97F4A7C15ULL;
+// Scores at least this large mean the search already sees a forced result
+static const int DECIDED_SCORE = Evaluator::WIN / 2;
+
+struct DatagenOptions {
+    std::string prefix;
+    long long positions = 1000000;
+    int threads = 1;
+    int depth = DEFAULT_DEPTH;
+    int timeMs = 0;
+    size_t tableMB = DEFAULT_TABLE_MB;
+    int openingPlies = 6;
+    double randomMove = 0.05;
+    double sample = 0.5;
+    int maxPlies = 200;
+    size_t shardPositions = 1000000;
+    uint64_t seed = DEFAULT_SEED;
+};
+
+struct GameOutcome {
+    int result; // GameRecord::Result, DRAW when adjudicated
+    int plies;
+    uint64_t nodes;
+};
+
+struct SampledPosition {
+    GameState state;
+    int score; // For the player to move
+};
+
+// Search and referee of one worker thread, built once
+struct Worker {
+    TranspositionSearch search;
+    GameEngine referee;
+
+    explicit Worker(const DatagenOptions& options) : search(options.tableMB) {
+        search.setTimeLimit(options.timeMs);
+        referee.setAITableSize(1); // Only used for the rules
+        referee.setGameMode(GameMode::VS_HUMAN_SUGGESTED);
+    }
+};
+
+// ============================================
+// Games
+// ============================================
+
+static int gameResult(const GameEngine& referee) {
+    if (!referee.isGameOver()) return GameRecord::UNFINISHED;
+    return referee.getWinner() == GameState::PLAYER1 ? GameRecord::PLAYER1_WINS : GameRecord::PLAYER2_WINS;
+}
+
+// A five on the board (breakable ones included) or a capture that must answer one
+static bool fivePending(const GameState& state) {
+    return state.forcedCapturePlayer != 0 || RuleEngine::hasFiveInARow(state, GameState::PLAYER1) ||
+           RuleEngine::hasFiveInARow(state, GameState::PLAYER2);
+}
+
+// A random legal move next to an existing stone
+static Move randomNeighbourMove(const GameState& state, std::mt19937_64& random) {
+    std::vector<Move> moves;
+    for (int x = 0; x < GameState::BOARD_SIZE; x++) {
+        for (int y = 0; y < GameState::BOARD_SIZE; y++) {
+            if (!state.isEmpty(x, y)) continue;
+            bool neighbour = false;
+            for (int dx = -1; dx <= 1 && !neighbour; dx++)
+                for (int dy = -1; dy <= 1 && !neighbour; dy++)
+                    neighbour = state.isValid(x + dx, y + dy) && !state.isEmpty(x + dx, y + dy);
+            if (neighbour && RuleEngine::isLegalMove(state, Move(x, y)))
+                moves.push_back(Move(x, y));
+        }
+    }
+    if (moves.empty()) return Move();
+    return moves[std::uniform_int_distribution<size_t>(0, moves.size() - 1)(random)];
+}
+
+// Plays game `index`, filling `sampled`
+static GameOutcome playGame(Worker& worker, const DatagenOptions& options, uint64_t index,
+                            std::vector<SampledPosition>& sampled) {
+    std::mt19937_64 random(options.seed + index * 0x100000001B3ULL);
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    TranspositionSearch& search = worker.search;
+    GameEngine& referee = worker.referee;
+    sampled.clear();
+
+    do {
+        referee.newGame();
+    } while (!referee.playRandomOpening(options.openingPlies, random));
+    search.clearCache();
+
+    GameOutcome outcome = {GameRecord::UNFINISHED, options.openingPlies, 0};
+    while (outcome.plies < options.maxPlies && outcome.result == GameRecord::UNFINISHED) {
+        const GameState& state = referee.getState();
+        TranspositionSearch::SearchResult found = search.findBestMoveIterative(state, options.depth);
+        outcome.nodes += found.nodesEvaluated;
+        int score = search.scoreForPlayerToMove(state, found.score);
+
+        if (!fivePending(state) && std::abs(score) < DECIDED_SCORE && chance(random) < options.sample)
+            sampled.push_back({state, score});
+
+        Move move = found.bestMove;
+        if (chance(random) < options.randomMove) {
+            Move randomMove = randomNeighbourMove(state, random);
+            if (randomMove.isValid()) move = randomMove;
+        }
+        if (!move.isValid() || !RuleEngine::isLegalMove(state, move))
+            move = RuleEngine::findCentralLegalMove(state);
+        if (!move.isValid() || !referee.makeHumanMove(move))
+            break; // Board full: draw
+        outcome.plies++;
+        outcome.result = gameResult(referee);
+    }
+    if (outcome.result == GameRecord::UNFINISHED)
+        outcome.result = GameRecord::DRAW;
+    return outcome;
+}
+
+// ============================================
+// Main
+// ============================================
+
+int main(int argc, char** argv) {
+    DatagenOptions options;
+    options.threads = (int)std::max(1u, std::thread::hardware_concurrency());
+
+    bool validArgs = true;
+    for (int i = 1; i < argc && validArgs; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--out" && hasValue) options.prefix = argv[++i];
+        else if (arg == "--positions" && hasValue) options.positions = std::atoll(argv[++i]);
+        else if (arg == "--threads" && hasValue) options.threads = std::atoi(argv[++i]);
+        else if (arg == "--depth" && hasValue) options.depth = std::atoi(argv[++i]);
+        else if (arg == "--ms" && hasValue) options.timeMs = std::atoi(argv[++i]);
+        else if (arg == "--tt-mb" && hasValue) options.tableMB = std::strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--openings" && hasValue) options.openingPlies = std::atoi(argv[++i]);
+        else if (arg == "--random" && hasValue) options.randomMove = std::atof(argv[++i]);
+        else if (arg == "--sample" && hasValue) options.sample = std::atof(argv[++i]);
+        else if (arg == "--max-plies" && hasValue) options.maxPlies = std::atoi(argv[++i]);
+        else if (arg == "--shard" && hasValue) options.shardPositions = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--seed" && hasValue) options.seed = std::strtoull(argv[++i], nullptr, 0);
+        else validArgs = false;
+    }
+    if (!validArgs || options.prefix.empty() || options.positions < 1 || options.threads < 1 ||
+        options.depth < 1 || options.depth > 20 || options.timeMs < 0 || options.tableMB < 1 ||
+        options.openingPlies < 0 || options.openingPlies > 20 || options.randomMove < 0.0 ||
+        options.randomMove > 1.0 || options.sample <= 0.0 || options.sample > 1.0 ||
+        options.maxPlies <= options.openingPlies || options.shardPositions < 1) {
+        std::cerr << "Usage: " << argv[0] << " --out PREFIX [--positions N] [--threads N] [--depth 1-20]\n"
+                  << "       [--ms N] [--tt-mb MB] [--openings PLIES] [--random P] [--sample P]\n"
+                  << "       [--max-plies N] [--shard N] [--seed S]" << std::endl;
+        return 2;
+    }
+
+    // Search and table code log to std::cout: silence it, report on the real stdout
+    std::ostream out(std::cout.rdbuf());
+    std::streambuf* consoleBuffer = std::cout.rdbuf(nullptr);
+
+    TrainingDataWriter writer;
+    if (!writer.open(options.prefix, options.shardPositions)) {
+        std::cout.rdbuf(consoleBuffer);
+        return 2;
+    }
+
+    GameState::initializeHasher(options.seed);
+
+    out << "=== DATAGEN (" << options.positions << " positions, " << options.threads << " threads, depth "
+        << options.depth << (options.timeMs > 0 ? ", " + std::to_string(options.timeMs) + " ms/move" : "")
+        << ") ===" << std::endl;
+
+    std::mutex writerMutex;
+    std::atomic<uint64_t> nextGame(0);
+    std::atomic<bool> stop(false);
+    long long games = 0, plies = 0, wins[3] = {0, 0, 0}; // Draws, X, O
+    uint64_t nodes = 0;
+    bool writeFailed = false;
+    auto start = std::chrono::steady_clock::now();
+
+    auto runWorker = [&]() {
+        Worker worker(options);
+        std::vector<SampledPosition> sampled;
+        sampled.reserve(options.maxPlies);
+        while (!stop.load()) {
+            GameOutcome outcome = playGame(worker, options, nextGame++, sampled);
+
+            std::lock_guard<std::mutex> lock(writerMutex);
+            if (stop.load())
+                break;
+            games++;
+            wins[outcome.result == GameRecord::DRAW ? 0 : outcome.result]++;
+            plies += outcome.plies;
+            nodes += outcome.nodes;
+            for (const SampledPosition& position : sampled) {
+                if ((long long)writer.positionsWritten() >= options.positions)
+                    break;
+                if (!writer.write(PackedPosition::pack(position.state, position.score, outcome.result))) {
+                    writeFailed = true;
+                    break;
+                }
+            }
+            if (writeFailed || (long long)writer.positionsWritten() >= options.positions)
+                stop = true;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < options.threads; i++)
+        threads.emplace_back(runWorker);
+    for (std::thread& thread : threads)
+        thread.join();
+    writer.close();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    out << std::fixed << std::setprecision(1)
+        << writer.positionsWritten() << " positions from " << games << " games (X " << wins[1] << ", O "
+        << wins[2] << ", draws " << wins[0] << ", " << (games > 0 ? (double)plies / games : 0.0)
+        << " plies on average) in " << seconds << " s" << std::endl
+        << std::setprecision(0)
+        << "Positions/hour: " << (seconds > 0.0 ? writer.positionsWritten() * 3600.0 / seconds : 0.0)
+        << ", nodes/s: " << (seconds > 0.0 ? nodes / seconds : 0.0) << std::endl;
+    for (const std::string& shard : writer.shardFiles())
+        out << "  " << shard << std::endl;
+
+    GameState::cleanupHasher();
+    std::cout.rdbuf(consoleBuffer);
+    return writeFailed ? 1 : 0;
+}
@@ -0,0 +1,357 @@
+// ============================================
+// MICROBENCH.CPP - Rule engine / evaluator primitive timings
+// ============================================
+// Times single calls of the hot primitives on an early, a mid and a late
+// board. Each benchmark is warmed up, then measured as SAMPLES batches; a
+// batch is sized to last at least MIN_SAMPLE_NS so timer overhead is
+// negligible. Reported per call: median and p99 ns/op over the batches.
+// GameRecordReader::replay is reported per move of a recorded game.
+//
+// Results are written as CSV (one row per benchmark/board) so two builds
+// can be compared: ./microbench --out new.csv --baseline old.csv
+//
+// Usage: ./microbench [--out FILE] [--baseline FILE] [--filter TEXT] [--samples N]
+// ============================================
+
+#include "../include/ai/evaluator.hpp"
+#include "../include/ai/pattern_scanner.hpp"
+#include "../include/ai/transposition_search.hpp"
+#include "../include/core/game_types.hpp"
+#include "../include/rules/rule_engine.hpp"
+#include "../include/utils/game_record.hpp"
+#include "../include/utils/position_io.hpp"
+#include "../include/utils/zobrist_hasher.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static const int DEFAULT_SAMPLES = 200;
+static const int64_t WARMUP_NS = 20000000;  // 20 ms per benchmark
+static const int64_t MIN_SAMPLE_NS = 200000; // 200 us per batch
+static const uint64_t HASH_SEED = 0x9E3779B97F4A7C15ULL;
+
+// Boards in PositionIO format (include/utils/position_io.hpp)
+struct BenchBoard {
+    const char* name;
+    const char* position;
+};
+
+static const BenchBoard BOARDS[] = {
+    {"early", "X 0 0 19/19/19/19/19/19/19/19/8X10/7O1X9/10X1O6/6X4O7/19/19/19/19/19/19/19"},
+    {"mid", "X 1 1 19/19/19/19/6X12/7OX10/8O1X1O6/7XOOOO7/8O2O7/7OXXXXO6/6OX5X5/5XXX3O7/5O6X6/19/19/19/19/19/19"},
+    {"late", "X 6 4 19/19/19/11XX6/3O2O6O5/3OOX2XOOO2XO3/3OXO2OX2OOOO3/3XOXXXX2XOXX4/3XXOX2XOO1OOX3/"
+             "4X1O1XXXOXX1O3/3XOXOXX3OOOO3/4OX1OX1X1OX5/5XXOOO1O7/5XXXXOXX7/7XX1XOXO5/10X2O5/19/19/19"},
+};
+
+// A 52-move depth-5 selfplay game with 9 captures, O winning: its move
+// words as stored in a record file (include/utils/game_record.hpp)
+static const uint16_t REPLAY_GAME[] = {
+    0x007A, 0x00C7, 0x007B, 0x00B3, 0x007C, 0x007D, 0x008F, 0x009F, 0x0079, 0x0078, 0x008B, 0x008D, 0x00A2,
+    0x00B5, 0x00A3, 0x00B7, 0x02B1, 0x00B6, 0x00B4, 0x00B8, 0x00B9, 0x0067, 0x0090, 0x007E, 0x0069, 0x0056,
+    0x02D9, 0x00B5, 0x0057, 0x007F, 0x008D, 0x02A0, 0x008D, 0x009F, 0x008E, 0x027A, 0x008E, 0x027B, 0x027C,
+    0x0080, 0x0081, 0x026A, 0x007C, 0x0042, 0x002E, 0x028F, 0x007C, 0x006B, 0x02C7, 0x0059, 0x00C9, 0x00A1};
+
+// ============================================
+// Optimization barriers
+// ============================================
+
+// Forces the compiler to materialize value (the result of the timed call)
+template <typename T>
+static inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+static inline void clobberMemory() {
+    asm volatile("" : : : "memory");
+}
+
+// ============================================
+// Measurement
+// ============================================
+
+struct MicroResult {
+    std::string benchmark;
+    std::string board;
+    double medianNs;
+    double p99Ns;
+    int samples;
+    uint64_t batch;
+};
+
+static int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// op(i) performs one call on input i (inputs are cycled so branch history
+// does not collapse onto a single case)
+template <typename Op>
+static MicroResult measure(const std::string& benchmark, const std::string& board, int samples, Op op) {
+    uint64_t i = 0;
+
+    int64_t warmupEnd = nowNs() + WARMUP_NS;
+    while (nowNs() < warmupEnd) {
+        for (int k = 0; k < 64; k++) op(i++);
+    }
+
+    uint64_t batch = 1;
+    for (;;) {
+        int64_t start = nowNs();
+        for (uint64_t k = 0; k < batch; k++) op(i++);
+        if (nowNs() - start >= MIN_SAMPLE_NS) break;
+        batch *= 2;
+    }
+
+    std::vector<double> perOp(samples);
+    for (int s = 0; s < samples; s++) {
+        int64_t start = nowNs();
+        for (uint64_t k = 0; k < batch; k++) op(i++);
+        clobberMemory();
+        perOp[s] = (double)(nowNs() - start) / batch;
+    }
+
+    std::sort(perOp.begin(), perOp.end());
+    MicroResult result;
+    result.benchmark = benchmark;
+    result.board = board;
+    result.medianNs = perOp[samples / 2];
+    result.p99Ns = perOp[std::min(samples - 1, (samples * 99) / 100)];
+    result.samples = samples;
+    result.batch = batch;
+    return result;
+}
+
+// ============================================
+// Inputs
+// ============================================
+
+// Empty cells next to a stone: the moves search actually considers
+static std::vector<Move> candidateMoves(const GameState& state) {
+    std::vector<Move> moves;
+    for (int x = 0; x < GameState::BOARD_SIZE; x++) {
+        for (int y = 0; y < GameState::BOARD_SIZE; y++) {
+            if (state.board[x][y] != GameState::EMPTY) continue;
+            bool near = false;
+            for (int dx = -1; dx <= 1 && !near; dx++)
+                for (int dy = -1; dy <= 1 && !near; dy++)
+                    near = state.isValid(x + dx, y + dy) && state.board[x + dx][y + dy] != GameState::EMPTY;
+            if (near) moves.push_back(Move(x, y));
+        }
+    }
+    return moves;
+}
+
+static std::vector<Move> stonesOf(const GameState& state, int player) {
+    std::vector<Move> stones;
+    for (int x = 0; x < GameState::BOARD_SIZE; x++)
+        for (int y = 0; y < GameState::BOARD_SIZE; y++)
+            if (state.board[x][y] == player) stones.push_back(Move(x, y));
+    return stones;
+}
+
+static GameRecord replayGame() {
+    GameRecord game;
+    for (uint16_t word : REPLAY_GAME) {
+        int cell = word & 0x01FF;
+        game.moves.push_back(RecordedMove(Move(cell / GameState::BOARD_SIZE, cell % GameState::BOARD_SIZE),
+                                          word & (RecordedMove::CAPTURED | RecordedMove::FORCED_CAPTURE)));
+    }
+    game.result = GameRecord::PLAYER2_WINS;
+    return game;
+}
+
+static std::map<std::string, double> loadBaseline(const std::string& filename) {
+    std::map<std::string, double> baseline;
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Warning: Could not open baseline " << filename << std::endl;
+        return baseline;
+    }
+    std::string line;
+    std::getline(file, line); // header
+    while (std::getline(file, line)) {
+        std::istringstream in(line);
+        std::string benchmark, board, median;
+        if (std::getline(in, benchmark, ',') && std::getline(in, board, ',') && std::getline(in, median, ','))
+            baseline[benchmark + "/" + board] = std::atof(median.c_str());
+    }
+    return baseline;
+}
+
+// ============================================
+// Main
+// ============================================
+int main(int argc, char** argv) {
+    std::string outFile = "microbench_results.csv";
+    std::string baselineFile;
+    std::string filter;
+    int samples = DEFAULT_SAMPLES;
+
+    bool validArgs = true;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--out" && hasValue) outFile = argv[++i];
+        else if (arg == "--baseline" && hasValue) baselineFile = argv[++i];
+        else if (arg == "--filter" && hasValue) filter = argv[++i];
+        else if (arg == "--samples" && hasValue) samples = std::atoi(argv[++i]);
+        else validArgs = false;
+    }
+    if (!validArgs || samples < 1) {
+        std::cerr << "Usage: " << argv[0]
+                  << " [--out FILE] [--baseline FILE] [--filter TEXT] [--samples N]" << std::endl;
+        return 2;
+    }
+
+    GameState::initializeHasher(HASH_SEED);
+    ZobristHasher hasher(HASH_SEED);
+    TranspositionSearch search(1);
+    const PatternScanner::Kernel defaultKernel = PatternScanner::getKernel();
+
+    std::map<std::string, double> baseline;
+    if (!baselineFile.empty()) baseline = loadBaseline(baselineFile);
+
+    std::vector<MicroResult> results;
+    std::cout << "=== GOMOKU MICROBENCH (" << samples << " samples) ===" << std::endl;
+    std::cout << std::left << std::setw(40) << "benchmark" << std::setw(7) << "board"
+              << std::right << std::setw(12) << "median ns" << std::setw(12) << "p99 ns"
+              << std::setw(10) << "batch" << (baseline.empty() ? "" : "   vs base") << std::endl;
+
+    // perCall: units one op(i) performs, to report ns per unit
+    auto run = [&](const std::string& benchmark, const std::string& board, auto op, size_t perCall = 1) {
+        if (!filter.empty() && benchmark.find(filter) == std::string::npos) return;
+        MicroResult r = measure(benchmark, board, samples, op);
+        r.medianNs /= perCall;
+        r.p99Ns /= perCall;
+        results.push_back(r);
+
+        std::cout << std::left << std::setw(40) << benchmark << std::setw(7) << board << std::right
+                  << std::fixed << std::setprecision(1) << std::setw(12) << r.medianNs
+                  << std::setw(12) << r.p99Ns << std::setw(10) << r.batch;
+        auto it = baseline.find(benchmark + "/" + board);
+        if (it != baseline.end() && it->second > 0.0)
+            std::cout << std::showpos << std::setw(11) << (r.medianNs / it->second - 1.0) * 100.0
+                      << "%" << std::noshowpos;
+        std::cout << std::endl;
+    };
+
+    for (const BenchBoard& b : BOARDS) {
+        GameState state;
+        std::istringstream in(b.position);
+        if (!PositionIO::read(in, state)) {
+            std::cerr << "Error: malformed board " << b.name << std::endl;
+            GameState::cleanupHasher();
+            return 2;
+        }
+
+        const std::vector<Move> moves = candidateMoves(state);
+        const std::vector<Move> stones = stonesOf(state, state.currentPlayer);
+        const size_t moveCount = moves.size();
+        const size_t stoneCount = stones.size();
+        const int player = state.currentPlayer;
+        const int opponent = state.getOpponent(player);
+        const std::vector<Move> noCaptures;
+
+        // Reference cost of the copy that applyMove's benchmark includes
+        run("GameState copy", b.name, [&](uint64_t) {
+            GameState copy = state;
+            doNotOptimize(copy);
+        });
+        run("RuleEngine::applyMove", b.name, [&](uint64_t i) {
+            GameState copy = state;
+            RuleEngine::MoveResult result = RuleEngine::applyMove(copy, moves[i % moveCount]);
+            doNotOptimize(result);
+        });
+        run("RuleEngine::checkWin", b.name, [&](uint64_t i) {
+            bool win = RuleEngine::checkWin(state, (i & 1) ? player : opponent);
+            doNotOptimize(win);
+        });
+        run("RuleEngine::hasFiveInARow", b.name, [&](uint64_t i) {
+            bool five = RuleEngine::hasFiveInARow(state, (i & 1) ? player : opponent);
+            doNotOptimize(five);
+        });
+        run("RuleEngine::createsDoubleFreeThree", b.name, [&](uint64_t i) {
+            bool banned = RuleEngine::createsDoubleFreeThree(state, moves[i % moveCount], player);
+            doNotOptimize(banned);
+        });
+        run("RuleEngine::canBreakLineByCapture", b.name, [&](uint64_t i) {
+            const Move& start = stones[i % stoneCount];
+            bool breakable = RuleEngine::canBreakLineByCapture(state, start, Directions::MAIN[i & 3][0],
+                                                               Directions::MAIN[i & 3][1], player);
+            doNotOptimize(breakable);
+        });
+        run("Evaluator::countAllPatterns", b.name, [&](uint64_t i) {
+            Evaluator::PatternCounts counts = Evaluator::countAllPatterns(state, (i & 1) ? player : opponent);
+            doNotOptimize(counts);
+        });
+        for (PatternScanner::Kernel kernel : {PatternScanner::SCALAR, PatternScanner::SSE2, PatternScanner::AVX2}) {
+            if (!PatternScanner::setKernel(kernel)) continue;
+            run(std::string("PatternScanner::count ") + PatternScanner::kernelName(kernel), b.name, [&](uint64_t) {
+                Evaluator::PatternCounts player1, player2;
+                PatternScanner::count(state, player1, player2);
+                doNotOptimize(player1);
+                doNotOptimize(player2);
+            });
+        }
+        PatternScanner::setKernel(defaultKernel);
+        run("Evaluator::countAllPatternsScan", b.name, [&](uint64_t i) {
+            Evaluator::PatternCounts counts = Evaluator::countAllPatternsScan(state, (i & 1) ? player : opponent);
+            doNotOptimize(counts);
+        });
+        run("Evaluator::analyzePosition", b.name, [&](uint64_t i) {
+            int score = Evaluator::analyzePosition(state, (i & 1) ? player : opponent);
+            doNotOptimize(score);
+        });
+        run("Evaluator::evaluate", b.name, [&](uint64_t) {
+            int score = Evaluator::evaluate(state);
+            doNotOptimize(score);
+        });
+        run("ZobristHasher::updateHashAfterMove", b.name, [&](uint64_t i) {
+            uint64_t hash = hasher.updateHashAfterMove(state.zobristHash, moves[i % moveCount], player,
+                                                       noCaptures, state.captures[player - 1],
+                                                       state.captures[player - 1]);
+            doNotOptimize(hash);
+        });
+        run("TranspositionSearch::quickEvaluateMove", b.name, [&](uint64_t i) {
+            int score = search.quickEvaluateMove(state, moves[i % moveCount]);
+            doNotOptimize(score);
+        });
+    }
+
+    const GameRecord game = replayGame();
+    GameState replayed;
+    if (!GameRecordReader::replay(game, replayed)) {
+        std::cerr << "Error: malformed replay game" << std::endl;
+        GameState::cleanupHasher();
+        return 2;
+    }
+    run("GameRecordReader::replay (per move)", "game", [&](uint64_t) {
+        GameState state;
+        bool replayedAll = GameRecordReader::replay(game, state);
+        doNotOptimize(replayedAll);
+        doNotOptimize(state);
+    }, game.moves.size());
+
+    std::ofstream out(outFile);
+    if (!out.is_open()) {
+        std::cerr << "Error: Could not write " << outFile << std::endl;
+        GameState::cleanupHasher();
+        return 1;
+    }
+    out << "benchmark,board,median_ns,p99_ns,samples,batch\n";
+    out << std::fixed << std::setprecision(1);
+    for (const MicroResult& r : results)
+        out << r.benchmark << "," << r.board << "," << r.medianNs << "," << r.p99Ns << ","
+            << r.samples << "," << r.batch << "\n";
+    std::cout << std::endl << "Results written to " << outFile << std::endl;
+
+    GameState::cleanupHasher();
+    return 0;
+}
@@ -0,0 +1,187 @@
+// ============================================
+// PARITY.CPP - C++ vs Rust engine comparison
+// ============================================
+// Searches every position of the bench suite with TranspositionSearch and
+// with the Rust engine at the same depth, and reports move, score, nodes
+// and wall time side by side. Positions where the engines pick a different
+// move or score are listed as divergent.
+//
+// Both engines start each position from an empty transposition table.
+// With --threads N the Rust engine runs a Lazy SMP search (node counts and
+// moves are then not reproducible run to run).
+//
+// Usage: ./parity [suite] [--depth N] [--threads N] [--strict]
+//   --strict: exit with status 1 if any position diverges
+// ============================================
+
+#include "../include/ai/rust_ai_wrapper.hpp"
+#include "../include/ai/transposition_search.hpp"
+#include "../include/core/game_types.hpp"
+#include "../include/utils/position_io.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static const int DEFAULT_DEPTH = 4;
+static const uint64_t HASH_SEED = 0x9E3779B97F4A7C15ULL;
+
+struct ParityPosition {
+    std::string name;
+    std::string category;
+    GameState state;
+};
+
+struct EngineRun {
+    SearchResult result;
+    double ms;
+};
+
+static bool loadSuite(const std::string& filename, std::vector<ParityPosition>& positions) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open suite " << filename << std::endl;
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        size_t start = line.find_first_not_of(" \t\r");
+        if (start == std::string::npos || line[start] == '#')
+            continue;
+
+        ParityPosition pos;
+        std::istringstream in(line);
+        if (!(in >> pos.name >> pos.category) || !PositionIO::read(in, pos.state)) {
+            std::cerr << "Error: " << filename << ":" << lineNumber << ": malformed position" << std::endl;
+            return false;
+        }
+        positions.push_back(pos);
+    }
+    return !positions.empty();
+}
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static std::string moveName(const Move& move) {
+    if (!move.isValid()) return "--";
+    return std::string(1, char('A' + move.y)) + std::to_string(move.x + 1);
+}
+
+// ============================================
+// Main
+// ============================================
+int main(int argc, char** argv) {
+    std::string suiteFile = "data/bench_suite.txt";
+    int depth = DEFAULT_DEPTH;
+    int threads = 1;
+    bool strict = false;
+
+    bool validArgs = true;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--depth" && i + 1 < argc) depth = std::atoi(argv[++i]);
+        else if (arg == "--threads" && i + 1 < argc) threads = std::atoi(argv[++i]);
+        else if (arg == "--strict") strict = true;
+        else if (!arg.empty() && arg[0] != '-') suiteFile = arg;
+        else validArgs = false;
+    }
+    if (!validArgs || depth < 1 || depth > 10 || threads < 1) {
+        std::cerr << "Usage: " << argv[0] << " [suite] [--depth 1-10] [--threads N] [--strict]" << std::endl;
+        return 2;
+    }
+
+    GameState::initializeHasher(HASH_SEED);
+
+    std::vector<ParityPosition> positions;
+    if (!loadSuite(suiteFile, positions)) {
+        GameState::cleanupHasher();
+        return 2;
+    }
+
+    std::cout << "=== C++ vs RUST PARITY (depth " << depth << ", " << positions.size() << " positions, "
+              << threads << " Rust thread" << (threads > 1 ? "s" : "") << ") ===" << std::endl;
+    std::cout << std::left << std::setw(10) << "position"
+              << std::right << std::setw(6) << "C++" << std::setw(9) << "score" << std::setw(9) << "nodes"
+              << std::setw(9) << "ms"
+              << std::setw(7) << "Rust" << std::setw(9) << "score" << std::setw(9) << "nodes"
+              << std::setw(9) << "ms" << "  agree" << std::endl;
+
+    int moveAgree = 0, scoreAgree = 0, nodeAgree = 0;
+    uint64_t cppNodes = 0, rustNodes = 0;
+    double cppMs = 0.0, rustMs = 0.0;
+    std::vector<std::string> divergent;
+
+    for (const ParityPosition& pos : positions) {
+        EngineRun cpp, rust;
+        {
+            TranspositionSearch search;
+            auto start = std::chrono::steady_clock::now();
+            cpp.result = search.findBestMoveIterative(pos.state, depth);
+            cpp.ms = elapsedMs(start);
+        }
+        {
+            RustAIWrapper engine(0, threads);
+            auto start = std::chrono::steady_clock::now();
+            rust.result = engine.findBestMove(pos.state, depth);
+            rust.ms = elapsedMs(start);
+        }
+
+        bool sameMove = cpp.result.bestMove == rust.result.bestMove;
+        bool sameScore = cpp.result.score == rust.result.score;
+        bool sameNodes = cpp.result.nodesEvaluated == rust.result.nodesEvaluated;
+        moveAgree += sameMove;
+        scoreAgree += sameScore;
+        nodeAgree += sameNodes;
+        cppNodes += cpp.result.nodesEvaluated;
+        rustNodes += rust.result.nodesEvaluated;
+        cppMs += cpp.ms;
+        rustMs += rust.ms;
+
+        std::string agreement = std::string(sameMove ? "M" : "-") + (sameScore ? "S" : "-") + (sameNodes ? "N" : "-");
+        std::cout << std::left << std::setw(10) << pos.name << std::right
+                  << std::setw(6) << moveName(cpp.result.bestMove) << std::setw(9) << cpp.result.score
+                  << std::setw(9) << cpp.result.nodesEvaluated
+                  << std::setw(9) << std::fixed << std::setprecision(1) << cpp.ms
+                  << std::setw(7) << moveName(rust.result.bestMove) << std::setw(9) << rust.result.score
+                  << std::setw(9) << rust.result.nodesEvaluated << std::setw(9) << rust.ms
+                  << "  " << agreement << std::endl;
+
+        if (!sameMove || !sameScore) {
+            std::ostringstream note;
+            note << pos.name << " (" << pos.category << "): C++ " << moveName(cpp.result.bestMove)
+                 << " " << cpp.result.score << " vs Rust " << moveName(rust.result.bestMove)
+                 << " " << rust.result.score << "  [" << PositionIO::format(pos.state) << "]";
+            divergent.push_back(note.str());
+        }
+    }
+
+    int total = (int)positions.size();
+    std::cout << std::endl << "Agreement:  move " << moveAgree << "/" << total
+              << "  score " << scoreAgree << "/" << total
+              << "  nodes " << nodeAgree << "/" << total << std::endl;
+    std::cout << std::setprecision(0)
+              << "C++:   " << cppNodes << " nodes, " << cppMs << " ms, "
+              << (cppMs > 0.0 ? cppNodes * 1000.0 / cppMs : 0.0) << " nodes/s" << std::endl;
+    std::cout << "Rust:  " << rustNodes << " nodes, " << rustMs << " ms, "
+              << (rustMs > 0.0 ? rustNodes * 1000.0 / rustMs : 0.0) << " nodes/s" << std::endl;
+    if (cppMs > 0.0 && rustMs > 0.0)
+        std::cout << std::setprecision(2) << "Wall time ratio (Rust / C++): " << rustMs / cppMs << std::endl;
+
+    if (!divergent.empty()) {
+        std::cout << std::endl << "Divergent positions (" << divergent.size() << "):" << std::endl;
+        for (const std::string& note : divergent)
+            std::cout << "  " << note << std::endl;
+    }
+
+    GameState::cleanupHasher();
+    return (strict && !divergent.empty()) ? 1 : 0;
+}
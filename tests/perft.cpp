@@ -0,0 +1,243 @@
+// ============================================
+// PERFT.CPP - Rule engine move-generation counter
+// ============================================
+// Enumerates every legal move (all empty cells accepted by
+// RuleEngine::applyMove, so double free-threes are rejected and captures are
+// applied) to a fixed depth and counts the leaves. Winning moves (five in a
+// row or the 10th capture) end the line and are not expanded further.
+//
+// The expected counts in tests/data/perft_suite.txt were produced by the
+// current rule engine; any other move generator (bitboards, incremental
+// rules) must reproduce them exactly. Independent of the evaluator/search.
+//
+// Usage: ./perft [suite] [--depth N] [--divide NAME]
+// ============================================
+
+#include "../include/core/game_types.hpp"
+#include "../include/rules/rule_engine.hpp"
+#include "../include/utils/position_io.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Depth 3 is ~40M leaves per position: opt in with --depth 3
+static const int DEFAULT_MAX_DEPTH = 2;
+
+struct PerftCounts {
+    uint64_t leaves = 0;
+    uint64_t captures = 0; // Leaf moves that captured at least one pair
+    uint64_t wins = 0;     // Leaf moves that won the game
+    uint64_t rejected = 0; // Empty cells refused at the last ply (double free-three)
+
+    void add(const PerftCounts& other) {
+        leaves += other.leaves;
+        captures += other.captures;
+        wins += other.wins;
+        rejected += other.rejected;
+    }
+    bool operator==(const PerftCounts& other) const {
+        return leaves == other.leaves && captures == other.captures &&
+               wins == other.wins && rejected == other.rejected;
+    }
+};
+
+struct PerftExpectation {
+    int depth;
+    PerftCounts counts;
+};
+
+struct PerftPosition {
+    std::string name;
+    GameState state;
+    std::vector<PerftExpectation> expected;
+};
+
+// ============================================
+// Move enumeration
+// ============================================
+
+static bool isTerminal(const GameState& state, const RuleEngine::MoveResult& result, int mover) {
+    return result.createsWin || state.captures[mover - 1] >= GameState::WIN_CAPTURES_NORMAL;
+}
+
+static PerftCounts perft(const GameState& state, int depth) {
+    PerftCounts counts;
+    int mover = state.currentPlayer;
+
+    for (int x = 0; x < GameState::BOARD_SIZE; x++) {
+        for (int y = 0; y < GameState::BOARD_SIZE; y++) {
+            if (state.board[x][y] != GameState::EMPTY) continue;
+
+            GameState child = state;
+            RuleEngine::MoveResult result = RuleEngine::applyMove(child, Move(x, y));
+            if (!result.success) {
+                if (depth == 1) counts.rejected++;
+                continue;
+            }
+
+            if (depth == 1) {
+                counts.leaves++;
+                if (!result.myCapturedPieces.empty()) counts.captures++;
+                if (isTerminal(child, result, mover)) counts.wins++;
+            } else if (!isTerminal(child, result, mover)) {
+                counts.add(perft(child, depth - 1));
+            }
+        }
+    }
+    return counts;
+}
+
+// ============================================
+// Suite parsing
+// ============================================
+// Position line:    <name> <PositionIO fields>
+// Expectation line: <depth> <leaves> <captures> <wins> <rejected>
+
+static bool loadSuite(const std::string& filename, std::vector<PerftPosition>& positions) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open perft suite " << filename << std::endl;
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        std::istringstream in(line);
+        std::string first;
+        if (!(in >> first) || first[0] == '#') continue;
+
+        bool ok;
+        if (first[0] >= '0' && first[0] <= '9') {
+            PerftExpectation expectation;
+            expectation.depth = std::atoi(first.c_str());
+            PerftCounts& c = expectation.counts;
+            ok = !positions.empty() && expectation.depth >= 1 &&
+                 (in >> c.leaves >> c.captures >> c.wins >> c.rejected);
+            if (ok) positions.back().expected.push_back(expectation);
+        } else {
+            PerftPosition pos;
+            pos.name = first;
+            ok = PositionIO::read(in, pos.state);
+            if (ok) positions.push_back(pos);
+        }
+
+        if (!ok) {
+            std::cerr << "Error: " << filename << ":" << lineNumber << ": malformed line" << std::endl;
+            return false;
+        }
+    }
+    return !positions.empty();
+}
+
+static std::string moveName(const Move& move) {
+    return std::string(1, char('A' + move.y)) + std::to_string(move.x + 1);
+}
+
+// Per-root-move leaf counts, to locate a mismatch
+static void divide(const PerftPosition& pos, int depth) {
+    uint64_t total = 0;
+    for (int x = 0; x < GameState::BOARD_SIZE; x++) {
+        for (int y = 0; y < GameState::BOARD_SIZE; y++) {
+            GameState child = pos.state;
+            RuleEngine::MoveResult result = RuleEngine::applyMove(child, Move(x, y));
+            if (!result.success) continue;
+
+            uint64_t leaves = 1;
+            if (depth > 1)
+                leaves = isTerminal(child, result, pos.state.currentPlayer) ? 0 : perft(child, depth - 1).leaves;
+            std::cout << moveName(Move(x, y)) << ": " << leaves << std::endl;
+            total += leaves;
+        }
+    }
+    std::cout << "Total: " << total << std::endl;
+}
+
+// ============================================
+// Main
+// ============================================
+int main(int argc, char** argv) {
+    std::string suiteFile = "data/perft_suite.txt";
+    std::string divideName;
+    int maxDepth = DEFAULT_MAX_DEPTH;
+
+    bool validArgs = true;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--depth" && i + 1 < argc) maxDepth = std::atoi(argv[++i]);
+        else if (arg == "--divide" && i + 1 < argc) divideName = argv[++i];
+        else if (!arg.empty() && arg[0] != '-') suiteFile = arg;
+        else validArgs = false;
+    }
+    if (!validArgs || maxDepth < 1) {
+        std::cerr << "Usage: " << argv[0] << " [suite] [--depth N] [--divide NAME]" << std::endl;
+        return 2;
+    }
+
+    GameState::initializeHasher();
+
+    std::vector<PerftPosition> positions;
+    if (!loadSuite(suiteFile, positions)) {
+        GameState::cleanupHasher();
+        return 2;
+    }
+
+    if (!divideName.empty()) {
+        for (const PerftPosition& pos : positions) {
+            if (pos.name == divideName) divide(pos, maxDepth);
+        }
+        GameState::cleanupHasher();
+        return 0;
+    }
+
+    std::cout << "=== GOMOKU PERFT ===" << std::endl;
+    std::cout << std::left << std::setw(12) << "position" << std::right << std::setw(6) << "depth"
+              << std::setw(12) << "leaves" << std::setw(10) << "captures" << std::setw(8) << "wins"
+              << std::setw(10) << "rejected" << std::setw(10) << "ms" << std::setw(12) << "leaves/s"
+              << "  result" << std::endl;
+
+    int failures = 0;
+    uint64_t totalLeaves = 0;
+    double totalMs = 0.0;
+
+    for (const PerftPosition& pos : positions) {
+        for (const PerftExpectation& expectation : pos.expected) {
+            if (expectation.depth > maxDepth) continue;
+
+            auto start = std::chrono::steady_clock::now();
+            PerftCounts counts = perft(pos.state, expectation.depth);
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            bool match = counts == expectation.counts;
+            failures += !match;
+            totalLeaves += counts.leaves;
+            totalMs += ms;
+
+            std::cout << std::left << std::setw(12) << pos.name << std::right
+                      << std::setw(6) << expectation.depth
+                      << std::setw(12) << counts.leaves << std::setw(10) << counts.captures
+                      << std::setw(8) << counts.wins << std::setw(10) << counts.rejected
+                      << std::setw(10) << std::fixed << std::setprecision(1) << ms
+                      << std::setw(12) << std::setprecision(0) << (ms > 0.0 ? counts.leaves * 1000.0 / ms : 0.0)
+                      << "  " << (match ? "ok" : "MISMATCH") << std::endl;
+            if (!match) {
+                const PerftCounts& e = expectation.counts;
+                std::cout << "    expected " << e.leaves << " " << e.captures << " "
+                          << e.wins << " " << e.rejected << std::endl;
+            }
+        }
+    }
+
+    std::cout << std::endl << "Total leaves: " << totalLeaves << "  Time: " << std::setprecision(0) << totalMs
+              << " ms  Leaves/sec: " << (totalMs > 0.0 ? totalLeaves * 1000.0 / totalMs : 0.0) << std::endl;
+    std::cout << (failures == 0 ? "All counts match" : std::to_string(failures) + " mismatches") << std::endl;
+
+    GameState::cleanupHasher();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,376 @@
+// ============================================
+// SELFPLAY.CPP - Engine vs engine tournament
+// ============================================
+// Plays games between two engine settings (A and B) on several threads at
+// once and reports the score as an Elo difference, with a sequential
+// probability ratio test that stops the run as soon as the result is clear.
+//
+// - Each worker thread owns one AI per side and one GameEngine referee for
+//   the whole run; tables are cleared between games, never reallocated
+// - Games come in pairs: the same random opening (a few random plies near
+//   the centre) is played twice with colours swapped
+// - A game with no winner after --max-plies plies is adjudicated a draw
+// - --record FILE appends every game to a binary game record file
+//
+// Usage: ./selfplay [--games N] [--concurrency N] [--openings PLIES] [--seed S]
+//                   [--max-plies N] [--elo0 E] [--elo1 E] [--alpha A] [--beta B]
+//                   [--no-sprt] [--report N] [--record FILE]
+//                   [--a-rust] [--a-depth N] [--a-ms N] [--a-tt MB]  (same for --b-)
+// ============================================
+
+#include "../include/ai/ai.hpp"
+#include "../include/core/game_engine.hpp"
+#include "../include/core/game_types.hpp"
+#include "../include/rules/rule_engine.hpp"
+#include "../include/utils/game_record.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const int DEFAULT_DEPTH = 4;
+static const size_t DEFAULT_TABLE_MB = 16;
+static const uint64_t DEFAULT_SEED = 0x9E3779B97F4A7C15ULL;
+
+struct SideConfig {
+    AIImplementation implementation = CPP_IMPLEMENTATION;
+    int depth = DEFAULT_DEPTH;
+    int timeMs = 0; // 0 = depth limit only
+    size_t tableMB = DEFAULT_TABLE_MB;
+};
+
+struct SelfplayOptions {
+    SideConfig sides[2]; // A, B
+    int games = 1000;
+    int concurrency = 1;
+    int openingPlies = 4;
+    int maxPlies = 200;
+    uint64_t seed = DEFAULT_SEED;
+    bool sprt = true;
+    double elo0 = 0.0;
+    double elo1 = 10.0;
+    double alpha = 0.05;
+    double beta = 0.05;
+    int reportEvery = 10;
+    std::string recordFile;
+};
+
+// Results from A's point of view
+struct Tally {
+    int wins = 0;
+    int draws = 0;
+    int losses = 0;
+    int winsAsFirst = 0;   // A played PLAYER1
+    int lossesAsFirst = 0;
+    long long plies = 0;
+    uint64_t nodes = 0;
+    double searchMs = 0.0;
+
+    int games() const { return wins + draws + losses; }
+    double score() const { return games() > 0 ? (wins + 0.5 * draws) / games() : 0.5; }
+};
+
+// ============================================
+// Statistics
+// ============================================
+
+static double expectedScore(double elo) {
+    return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+}
+
+static double eloFromScore(double score) {
+    score = std::min(std::max(score, 1e-6), 1.0 - 1e-6);
+    return -400.0 * std::log10(1.0 / score - 1.0) + 0.0; // + 0.0: no "-0.0"
+}
+
+// Per-game variance of the score (win 1, draw 0.5, loss 0)
+static double scoreVariance(const Tally& tally) {
+    int n = tally.games();
+    if (n == 0) return 0.0;
+    double s = tally.score();
+    return (tally.wins * (1.0 - s) * (1.0 - s) + tally.draws * (0.5 - s) * (0.5 - s) +
+            tally.losses * s * s) / n;
+}
+
+// Half width of the 95% confidence interval, in Elo
+static double eloMargin(const Tally& tally) {
+    int n = tally.games();
+    if (n < 2) return 0.0;
+    double deviation = 1.96 * std::sqrt(scoreVariance(tally) / n);
+    double s = tally.score();
+    return (eloFromScore(s + deviation) - eloFromScore(s - deviation)) / 2.0;
+}
+
+/**
+ * Log-likelihood ratio of H1 (A is elo1 stronger) over H0 (elo0), normal
+ * approximation of the trinomial game score
+ */
+static double sprtLLR(const Tally& tally, double elo0, double elo1) {
+    double variance = scoreVariance(tally);
+    if (variance <= 0.0) return 0.0;
+    double s0 = expectedScore(elo0);
+    double s1 = expectedScore(elo1);
+    return tally.games() * (s1 - s0) * (2.0 * tally.score() - s0 - s1) / (2.0 * variance);
+}
+
+// ============================================
+// Games
+// ============================================
+
+struct GameResult {
+    int scoreForA; // 2 win, 1 draw, 0 loss
+    bool aFirst;
+    int plies;
+    uint64_t nodes;
+    double searchMs;
+};
+
+// Engines and referee of one worker thread, built once
+struct Worker {
+    GameEngine referee;
+    AI engines[2];
+
+    explicit Worker(const SelfplayOptions& options)
+        : engines{AI(options.sides[0].depth, options.sides[0].implementation, options.sides[0].tableMB),
+                  AI(options.sides[1].depth, options.sides[1].implementation, options.sides[1].tableMB)} {
+        referee.setAITableSize(1); // Only used for the rules
+        referee.setGameMode(GameMode::VS_HUMAN_SUGGESTED);
+        for (int side = 0; side < 2; side++)
+            engines[side].setTimeLimit(options.sides[side].timeMs);
+    }
+};
+
+// Game `index` uses opening index / 2; odd games swap colours
+static GameResult playGame(Worker& worker, const SelfplayOptions& options, int index) {
+    GameResult result = {1, index % 2 == 0, 0, 0, 0.0};
+    GameEngine& referee = worker.referee;
+
+    // Redraw the opening in the (unlikely) case the random plies end the game
+    uint64_t openingSeed = options.seed + (uint64_t)(index / 2) * 0x100000001B3ULL;
+    for (bool opened = false; !opened; openingSeed++) {
+        std::mt19937_64 random(openingSeed);
+        referee.newGame();
+        opened = referee.playRandomOpening(options.openingPlies, random);
+    }
+    for (AI& engine : worker.engines)
+        engine.clearCache();
+
+    int sideOfFirst = result.aFirst ? 0 : 1;
+    while (!referee.isGameOver() && result.plies < options.maxPlies) {
+        const GameState& state = referee.getState();
+        int side = state.currentPlayer == GameState::PLAYER1 ? sideOfFirst : 1 - sideOfFirst;
+        AI& engine = worker.engines[side];
+
+        auto start = std::chrono::steady_clock::now();
+        TranspositionSearch::SearchResult search = engine.findBestMoveIterative(state, options.sides[side].depth);
+        result.searchMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        result.nodes += search.nodesEvaluated;
+
+        Move move = search.bestMove;
+        if (!move.isValid() || !RuleEngine::isLegalMove(state, move))
+            move = RuleEngine::findCentralLegalMove(state);
+        if (!move.isValid())
+            break; // Board full: draw
+        if (!referee.makeHumanMove(move)) {
+            std::cerr << "Warning: game " << index << ": move rejected, " << (side == 0 ? "A" : "B")
+                      << " forfeits" << std::endl;
+            result.scoreForA = side == 0 ? 0 : 2;
+            return result;
+        }
+        result.plies++;
+    }
+
+    int winner = referee.isGameOver() ? referee.getWinner() : 0;
+    if (winner != 0) {
+        bool aWon = (winner == GameState::PLAYER1) == result.aFirst;
+        result.scoreForA = aWon ? 2 : 0;
+    }
+    return result;
+}
+
+// ============================================
+// Tournament
+// ============================================
+
+static std::string describeSide(const SideConfig& side) {
+    std::string text = side.implementation == RUST_IMPLEMENTATION ? "Rust" : "C++";
+    text += " depth " + std::to_string(side.depth);
+    if (side.timeMs > 0) text += ", " + std::to_string(side.timeMs) + " ms/move";
+    return text + ", " + std::to_string(side.tableMB) + " MB table";
+}
+
+static void printStatus(std::ostream& out, const Tally& tally, const SelfplayOptions& options, double seconds) {
+    out << "games " << std::setw(5) << tally.games()
+        << "  W-D-L " << tally.wins << "-" << tally.draws << "-" << tally.losses
+        << std::fixed << std::setprecision(1)
+        << "  Elo " << std::showpos << eloFromScore(tally.score()) << std::noshowpos
+        << " +/- " << eloMargin(tally);
+    if (options.sprt)
+        out << std::setprecision(2) << "  LLR " << sprtLLR(tally, options.elo0, options.elo1);
+    out << std::setprecision(0) << "  games/h " << (seconds > 0.0 ? tally.games() * 3600.0 / seconds : 0.0)
+        << std::endl;
+}
+
+static bool parseSideOption(const std::string& arg, int argc, char** argv, int& i, SideConfig& side) {
+    bool hasValue = i + 1 < argc;
+    if (arg == "rust") side.implementation = RUST_IMPLEMENTATION;
+    else if (arg == "depth" && hasValue) side.depth = std::atoi(argv[++i]);
+    else if (arg == "ms" && hasValue) side.timeMs = std::atoi(argv[++i]);
+    else if (arg == "tt" && hasValue) side.tableMB = std::strtoul(argv[++i], nullptr, 10);
+    else return false;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    SelfplayOptions options;
+    options.concurrency = (int)std::max(1u, std::thread::hardware_concurrency());
+
+    bool validArgs = true;
+    for (int i = 1; i < argc && validArgs; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--games" && hasValue) options.games = std::atoi(argv[++i]);
+        else if (arg == "--concurrency" && hasValue) options.concurrency = std::atoi(argv[++i]);
+        else if (arg == "--openings" && hasValue) options.openingPlies = std::atoi(argv[++i]);
+        else if (arg == "--seed" && hasValue) options.seed = std::strtoull(argv[++i], nullptr, 0);
+        else if (arg == "--max-plies" && hasValue) options.maxPlies = std::atoi(argv[++i]);
+        else if (arg == "--elo0" && hasValue) options.elo0 = std::atof(argv[++i]);
+        else if (arg == "--elo1" && hasValue) options.elo1 = std::atof(argv[++i]);
+        else if (arg == "--alpha" && hasValue) options.alpha = std::atof(argv[++i]);
+        else if (arg == "--beta" && hasValue) options.beta = std::atof(argv[++i]);
+        else if (arg == "--no-sprt") options.sprt = false;
+        else if (arg == "--report" && hasValue) options.reportEvery = std::atoi(argv[++i]);
+        else if (arg == "--record" && hasValue) options.recordFile = argv[++i];
+        else if (arg.compare(0, 4, "--a-") == 0) validArgs = parseSideOption(arg.substr(4), argc, argv, i, options.sides[0]);
+        else if (arg.compare(0, 4, "--b-") == 0) validArgs = parseSideOption(arg.substr(4), argc, argv, i, options.sides[1]);
+        else validArgs = false;
+    }
+    for (const SideConfig& side : options.sides)
+        validArgs = validArgs && side.depth >= 1 && side.depth <= 20 && side.timeMs >= 0 && side.tableMB >= 1;
+    if (!validArgs || options.games < 1 || options.concurrency < 1 || options.openingPlies < 0 ||
+        options.openingPlies > 20 || options.maxPlies < 1 || options.reportEvery < 1 ||
+        options.elo1 <= options.elo0 || options.alpha <= 0.0 || options.alpha >= 1.0 ||
+        options.beta <= 0.0 || options.beta >= 1.0) {
+        std::cerr << "Usage: " << argv[0] << " [--games N] [--concurrency N] [--openings PLIES] [--seed S]\n"
+                  << "       [--max-plies N] [--elo0 E] [--elo1 E] [--alpha A] [--beta B] [--no-sprt] [--report N]\n"
+                  << "       [--record FILE]\n"
+                  << "       [--a-rust] [--a-depth 1-20] [--a-ms N] [--a-tt MB]  (same for --b-)" << std::endl;
+        return 2;
+    }
+    options.concurrency = std::min(options.concurrency, options.games);
+
+    // Search and table code log to std::cout: silence it, report on the real stdout
+    std::ostream out(std::cout.rdbuf());
+    std::streambuf* consoleBuffer = std::cout.rdbuf(nullptr);
+
+    GameRecordWriter recorder;
+    if (!options.recordFile.empty() && !recorder.open(options.recordFile)) {
+        std::cout.rdbuf(consoleBuffer);
+        return 2;
+    }
+
+    GameState::initializeHasher(options.seed);
+
+    double lowerBound = std::log(options.beta / (1.0 - options.alpha));
+    double upperBound = std::log((1.0 - options.beta) / options.alpha);
+
+    out << "=== SELFPLAY (" << options.games << " games max, " << options.concurrency << " threads, "
+        << options.openingPlies << " random opening plies) ===" << std::endl;
+    out << "A: " << describeSide(options.sides[0]) << std::endl;
+    out << "B: " << describeSide(options.sides[1]) << std::endl;
+    if (options.sprt)
+        out << std::fixed << std::setprecision(2) << "SPRT: elo0 " << options.elo0 << ", elo1 " << options.elo1
+            << ", alpha " << options.alpha << ", beta " << options.beta
+            << " -> LLR bounds [" << lowerBound << ", " << upperBound << "]" << std::endl;
+
+    Tally tally;
+    std::mutex tallyMutex;
+    std::atomic<int> nextGame(0);
+    std::atomic<bool> stop(false);
+    auto start = std::chrono::steady_clock::now();
+    auto elapsedSeconds = [&start]() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    auto runWorker = [&]() {
+        Worker worker(options);
+        while (!stop.load()) {
+            int index = nextGame++;
+            if (index >= options.games)
+                break;
+            GameResult result = playGame(worker, options, index);
+
+            std::lock_guard<std::mutex> lock(tallyMutex);
+            if (result.scoreForA == 2) {
+                tally.wins++;
+                tally.winsAsFirst += result.aFirst;
+            } else if (result.scoreForA == 0) {
+                tally.losses++;
+                tally.lossesAsFirst += result.aFirst;
+            } else {
+                tally.draws++;
+            }
+            tally.plies += result.plies;
+            tally.nodes += result.nodes;
+            tally.searchMs += result.searchMs;
+            if (recorder.isOpen()) {
+                GameRecord record = worker.referee.getGameRecord();
+                bool firstWon = (result.scoreForA == 2) == result.aFirst;
+                record.result = result.scoreForA == 1 ? GameRecord::DRAW
+                              : firstWon ? GameRecord::PLAYER1_WINS : GameRecord::PLAYER2_WINS;
+                recorder.writeGame(record);
+            }
+
+            if (tally.games() % options.reportEvery == 0)
+                printStatus(out, tally, options, elapsedSeconds());
+            if (options.sprt) {
+                double llr = sprtLLR(tally, options.elo0, options.elo1);
+                if (llr <= lowerBound || llr >= upperBound)
+                    stop.store(true);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < options.concurrency; i++)
+        threads.emplace_back(runWorker);
+    for (std::thread& thread : threads)
+        thread.join();
+    double seconds = elapsedSeconds();
+
+    int games = tally.games();
+    out << std::endl;
+    printStatus(out, tally, options, seconds);
+    out << std::fixed << std::setprecision(1)
+        << "A as first player:  " << tally.winsAsFirst << " wins, " << tally.lossesAsFirst << " losses" << std::endl
+        << "A as second player: " << tally.wins - tally.winsAsFirst << " wins, "
+        << tally.losses - tally.lossesAsFirst << " losses" << std::endl
+        << "Average game:       " << (games > 0 ? (double)tally.plies / games : 0.0) << " plies" << std::endl
+        << "Wall time:          " << seconds << " s" << std::endl
+        << std::setprecision(0)
+        << "Nodes/second:       " << (tally.searchMs > 0.0 ? tally.nodes * 1000.0 / tally.searchMs : 0.0)
+        << " (per thread)" << std::endl
+        << "Games/hour:         " << (seconds > 0.0 ? games * 3600.0 / seconds : 0.0) << std::endl;
+
+    if (options.sprt) {
+        double llr = sprtLLR(tally, options.elo0, options.elo1);
+        out << "SPRT: ";
+        if (llr >= upperBound) out << "H1 accepted (A - B closer to " << options.elo1 << " than to " << options.elo0 << " Elo)";
+        else if (llr <= lowerBound) out << "H0 accepted (A - B closer to " << options.elo0 << " than to " << options.elo1 << " Elo)";
+        else out << "inconclusive after " << games << " games";
+        out << std::endl;
+    }
+
+    recorder.close();
+    GameState::cleanupHasher();
+    std::cout.rdbuf(consoleBuffer);
+    return 0;
+}
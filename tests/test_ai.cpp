@@ -2,16 +2,33 @@
 // TEST_AI.CPP — Comprehensive Test Suite
 // Tests for: GameState, Move, RuleEngine,
 //            Evaluator, AI, TranspositionSearch,
-//            SuggestionEngine, GameEngine
+//            SuggestionEngine, GameEngine, DebugLogWriter,
+//            PiskvorkProtocol, AnalysisServer, GameRecord,
+//            NnueNetwork, PatternScanner, Board,
+//            ThreatScanner
 // ============================================
 
 #include "../include/ai/ai.hpp"
 #include "../include/ai/evaluator.hpp"
+#include "../include/ai/game_analyzer.hpp"
+#include "../include/ai/nnue.hpp"
+#include "../include/ai/pattern_scanner.hpp"
+#include "../include/ai/rust_ai_wrapper.hpp"
 #include "../include/ai/suggestion_engine.hpp"
+#include "../include/ai/threat_scanner.hpp"
 #include "../include/core/game_types.hpp"
 #include "../include/core/game_engine.hpp"
 #include "../include/rules/rule_engine.hpp"
+#include "../include/debug/debug_log_writer.hpp"
+#include "../include/engine/analysis_server.hpp"
+#include "../include/engine/piskvork_protocol.hpp"
+#include "../include/utils/game_record.hpp"
+#include "../include/utils/position_io.hpp"
+#include "../include/utils/trace_recorder.hpp"
+#include "../include/utils/training_data.hpp"
 #include <iostream>
+#include <fstream>
+#include <cstdio>
 #include <cassert>
 #include <cstring>
 #include <vector>
@@ -20,6 +37,14 @@
 #include <functional>
 #include <string>
 #include <cmath>
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
 
 // ============================================
 // Test framework helpers
@@ -119,6 +144,20 @@ static void placeLine(GameState& s, int startX, int startY, int dx, int dy, int
     }
 }
 
+// Helper: run `body` with std::cerr captured, return what it printed
+static std::string capturedErrors(const std::function<void()>& body) {
+    std::ostringstream errors;
+    std::streambuf* previous = std::cerr.rdbuf(errors.rdbuf());
+    try {
+        body();
+    } catch (...) {
+        std::cerr.rdbuf(previous);
+        throw;
+    }
+    std::cerr.rdbuf(previous);
+    return errors.str();
+}
+
 // ============================================
 //  1. Move Struct Tests
 // ============================================
@@ -290,6 +329,34 @@ static void testGameState() {
         ASSERT_EQ(s.pendingWinPlayer, 0);
         ASSERT(s.forcedCaptureMoves.empty());
     } END_TEST;
+
+    TEST("PositionIO text round-trip") {
+        GameState s = freshState();
+        placeStone(s, 0, 0, GameState::PLAYER1);
+        placeStone(s, 9, 9, GameState::PLAYER2);
+        placeStone(s, 9, 10, GameState::PLAYER2);
+        placeStone(s, 18, 18, GameState::PLAYER1);
+        s.captures[0] = 2;
+        s.currentPlayer = GameState::PLAYER2;
+        s.recalculateHash();
+
+        std::string text = PositionIO::format(s);
+        ASSERT_EQ(text.substr(0, 6), std::string("O 2 0 "));
+
+        GameState parsed;
+        std::istringstream in(text);
+        ASSERT(PositionIO::read(in, parsed));
+        ASSERT_EQ(parsed.board[0][0], GameState::PLAYER1);
+        ASSERT_EQ(parsed.board[9][10], GameState::PLAYER2);
+        ASSERT_EQ(parsed.board[18][18], GameState::PLAYER1);
+        ASSERT_EQ(parsed.currentPlayer, GameState::PLAYER2);
+        ASSERT_EQ(parsed.turnCount, 8);
+        ASSERT_EQ(parsed.getZobristHash(), s.getZobristHash());
+        ASSERT_EQ(PositionIO::format(parsed), text);
+
+        std::istringstream bad("X 0 0 19/19/19");
+        ASSERT(!PositionIO::read(bad, parsed));
+    } END_TEST;
 }
 
 // ============================================
@@ -1126,6 +1193,118 @@ static void testTranspositionSearch() {
         ASSERT_LT(result.score, 10000000);
         ASSERT_GT(result.score, -10000000);
     } END_TEST;
+
+    TEST("Search stats: one consistent entry per iteration") {
+        GameState s = freshState();
+        placeStone(s, 9, 9, GameState::PLAYER1);
+        placeStone(s, 9, 10, GameState::PLAYER2);
+        placeStone(s, 10, 10, GameState::PLAYER1);
+        s.currentPlayer = GameState::PLAYER2;
+        s.turnCount = 3;
+        s.recalculateHash();
+
+        AI ai(4, CPP_IMPLEMENTATION);
+        auto result = ai.findBestMoveIterative(s, 4);
+        const auto& stats = ai.getLastSearchStats();
+        ASSERT_EQ(stats.size(), (size_t)4);
+
+        uint64_t totalNodes = 0;
+        for (size_t i = 0; i < stats.size(); i++) {
+            const SearchStats& it = stats[i];
+            ASSERT_EQ(it.depth, (int)i + 1);
+            ASSERT_GT(it.nodes, (uint64_t)0);
+            ASSERT(it.ttHits <= it.ttProbes);
+            ASSERT(it.ttCutoffs() <= it.ttHits);
+            ASSERT(it.firstMoveCutoffs <= it.betaCutoffs);
+            ASSERT(it.killerHits <= it.betaCutoffs);
+            ASSERT(it.lmrResearches <= it.lmrReductions);
+            ASSERT(it.leafEvals <= it.nodes);
+            totalNodes += it.nodes;
+        }
+        ASSERT_EQ(totalNodes, (uint64_t)result.nodesEvaluated);
+        ASSERT(stats.back().bestMove == result.bestMove);
+        ASSERT_EQ(stats.back().score, result.score);
+    } END_TEST;
+
+    TEST("Search stats exported as JSON lines") {
+        const std::string path = "test_search_stats.jsonl";
+        std::remove(path.c_str());
+
+        GameState s = freshState();
+        placeStone(s, 9, 9, GameState::PLAYER1);
+        s.currentPlayer = GameState::PLAYER2;
+        s.turnCount = 1;
+        s.recalculateHash();
+
+        AI ai(3, CPP_IMPLEMENTATION);
+        ai.setStatsLogFile(path);
+        ai.findBestMoveIterative(s, 3);
+
+        std::ifstream in(path);
+        std::string line;
+        int lines = 0;
+        while (std::getline(in, line)) {
+            lines++;
+            ASSERT_EQ(line.front(), '{');
+            ASSERT_EQ(line.back(), '}');
+            ASSERT(line.find("\"depth\":" + std::to_string(lines)) != std::string::npos);
+            ASSERT(line.find("\"tt_cutoffs\":{") != std::string::npos);
+        }
+        ASSERT_EQ(lines, (int)ai.getLastSearchStats().size());
+        std::remove(path.c_str());
+    } END_TEST;
+
+    TEST("Trace recorder writes iteration spans") {
+        const std::string path = "test_trace.json";
+        std::remove(path.c_str());
+
+        GameState s = freshState();
+        placeStone(s, 9, 9, GameState::PLAYER1);
+        s.currentPlayer = GameState::PLAYER2;
+        s.turnCount = 1;
+        s.recalculateHash();
+
+        TraceRecorder::start(path);
+        AI ai(3, CPP_IMPLEMENTATION);
+        ai.findBestMoveIterative(s, 3);
+        ASSERT_GT(TraceRecorder::getEventCount(), (size_t)3);
+        ASSERT(TraceRecorder::writeAndStop());
+        ASSERT(!TraceRecorder::isEnabled());
+
+        std::ifstream in(path);
+        std::stringstream content;
+        content << in.rdbuf();
+        std::string json = content.str();
+        ASSERT(json.find("\"traceEvents\":[") != std::string::npos);
+        ASSERT(json.find("\"name\":\"iteration\"") != std::string::npos);
+        ASSERT(json.find("\"name\":\"root move\"") != std::string::npos);
+        ASSERT_EQ(json.substr(json.size() - 4), std::string("\n]}\n"));
+        std::remove(path.c_str());
+    } END_TEST;
+
+    TEST("Time limit keeps the last completed iteration") {
+        GameState s = freshState();
+        placeLine(s, 8, 8, 0, 1, 3, GameState::PLAYER1);
+        placeLine(s, 9, 7, 1, 1, 3, GameState::PLAYER2);
+        placeStone(s, 7, 10, GameState::PLAYER2);
+        s.currentPlayer = GameState::PLAYER1;
+        s.turnCount = 7;
+        s.recalculateHash();
+
+        TranspositionSearch search(8);
+        search.setTimeLimit(30);
+        auto start = std::chrono::steady_clock::now();
+        auto result = search.findBestMoveIterative(s, 10);
+        auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count();
+
+        ASSERT(result.bestMove.isValid());
+        ASSERT(s.isEmpty(result.bestMove.x, result.bestMove.y));
+        ASSERT_GE(search.getLastSearchStats().size(), (size_t)1);
+        ASSERT_LT(search.getLastSearchStats().size(), (size_t)10);
+        ASSERT(search.getLastSearchStats().back().bestMove == result.bestMove);
+        ASSERT_LT(elapsedMs, 1000);
+    } END_TEST;
 }
 
 // ============================================
@@ -1426,6 +1605,30 @@ static void testZobristHashing() {
 
         ASSERT_EQ(s1.getZobristHash(), s2.getZobristHash());
     } END_TEST;
+
+    TEST("Seeded hasher reproduces keys across initializations") {
+        GameState s = freshState();
+        placeStone(s, 9, 9, GameState::PLAYER1);
+        placeStone(s, 10, 10, GameState::PLAYER2);
+
+        GameState::initializeHasher(42);
+        s.recalculateHash();
+        uint64_t first = s.getZobristHash();
+
+        GameState::initializeHasher(42);
+        s.recalculateHash();
+        uint64_t again = s.getZobristHash();
+
+        GameState::initializeHasher(43);
+        s.recalculateHash();
+        uint64_t other = s.getZobristHash();
+
+        // Back to the default keys before any assert can leave the test
+        GameState::cleanupHasher();
+        GameState::initializeHasher();
+        ASSERT_EQ(again, first);
+        ASSERT_NE(other, first);
+    } END_TEST;
 }
 
 // ============================================
@@ -1828,6 +2031,140 @@ static void testGameSimulation() {
                   << ", Rust: " << (char)('A' + rustMove.y) << rustMove.x + 1 << ") ";
     } END_TEST;
 
+    TEST("Rust search result matches getBestMove and reports nodes") {
+        GameState s = freshState();
+        placeStone(s, 9, 9, GameState::PLAYER1);
+        placeStone(s, 8, 8, GameState::PLAYER2);
+        placeStone(s, 9, 10, GameState::PLAYER1);
+        s.currentPlayer = GameState::PLAYER2;
+        s.turnCount = 3;
+
+        SearchResult result = RustAIWrapper::search(s, 4);
+        Move direct = RustAIWrapper::getBestMove(s, 4);
+
+        ASSERT(result.bestMove.isValid());
+        ASSERT(result.bestMove == direct);
+        ASSERT(result.nodesEvaluated > 0);
+    } END_TEST;
+
+    TEST("Rust engine handle keeps its table between searches") {
+        GameState s = freshState();
+        placeStone(s, 9, 9, GameState::PLAYER1);
+        placeStone(s, 8, 8, GameState::PLAYER2);
+        placeStone(s, 9, 10, GameState::PLAYER1);
+        s.currentPlayer = GameState::PLAYER2;
+        s.turnCount = 3;
+
+        RustAIWrapper engine(8);
+        SearchResult first = engine.findBestMove(s, 4);
+        SearchResult second = engine.findBestMove(s, 4);
+        ASSERT(first.bestMove.isValid());
+        ASSERT(second.bestMove == first.bestMove);
+        ASSERT(second.nodesEvaluated < first.nodesEvaluated);
+
+        engine.clearCache();
+        SearchResult cleared = engine.findBestMove(s, 4);
+        ASSERT(cleared.bestMove == first.bestMove);
+        ASSERT_EQ(cleared.nodesEvaluated, first.nodesEvaluated);
+    } END_TEST;
+
+    TEST("Rust AI reports score, nodes and per-iteration stats") {
+        GameState s = freshState();
+        placeStone(s, 9, 9, GameState::PLAYER1);
+        placeStone(s, 8, 8, GameState::PLAYER2);
+        placeStone(s, 9, 10, GameState::PLAYER1);
+        s.currentPlayer = GameState::PLAYER2;
+        s.turnCount = 3;
+
+        AI rustAi(4, RUST_IMPLEMENTATION);
+        TranspositionSearch::SearchResult result = rustAi.findBestMoveIterative(s, 4);
+        const std::vector<SearchStats>& iterations = rustAi.getLastSearchStats();
+
+        ASSERT(result.bestMove.isValid());
+        ASSERT(result.nodesEvaluated > 0);
+        ASSERT_EQ((int)iterations.size(), 4);
+        uint64_t nodes = 0;
+        for (size_t i = 0; i < iterations.size(); i++) {
+            ASSERT_EQ(iterations[i].depth, (int)i + 1);
+            nodes += iterations[i].nodes;
+        }
+        ASSERT_EQ((int)nodes, result.nodesEvaluated);
+        ASSERT(iterations.back().bestMove == result.bestMove);
+        ASSERT_EQ(iterations.back().score, result.score);
+    } END_TEST;
+
+    TEST("Rust search stop flag returns last completed iteration") {
+        GameState s = freshState();
+        placeStone(s, 9, 9, GameState::PLAYER1);
+        placeStone(s, 8, 8, GameState::PLAYER2);
+        placeStone(s, 9, 10, GameState::PLAYER1);
+        s.currentPlayer = GameState::PLAYER2;
+        s.turnCount = 3;
+
+        // Cancel from the progress callback once depth 2 is complete
+        RustAIWrapper engine(8);
+        std::atomic<int> stop(0);
+        Move depth2Move;
+        SearchResult result = engine.findBestMove(s, 10, [&](const SearchStats& iteration) {
+            if (iteration.depth == 2) {
+                depth2Move = iteration.bestMove;
+                stop.store(1);
+            }
+        }, &stop);
+        ASSERT_EQ(engine.getLastDepth(), 2);
+        ASSERT(result.bestMove == depth2Move);
+        ASSERT(engine.getLastElapsedUs() > 0);
+    } END_TEST;
+
+    TEST("Rust batch evaluation matches single-position calls") {
+        std::vector<GameState> states(3, freshState());
+        placeStone(states[1], 9, 9, GameState::PLAYER1);
+        placeStone(states[1], 9, 10, GameState::PLAYER1);
+        placeStone(states[2], 9, 9, GameState::PLAYER1);
+        placeStone(states[2], 8, 8, GameState::PLAYER2);
+        placeStone(states[2], 8, 9, GameState::PLAYER2);
+        states[2].captures[1] = 3;
+        states[2].currentPlayer = GameState::PLAYER2;
+
+        std::vector<FfiPosition> positions;
+        for (const GameState& state : states)
+            positions.push_back(packPosition(state));
+        ASSERT_EQ(positions[2].cells[8 * GameState::BOARD_SIZE + 9], GameState::PLAYER2);
+        ASSERT_EQ(positions[2].captures[1], 3);
+
+        std::vector<int> scores = RustAIWrapper::evaluatePositions(positions);
+        ASSERT_EQ((int)scores.size(), 3);
+        for (size_t i = 0; i < states.size(); i++)
+            ASSERT_EQ(scores[i], RustAIWrapper::evaluatePosition(states[i]));
+        ASSERT(scores[1] != scores[0]);
+    } END_TEST;
+
+    TEST("Rust Lazy SMP search completes on 4 threads") {
+        GameState s = freshState();
+        placeStone(s, 9, 9, GameState::PLAYER1);
+        placeStone(s, 8, 8, GameState::PLAYER2);
+        placeStone(s, 9, 10, GameState::PLAYER1);
+        s.currentPlayer = GameState::PLAYER2;
+        s.turnCount = 3;
+
+        RustAIWrapper single(8);
+        SearchResult reference = single.findBestMove(s, 4);
+
+        RustAIWrapper smp(8, 4);
+        SearchResult result = smp.findBestMove(s, 4);
+        ASSERT(result.bestMove.isValid());
+        ASSERT(s.isEmpty(result.bestMove.x, result.bestMove.y));
+        ASSERT_EQ(smp.getLastDepth(), 4);
+        ASSERT(result.nodesEvaluated > 0);
+
+        // Back to one thread on a cleared table: same search as a fresh engine
+        smp.setThreads(1);
+        smp.clearCache();
+        SearchResult again = smp.findBestMove(s, 4);
+        ASSERT(again.bestMove == reference.bestMove);
+        ASSERT_EQ(again.nodesEvaluated, reference.nodesEvaluated);
+    } END_TEST;
+
     TEST("C++ vs Rust cross-play game completes") {
         GameEngine engine;
         engine.newGame();
@@ -1860,9 +2197,1022 @@ static void testGameSimulation() {
     } END_TEST;
 }
 
+// ============================================
+// 20. Debug Log Writer Tests
+// ============================================
+static int countLogLines(const std::string& path, const std::string& prefix) {
+    std::ifstream in(path);
+    std::string line;
+    int count = 0;
+    while (std::getline(in, line)) {
+        if (line.compare(0, prefix.size(), prefix) == 0) count++;
+    }
+    return count;
+}
+
+static void testDebugLogWriter() {
+    SECTION("Debug Log Writer");
+
+    const std::string path = "test_debug_writer.log";
+
+    TEST("Records reach the file in order after flush") {
+        std::remove(path.c_str());
+        DebugLogWriter writer;
+        ASSERT(writer.open(path));
+        for (int i = 0; i < 100; i++) {
+            ASSERT(writer.push("rec " + std::to_string(i)));
+        }
+        writer.flush();
+
+        std::ifstream in(path);
+        std::string line;
+        int expected = 0;
+        while (std::getline(in, line)) {
+            ASSERT_EQ(line, "rec " + std::to_string(expected));
+            expected++;
+        }
+        ASSERT_EQ(expected, 100);
+        writer.close();
+    } END_TEST;
+
+    TEST("Full ring drops records instead of blocking") {
+        std::remove(path.c_str());
+        DebugLogWriter writer(8);
+        ASSERT_EQ(writer.getCapacity(), (size_t)8);
+        ASSERT(writer.open(path));
+
+        const int total = 20000;
+        int accepted = 0;
+        for (int i = 0; i < total; i++) {
+            if (writer.push("msg " + std::to_string(i))) accepted++;
+        }
+        writer.close();
+
+        ASSERT_EQ((uint64_t)(total - accepted), writer.getDroppedCount());
+        ASSERT_EQ(countLogLines(path, "msg "), accepted);
+        if (writer.getDroppedCount() > 0) {
+            ASSERT_GT(countLogLines(path, "[LOG] "), 0);
+        }
+    } END_TEST;
+
+    TEST("Oversized records are truncated to the slot size") {
+        std::remove(path.c_str());
+        DebugLogWriter writer;
+        ASSERT(writer.open(path));
+        ASSERT(writer.push(std::string(DebugLogWriter::RECORD_SIZE * 2, 'x')));
+        writer.flush();
+        ASSERT_EQ(writer.getTruncatedCount(), (uint64_t)1);
+
+        std::ifstream in(path);
+        std::string line;
+        std::getline(in, line);
+        ASSERT_GT(line.size(), (size_t)0);
+        ASSERT_LT(line.size(), DebugLogWriter::RECORD_SIZE);
+        writer.close();
+    } END_TEST;
+
+    TEST("Push after close is rejected") {
+        DebugLogWriter writer;
+        ASSERT(writer.open(path));
+        writer.close();
+        ASSERT(!writer.isOpen());
+        ASSERT(!writer.push("late"));
+    } END_TEST;
+
+    std::remove(path.c_str());
+}
+
+// ============================================
+// 21. Piskvork Protocol Tests
+// ============================================
+static std::vector<std::string> protocolReplies(PiskvorkProtocol& protocol, std::ostringstream& out,
+                                                const std::vector<std::string>& commands) {
+    out.str("");
+    for (const std::string& command : commands)
+        protocol.handleLine(command);
+    std::vector<std::string> replies;
+    std::istringstream in(out.str());
+    std::string line;
+    while (std::getline(in, line))
+        replies.push_back(line);
+    return replies;
+}
+
+static void testPiskvorkProtocol() {
+    SECTION("Piskvork Protocol");
+
+    TEST("START, BEGIN and TURN use x = column, y = row") {
+        std::ostringstream out;
+        PiskvorkProtocol protocol(out, CPP_IMPLEMENTATION, 2);
+        auto replies = protocolReplies(protocol, out, {"INFO timeout_turn 0", "start 19", "BEGIN"});
+        ASSERT_EQ(replies.size(), (size_t)2);
+        ASSERT_EQ(replies[0], std::string("OK"));
+        ASSERT_EQ(protocol.getState().turnCount, 1);
+        ASSERT_EQ(protocol.getOwnPlayer(), GameState::PLAYER1);
+
+        replies = protocolReplies(protocol, out, {"TURN 3,12"});
+        ASSERT_EQ(replies.size(), (size_t)1);
+        ASSERT_EQ(protocol.getState().board[12][3], GameState::PLAYER2);
+        ASSERT_EQ(protocol.getState().turnCount, 3);
+        std::string engineMove = replies[0];
+
+        // 3,12 is no longer the last stone: only the engine's reply can be taken back
+        replies = protocolReplies(protocol, out, {"TURN 3,12", "TAKEBACK 3,12", "TAKEBACK " + engineMove,
+                                                  "START 15", "YXSHOWINFO"});
+        ASSERT_EQ(replies[0].compare(0, 5, "ERROR"), 0);
+        ASSERT_EQ(replies[1].compare(0, 5, "ERROR"), 0);
+        ASSERT_EQ(replies[2], std::string("OK"));
+        ASSERT_EQ(replies[3].compare(0, 5, "ERROR"), 0);
+        ASSERT_EQ(replies[4], std::string("UNKNOWN YXSHOWINFO"));
+        ASSERT_EQ(protocol.getState().turnCount, 2);
+        ASSERT(!protocol.handleLine("END"));
+    } END_TEST;
+
+    TEST("BOARD with CAPTURES: winning capture is played and reported") {
+        std::ostringstream out;
+        PiskvorkProtocol protocol(out, CPP_IMPLEMENTATION, 4);
+        // Engine (who 1) has 9 pairs; 8,5 captures 6,5 and 7,5 for the 10th.
+        // Both sides placed 21 stones, so the engine began
+        auto replies = protocolReplies(protocol, out, {
+            "INFO timeout_turn 1000", "START 19", "BOARD",
+            "6,5,2", "5,5,1", "7,5,2", "10,10,2", "12,14,1", "14,3,1", "CAPTURES 9,9", "DONE"});
+        ASSERT_EQ(replies.size(), (size_t)3);
+        ASSERT_EQ(replies[1], std::string("MESSAGE CAPTURED 7,5 6,5"));
+        ASSERT_EQ(replies[2], std::string("8,5"));
+
+        const GameState& state = protocol.getState();
+        ASSERT_EQ(protocol.getOwnPlayer(), GameState::PLAYER1);
+        ASSERT_EQ(state.captures[0], 10);
+        ASSERT_EQ(state.board[5][6], GameState::EMPTY);
+        ASSERT_EQ(state.board[5][7], GameState::EMPTY);
+        ASSERT(RuleEngine::checkWin(state, GameState::PLAYER1));
+
+        // One stone more for the opponent: it began, whatever the line order
+        replies = protocolReplies(protocol, out, {
+            "START 19", "BOARD", "9,9,1", "10,10,2", "8,8,2", "DONE"});
+        ASSERT_EQ(protocol.getOwnPlayer(), GameState::PLAYER2);
+        ASSERT_EQ(protocol.getState().board[10][10], GameState::PLAYER1);
+        replies = protocolReplies(protocol, out, {"START 19", "BOARD", "9,9,1", "10,10,1", "8,8,2", "DONE"});
+        ASSERT_EQ(replies[1].compare(0, 5, "ERROR"), 0);
+    } END_TEST;
+
+    TEST("INFO limits set the move budget and table size") {
+        std::ostringstream out;
+        PiskvorkProtocol protocol(out);
+        ASSERT_EQ(protocol.getMoveTimeLimit(), PiskvorkProtocol::DEFAULT_TURN_MS - 50);
+        ASSERT_EQ(protocol.getTableSizeMB(), (size_t)0);
+
+        protocolReplies(protocol, out, {"INFO timeout_turn 0"});
+        ASSERT_EQ(protocol.getMoveTimeLimit(), 1);
+
+        // Match clock: remaining time is spread over 20 moves
+        protocolReplies(protocol, out, {"INFO timeout_turn 5000", "INFO timeout_match 100000",
+                                        "INFO time_left 20000"});
+        ASSERT_EQ(protocol.getMoveTimeLimit(), 950);
+
+        protocolReplies(protocol, out, {"INFO max_memory 41943040"});
+        ASSERT_EQ(protocol.getTableSizeMB(), (size_t)24);
+        protocolReplies(protocol, out, {"INFO max_memory 1073741824"});
+        ASSERT_EQ(protocol.getTableSizeMB(), TranspositionSearch::DEFAULT_TABLE_MB);
+        ASSERT(out.str().empty());
+
+        // The Rust engine no longer splits the budget with the C++ table it does not use
+        std::ostringstream rustOut;
+        PiskvorkProtocol rust(rustOut, RUST_IMPLEMENTATION);
+        protocolReplies(rust, rustOut, {"INFO max_memory 41943040"});
+        ASSERT_EQ(rust.getTableSizeMB(), (size_t)24);
+    } END_TEST;
+}
+
+// ============================================
+// 22. Analysis Server Tests
+// ============================================
+// Collects replies from the caller and from the workers
+struct ServerReplies {
+    std::mutex mutex;
+    std::condition_variable arrived;
+    std::vector<std::string> lines;
+
+    AnalysisServer::ReplySink sink() {
+        return [this](const std::string& line) {
+            std::lock_guard<std::mutex> lock(mutex);
+            lines.push_back(line);
+            arrived.notify_all();
+        };
+    }
+    bool waitFor(size_t count) {
+        std::unique_lock<std::mutex> lock(mutex);
+        return arrived.wait_for(lock, std::chrono::seconds(10), [&] { return lines.size() >= count; });
+    }
+    std::string at(size_t index) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return index < lines.size() ? lines[index] : "";
+    }
+};
+
+static bool contains(const std::string& text, const std::string& part) {
+    return text.find(part) != std::string::npos;
+}
+
+static void testAnalysisServer() {
+    SECTION("Analysis Server");
+
+    TEST("Sessions: new, move, close and request errors") {
+        AnalysisServer::Config config;
+        config.workers = 1;
+        config.tableMB = 8;
+        AnalysisServer server(config);
+        ServerReplies replies;
+
+        server.handleRequest("{\"id\":1,\"cmd\":\"new\"}", replies.sink());
+        server.handleRequest("{\"id\":2,\"cmd\":\"move\",\"session\":1,\"x\":9,\"y\":9}", replies.sink());
+        server.handleRequest("{\"id\":3,\"cmd\":\"move\",\"session\":1,\"x\":9,\"y\":9}", replies.sink());
+        server.handleRequest("{\"id\":\"a\",\"cmd\":\"close\",\"session\":1}", replies.sink());
+        server.handleRequest("{\"cmd\":\"move\",\"session\":1,\"x\":0,\"y\":0}", replies.sink());
+        server.handleRequest("{\"cmd\":\"fly\"}", replies.sink());
+        server.handleRequest("{\"cmd\":[1]}", replies.sink());
+        server.handleRequest("{\"cmd\":\"new\",\"position\":\"bogus\"}", replies.sink());
+        server.handleRequest("{\"id\":abc,\"cmd\":\"stats\"}", replies.sink());
+        server.handleRequest("{\"id\":4,\"cmd\":\"stats\"} {\"id\":5}", replies.sink());
+        server.handleRequest("{\"id\":-2.5e1,\"cmd\":\"stats\"}  ", replies.sink());
+
+        ASSERT_EQ(replies.lines.size(), (size_t)11);
+        ASSERT_EQ(replies.at(0), std::string("{\"id\":1,\"ok\":true,\"session\":1}"));
+        ASSERT(contains(replies.at(1), "\"ok\":true") && contains(replies.at(1), "\"turn\":1"));
+        ASSERT(contains(replies.at(2), "\"ok\":false"));
+        ASSERT_EQ(replies.at(3), std::string("{\"id\":\"a\",\"ok\":true}"));
+        ASSERT(contains(replies.at(4), "unknown session"));
+        ASSERT(contains(replies.at(5), "unknown cmd"));
+        ASSERT(contains(replies.at(6), "malformed request"));
+        ASSERT(contains(replies.at(7), "invalid position"));
+        // A bare word is not echoed as the id; trailing text is malformed
+        ASSERT_EQ(replies.at(8), std::string("{\"ok\":false,\"error\":\"id must be a string or a number\"}"));
+        ASSERT(contains(replies.at(9), "malformed request") && !contains(replies.at(9), "\"id\""));
+        ASSERT(contains(replies.at(10), "{\"id\":-2.5e1,\"ok\":true"));
+        ASSERT(contains(server.statsJson(), "\"sessions\":0"));
+    } END_TEST;
+
+    TEST("Think: admission control, play and stats") {
+        AnalysisServer::Config config;
+        config.workers = 1;
+        config.tableMB = 8;
+        config.queueLimit = 1;
+        AnalysisServer server(config);
+        ServerReplies replies;
+
+        for (int i = 0; i < 3; i++)
+            server.handleRequest("{\"cmd\":\"new\"}", replies.sink());
+        server.handleRequest("{\"cmd\":\"move\",\"session\":1,\"x\":9,\"y\":9}", replies.sink());
+        server.handleRequest("{\"cmd\":\"move\",\"session\":1,\"x\":10,\"y\":10}", replies.sink());
+        server.handleRequest("{\"cmd\":\"move\",\"session\":1,\"x\":9,\"y\":10}", replies.sink());
+        ASSERT(replies.waitFor(6));
+
+        // Session 1 occupies the only worker until its budget runs out
+        server.handleRequest("{\"id\":10,\"cmd\":\"think\",\"session\":1,\"depth\":20,\"budget_ms\":400}",
+                             replies.sink());
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!contains(server.statsJson(), "\"active\":1") && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        server.handleRequest("{\"id\":11,\"cmd\":\"think\",\"session\":1}", replies.sink());
+        server.handleRequest("{\"id\":12,\"cmd\":\"think\",\"session\":2,\"depth\":2,\"play\":true}",
+                             replies.sink());
+        server.handleRequest("{\"id\":13,\"cmd\":\"think\",\"session\":3}", replies.sink());
+        ASSERT(contains(replies.at(6), "\"id\":11") && contains(replies.at(6), "session busy"));
+        ASSERT(contains(replies.at(7), "\"id\":13") && contains(replies.at(7), "queue full"));
+
+        ASSERT(replies.waitFor(10));
+        ASSERT(contains(replies.at(8), "\"id\":10,\"ok\":true"));
+        // Empty board: the search has nothing to offer, the centre is played
+        ASSERT_EQ(replies.at(9).compare(0, 31, "{\"id\":12,\"ok\":true,\"x\":9,\"y\":9,"), 0);
+        server.handleRequest("{\"cmd\":\"move\",\"session\":2,\"x\":9,\"y\":9}", replies.sink());
+        ASSERT(contains(replies.at(10), "\"ok\":false"));
+
+        std::string stats = server.statsJson();
+        ASSERT(contains(stats, "\"active\":0,\"queued\":0"));
+        ASSERT(contains(stats, "\"completed\":2,\"rejected\":2"));
+        ASSERT(contains(stats, "\"tt_mb_per_worker\":8"));
+    } END_TEST;
+
+    TEST("Unix socket round trip and clean stop") {
+        AnalysisServer::Config config;
+        config.workers = 1;
+        config.tableMB = 8;
+        AnalysisServer server(config);
+        std::string path = "/tmp/gomoku_test_" + std::to_string(::getpid()) + ".sock";
+        bool served = false;
+        std::thread serving([&] { served = server.serve(path); });
+
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+        bool connected = false;
+        for (int attempt = 0; attempt < 200 && !connected; attempt++) {
+            connected = ::connect(fd, (sockaddr*)&address, sizeof(address)) == 0;
+            if (!connected)
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        std::string request = "{\"id\":1,\"cmd\":\"new\"}\n"
+                              "{\"id\":2,\"cmd\":\"think\",\"session\":1,\"depth\":2}\n";
+        std::string received;
+        if (connected && ::write(fd, request.data(), request.size()) == (ssize_t)request.size()) {
+            char buffer[512];
+            while (std::count(received.begin(), received.end(), '\n') < 2) {
+                ssize_t count = ::read(fd, buffer, sizeof(buffer));
+                if (count <= 0)
+                    break;
+                received.append(buffer, count);
+            }
+        }
+        ::close(fd);
+        server.stop();
+        serving.join();
+
+        ASSERT(connected);
+        ASSERT_EQ(received.compare(0, 32, "{\"id\":1,\"ok\":true,\"session\":1}\n{"), 0);
+        ASSERT(contains(received, "\"id\":2,\"ok\":true,\"x\":9,\"y\":9"));
+        ASSERT(served);
+        ASSERT(::access(path.c_str(), F_OK) != 0);
+    } END_TEST;
+}
+
+// ============================================
+// 23. Game Record Tests
+// ============================================
+static void testGameRecord() {
+    SECTION("Game Record");
+    const std::string path = "test_game_record.gmr";
+
+    TEST("Writer / reader round trip, append and truncated game") {
+        std::remove(path.c_str());
+        GameRecord first;
+        first.moves = {RecordedMove(Move(9, 9)), RecordedMove(Move(0, 18), RecordedMove::FORCED_CAPTURE),
+                       RecordedMove(Move(18, 0), RecordedMove::CAPTURED)};
+        first.result = GameRecord::PLAYER2_WINS;
+        {
+            GameRecordWriter writer;
+            ASSERT(writer.open(path));
+            writer.writeGame(first);
+        }
+        {
+            // Appends after the existing header; the open game is closed as unfinished
+            GameRecordWriter writer;
+            ASSERT(writer.open(path));
+            writer.recordMove(RecordedMove(Move(3, 4)));
+        }
+        ASSERT_EQ((long)std::ifstream(path, std::ios::binary | std::ios::ate).tellg(), 8L + 10 + 6);
+
+        GameRecordReader reader;
+        GameRecord game;
+        ASSERT(reader.open(path));
+        ASSERT(reader.next(game));
+        ASSERT_EQ(game.result, (int)GameRecord::PLAYER2_WINS);
+        ASSERT_EQ(game.moves.size(), (size_t)3);
+        ASSERT(game.moves[1].move == Move(0, 18));
+        ASSERT_EQ(game.moves[1].flags, RecordedMove::FORCED_CAPTURE);
+        ASSERT_EQ(game.moves[2].flags, RecordedMove::CAPTURED);
+        ASSERT(reader.next(game));
+        ASSERT_EQ(game.result, (int)GameRecord::UNFINISHED);
+        ASSERT(!reader.next(game));
+        ASSERT(!reader.hasError());
+
+        // Cut inside the first game: its moves so far, unfinished
+        std::string bytes;
+        {
+            std::ifstream in(path, std::ios::binary);
+            bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        }
+        std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), 8 + 2 + 4 + 1);
+        ASSERT(reader.open(path));
+        ASSERT(reader.next(game));
+        ASSERT_EQ(game.moves.size(), (size_t)2);
+        ASSERT_EQ(game.result, (int)GameRecord::UNFINISHED);
+        ASSERT(!reader.next(game));
+        std::remove(path.c_str());
+    } END_TEST;
+
+    TEST("GameEngine records its games; replay reproduces them") {
+        std::remove(path.c_str());
+        GameState finalState;
+        {
+            GameEngine engine;
+            engine.setGameMode(GameMode::VS_HUMAN_SUGGESTED);
+            ASSERT(engine.setGameRecordFile(path));
+            engine.newGame();
+            // X captures the O pair at (9,10) and (9,11), then the game is abandoned
+            for (Move m : {Move(9, 9), Move(9, 10), Move(0, 0), Move(9, 11), Move(9, 12)})
+                ASSERT(engine.makeHumanMove(m));
+            ASSERT_EQ(engine.getGameRecord().moves.back().flags, RecordedMove::CAPTURED);
+            engine.newGame();
+            // X wins with five on row 5
+            for (int i = 0; i < 5; i++) {
+                ASSERT(engine.makeHumanMove(Move(5, i)));
+                if (i < 4)
+                    ASSERT(engine.makeHumanMove(Move(15, 2 * i)));
+            }
+            ASSERT(engine.isGameOver());
+            ASSERT_EQ(engine.getGameRecord().result, (int)GameRecord::PLAYER1_WINS);
+            finalState = engine.getState();
+        }
+
+        GameRecordReader reader;
+        GameRecord game;
+        GameState replayed;
+        ASSERT(reader.open(path));
+        ASSERT(reader.next(game));
+        ASSERT_EQ(game.moves.size(), (size_t)5);
+        ASSERT_EQ(game.result, (int)GameRecord::UNFINISHED);
+        ASSERT(GameRecordReader::replay(game, replayed));
+        ASSERT_EQ(replayed.captures[0], 1);
+        ASSERT(reader.next(game));
+        ASSERT_EQ(game.moves.size(), (size_t)9);
+        ASSERT_EQ(game.result, (int)GameRecord::PLAYER1_WINS);
+        ASSERT(GameRecordReader::replay(game, replayed));
+        ASSERT_EQ(replayed.getZobristHash(), finalState.getZobristHash());
+        ASSERT(!reader.next(game));
+        std::remove(path.c_str());
+    } END_TEST;
+
+    TEST("Corrupt records are rejected") {
+        // Replay checks legality and the CAPTURED flag
+        GameRecord game;
+        game.moves = {RecordedMove(Move(9, 9)), RecordedMove(Move(9, 9))};
+        GameState state;
+        ASSERT(!GameRecordReader::replay(game, state));
+        game.moves = {RecordedMove(Move(9, 9), RecordedMove::CAPTURED)};
+        ASSERT(!GameRecordReader::replay(game, state));
+
+        // Not a record file: refused for reading and for appending
+        std::ofstream(path, std::ios::trunc) << "not a game record";
+        GameRecordReader reader;
+        GameRecordWriter writer;
+        bool opened = true;
+        std::string errors = capturedErrors([&] { opened = reader.open(path) || writer.open(path); });
+        ASSERT(!opened);
+        ASSERT(errors.find("Error: " + path + " is not a game record file") != std::string::npos);
+        ASSERT(errors.find("Warning: " + path + " is not a game record file") != std::string::npos);
+
+        // Out-of-range cell inside a game
+        const unsigned char bytes[] = {'G', 'M', 'K', 'R', 1, 19, 0, 0, 0xFF, 0xFF, 0x69, 0x01};
+        std::ofstream(path, std::ios::binary | std::ios::trunc).write((const char*)bytes, sizeof(bytes));
+        ASSERT(reader.open(path));
+        ASSERT(!reader.next(game));
+        ASSERT(reader.hasError());
+        std::remove(path.c_str());
+    } END_TEST;
+
+    TEST("Piskvork psq games are read through the rules") {
+        // x = column, 1-based; X plays column 10 rows 8-12, O plays column 2
+        std::istringstream psq("Piskvorky 19x19, 11:11, 0\n"
+                               "10,8,120\n2,1,80\n10,9,95\n2,2,60\n10,10,110\n"
+                               "2,3,70\n10,11,90\n2,4,85\n10,12,100\n-1\npbrain-a.exe\n");
+        GameRecord game;
+        ASSERT(GameRecordReader::readPsq(psq, game));
+        ASSERT_EQ(game.moves.size(), (size_t)9);
+        ASSERT(game.moves[0].move == Move(7, 9));
+        ASSERT_EQ(game.result, (int)GameRecord::PLAYER1_WINS);
+
+        std::istringstream wrongSize("Piskvorky 15x15, 11:11, 0\n8,8,100\n");
+        ASSERT(!GameRecordReader::readPsq(wrongSize, game));
+        std::istringstream occupied("Piskvorky 19x19, 11:11, 0\n10,10,100\n10,10,100\n");
+        ASSERT(!GameRecordReader::readPsq(occupied, game));
+    } END_TEST;
+
+    TEST("Game analysis scores a move that ignores an open three as a loss") {
+        // X builds _XXX_ on row 9; O's 6th move goes to the corner instead of blocking
+        GameRecord game;
+        for (const Move& move : {Move(9, 7), Move(3, 3), Move(9, 8), Move(3, 15), Move(9, 9),
+                                 Move(17, 17), Move(9, 10), Move(0, 0)})
+            game.moves.push_back(RecordedMove(move));
+        TranspositionSearch search(8);
+        GameAnalyzer::Result result = GameAnalyzer::analyze(search, game, 3);
+        ASSERT(result.complete);
+        ASSERT_EQ(result.moves.size(), (size_t)8);
+
+        const GameAnalyzer::MoveAnalysis& ignored = result.moves[5];
+        ASSERT_EQ(ignored.player, GameState::PLAYER2);
+        ASSERT(!(ignored.best == ignored.played));
+        ASSERT(ignored.loss >= Evaluator::FOUR_HALF);
+
+        // Illegal move: the moves before it are analysed
+        game.moves.push_back(RecordedMove(Move(9, 9)));
+        result = GameAnalyzer::analyze(search, game, 2);
+        ASSERT(!result.complete);
+        ASSERT_EQ(result.moves.size(), (size_t)8);
+    } END_TEST;
+}
+
 // ============================================
 // MAIN
 // ============================================
+// ============================================
+// 24. Training Data Tests
+// ============================================
+static void testTrainingData() {
+    SECTION("Training Data");
+    const std::string prefix = "test_training_data";
+    auto removeShards = [&prefix]() {
+        for (const char* suffix : {"-0000.gpos", "-0001.gpos", "-0002.gpos", "-0003.gpos"})
+            std::remove((prefix + suffix).c_str());
+    };
+
+    TEST("Packed positions round trip") {
+        GameState state;
+        ASSERT(RuleEngine::applyMove(state, Move(0, 0)).success);
+        ASSERT(RuleEngine::applyMove(state, Move(18, 18)).success);
+        ASSERT(RuleEngine::applyMove(state, Move(9, 10)).success);
+        state.captures[0] = 3;
+        state.captures[1] = 9;
+        state.turnCount += 24;
+        state.recalculateHash();
+
+        PackedPosition packed = PackedPosition::pack(state, -123456, GameRecord::PLAYER1_WINS);
+        ASSERT_EQ(packed.score(), -123456);
+        ASSERT_EQ(packed.result(), (int)GameRecord::PLAYER1_WINS);
+        ASSERT_EQ(packed.sideToMove(), GameState::PLAYER2);
+
+        GameState unpacked;
+        ASSERT(packed.unpack(unpacked));
+        ASSERT_EQ(unpacked.board[0][0], GameState::PLAYER1);
+        ASSERT_EQ(unpacked.board[18][18], GameState::PLAYER2);
+        ASSERT_EQ(unpacked.board[9][10], GameState::PLAYER1);
+        ASSERT_EQ(unpacked.turnCount, state.turnCount);
+        ASSERT_EQ(unpacked.getZobristHash(), state.getZobristHash());
+
+        packed.bytes[0] |= 3; // Cell code 3 does not exist
+        ASSERT(!packed.unpack(unpacked));
+    } END_TEST;
+
+    TEST("Sharded writer, reader and truncated shard") {
+        removeShards();
+        GameState state;
+        {
+            TrainingDataWriter writer;
+            ASSERT(writer.open(prefix, 2));
+            for (int i = 0; i < 5; i++)
+                ASSERT(writer.write(PackedPosition::pack(state, i, GameRecord::DRAW)));
+            ASSERT_EQ(writer.positionsWritten(), (size_t)5);
+            ASSERT_EQ(writer.shardFiles().size(), (size_t)3);
+        }
+        {
+            // A second run continues the numbering
+            TrainingDataWriter writer;
+            ASSERT(writer.open(prefix, 2));
+            ASSERT_EQ(writer.shardFiles()[0], prefix + "-0003.gpos");
+        }
+
+        TrainingDataReader reader;
+        PackedPosition packed;
+        int scores = 0, count = 0;
+        for (const char* suffix : {"-0000.gpos", "-0001.gpos", "-0002.gpos", "-0003.gpos"}) {
+            ASSERT(reader.open(prefix + suffix));
+            while (reader.next(packed)) {
+                scores += packed.score();
+                count++;
+            }
+            ASSERT(!reader.hasError());
+        }
+        ASSERT_EQ(count, 5);
+        ASSERT_EQ(scores, 0 + 1 + 2 + 3 + 4);
+
+        std::ofstream(prefix + "-0002.gpos", std::ios::binary | std::ios::app).write("xyz", 3);
+        ASSERT(reader.open(prefix + "-0002.gpos"));
+        ASSERT(reader.next(packed));
+        ASSERT(!reader.next(packed));
+        ASSERT(reader.hasError());
+        removeShards();
+    } END_TEST;
+}
+
+// ============================================
+// 25. Evaluator Features Tests
+// ============================================
+static void testEvaluatorFeatures() {
+    SECTION("Evaluator Features");
+
+    TEST("Feature dot product matches evaluate() along random games") {
+        // Random neighbouring moves: captures, broken lines, dead shapes
+        std::mt19937 random(12345);
+        int positions = 0, mismatches = 0, runtimeMismatches = 0;
+        for (int game = 0; game < 12; game++) {
+            GameState state;
+            for (int ply = 0; ply < 70; ply++) {
+                Move move(9 + (int)(random() % 9) - 4, 9 + (int)(random() % 9) - 4);
+                if (!RuleEngine::isLegalMove(state, move) || !RuleEngine::applyMove(state, move).success)
+                    continue;
+                if (Evaluator::evaluate(state, EvalFeatures::DEFAULT_WEIGHTS) != Evaluator::evaluate(state))
+                    runtimeMismatches++;
+                if (RuleEngine::hasFiveInARow(state, GameState::PLAYER1) ||
+                    RuleEngine::hasFiveInARow(state, GameState::PLAYER2))
+                    break;
+                EvalFeatures features;
+                Evaluator::extractFeatures(state, features);
+                mismatches += features.score(EvalFeatures::DEFAULT_WEIGHTS) != Evaluator::evaluate(state);
+                positions++;
+            }
+        }
+        ASSERT(positions > 500);
+        ASSERT_EQ(mismatches, 0);
+        ASSERT_EQ(runtimeMismatches, 0);
+    } END_TEST;
+
+    TEST("Runtime weights move only their own term") {
+        GameState state = freshState();
+        placeLine(state, 9, 8, 0, 1, 3, GameState::PLAYER1);
+        placeStone(state, 3, 3, GameState::PLAYER2);
+        placeStone(state, 15, 15, GameState::PLAYER2);
+        EvalFeatures features;
+        Evaluator::extractFeatures(state, features);
+        ASSERT(features.counts[EvalFeatures::THREE_OPEN] < 0); // PLAYER1's open three
+
+        int weights[EvalFeatures::TERM_COUNT];
+        std::copy(EvalFeatures::DEFAULT_WEIGHTS, EvalFeatures::DEFAULT_WEIGHTS + EvalFeatures::TERM_COUNT, weights);
+        weights[EvalFeatures::THREE_OPEN] += 1000;
+        ASSERT_EQ(Evaluator::evaluate(state, weights) - Evaluator::evaluate(state),
+                  1000 * features.counts[EvalFeatures::THREE_OPEN]);
+        ASSERT_EQ(std::string(EvalFeatures::NAMES[EvalFeatures::THREE_OPEN]), std::string("THREE_OPEN"));
+        ASSERT_EQ(EvalFeatures::DEFAULT_WEIGHTS[EvalFeatures::THREE_OPEN], Evaluator::THREE_OPEN);
+    } END_TEST;
+}
+
+// ============================================
+// 26. NNUE Evaluator Tests
+// ============================================
+static void testNnueEvaluator() {
+    SECTION("NNUE Evaluator");
+    const std::string path = "test_network.gmkn";
+    NnueNetwork network;
+    network.randomize(7);
+
+    // Random games near the centre, with captures
+    auto playRandomGames = [](int games, const std::function<void(const GameState&, bool)>& visit) {
+        std::mt19937 random(2024);
+        for (int game = 0; game < games; game++) {
+            GameState state;
+            for (int ply = 0; ply < 80; ply++) {
+                Move move(9 + (int)(random() % 9) - 4, 9 + (int)(random() % 9) - 4);
+                if (!RuleEngine::isLegalMove(state, move))
+                    continue;
+                RuleEngine::MoveResult result = RuleEngine::applyMove(state, move);
+                if (!result.success)
+                    continue;
+                visit(state, !result.myCapturedPieces.empty());
+            }
+        }
+    };
+
+    TEST("Incremental accumulator matches a full refresh along random games") {
+        ASSERT(network.save(path));
+        ASSERT(Evaluator::loadNetwork(path));
+        int positions = 0, captures = 0, mismatches = 0;
+        playRandomGames(8, [&](const GameState& state, bool captured) {
+            NnueAccumulator fresh;
+            network.refresh(state, fresh);
+            if (std::memcmp(state.nnue.values, fresh.values, sizeof(fresh.values)) != 0 ||
+                state.nnue.key != state.zobristHash)
+                mismatches++;
+            positions++;
+            captures += captured;
+        });
+        Evaluator::unloadNetwork();
+        ASSERT(positions > 300);
+        ASSERT(captures > 0);
+        ASSERT_EQ(mismatches, 0);
+    } END_TEST;
+
+    TEST("SIMD kernels give the scalar scores") {
+        std::vector<NnueNetwork::Kernel> kernels;
+        for (NnueNetwork::Kernel kernel : {NnueNetwork::SSSE3, NnueNetwork::AVX2})
+            if (NnueNetwork::kernelSupported(kernel))
+                kernels.push_back(kernel);
+        int positions = 0, mismatches = 0, distinct = 0, previous = 0;
+        playRandomGames(4, [&](const GameState& state, bool) {
+            ASSERT(network.setKernel(NnueNetwork::SCALAR));
+            int expected = network.evaluate(state);
+            for (NnueNetwork::Kernel kernel : kernels) {
+                ASSERT(network.setKernel(kernel));
+                mismatches += network.evaluate(state) != expected;
+            }
+            distinct += expected != previous;
+            previous = expected;
+            positions++;
+        });
+        ASSERT(positions > 100);
+        ASSERT(distinct > positions / 2); // Not a constant network
+        ASSERT_EQ(mismatches, 0);
+    } END_TEST;
+
+    TEST("Evaluator switches between handcrafted and network scores") {
+        GameState state = freshState();
+        placeLine(state, 9, 8, 0, 1, 3, GameState::PLAYER1);
+        placeStone(state, 8, 8, GameState::PLAYER2);
+        state.recalculateHash();
+        int handcrafted = Evaluator::evaluate(state);
+
+        ASSERT(Evaluator::loadNetwork(path));
+        ASSERT(Evaluator::usingNetwork());
+        int score = network.evaluate(state);
+        ASSERT_EQ(Evaluator::evaluate(state), state.currentPlayer == GameState::PLAYER2 ? score : -score);
+
+        GameState five = freshState();
+        placeLine(five, 9, 5, 0, 1, 5, GameState::PLAYER1);
+        five.recalculateHash();
+        ASSERT_EQ(Evaluator::evaluate(five), -Evaluator::WIN); // Wins still decided by the rules
+
+        // A broken file keeps the current mode; unloading restores the handcrafted score
+        { std::ofstream(path, std::ios::binary | std::ios::trunc) << "GMKN"; }
+        bool loaded = true;
+        std::string errors = capturedErrors([&] { loaded = Evaluator::loadNetwork(path); });
+        ASSERT(!loaded);
+        ASSERT(errors.find(path + " is not a") != std::string::npos);
+        ASSERT(Evaluator::usingNetwork());
+        Evaluator::unloadNetwork();
+        ASSERT(!Evaluator::usingNetwork());
+        ASSERT_EQ(Evaluator::evaluate(state), handcrafted);
+    } END_TEST;
+
+    std::remove(path.c_str());
+}
+
+// ============================================
+// 27. Pattern Scanner Tests
+// ============================================
+static bool sameCounts(const Evaluator::PatternCounts& a, const Evaluator::PatternCounts& b) {
+    return a.fourOpen == b.fourOpen && a.fourHalf == b.fourHalf && a.threeOpen == b.threeOpen &&
+           a.threeHalf == b.threeHalf && a.twoOpen == b.twoOpen;
+}
+
+static void testPatternScanner() {
+    SECTION("Pattern Scanner");
+    PatternScanner::Kernel defaultKernel = PatternScanner::getKernel();
+
+    TEST("Line scanner matches the per-stone scan on every kernel") {
+        std::vector<PatternScanner::Kernel> kernels;
+        for (PatternScanner::Kernel kernel : {PatternScanner::SCALAR, PatternScanner::SSE2, PatternScanner::AVX2})
+            if (PatternScanner::kernelSupported(kernel))
+                kernels.push_back(kernel);
+        int positions = 0, mismatches = 0, shapes = 0;
+        auto compare = [&](const GameState& state) {
+            Evaluator::PatternCounts expected1 = Evaluator::countAllPatternsScan(state, GameState::PLAYER1);
+            Evaluator::PatternCounts expected2 = Evaluator::countAllPatternsScan(state, GameState::PLAYER2);
+            shapes += expected1.fourHalf + expected1.threeOpen + expected2.fourHalf + expected2.threeOpen;
+            for (PatternScanner::Kernel kernel : kernels) {
+                ASSERT(PatternScanner::setKernel(kernel));
+                Evaluator::PatternCounts player1, player2;
+                Evaluator::countAllPatterns(state, player1, player2);
+                mismatches += !sameCounts(player1, expected1) || !sameCounts(player2, expected2);
+            }
+            positions++;
+        };
+
+        // Whole board: shapes against the edges and on short diagonals
+        std::mt19937 random(4242);
+        for (int game = 0; game < 10; game++) {
+            GameState state;
+            for (int ply = 0; ply < 120; ply++) {
+                int radius = game < 5 ? 4 : 9;
+                Move move(9 + (int)(random() % (2 * radius + 1)) - radius,
+                          9 + (int)(random() % (2 * radius + 1)) - radius);
+                if (!RuleEngine::isLegalMove(state, move) || !RuleEngine::applyMove(state, move).success)
+                    continue;
+                compare(state);
+            }
+        }
+        // Random fills, for the windows legal games rarely make (XXXX-X, fives, sixes)
+        for (int board = 0; board < 200; board++) {
+            GameState state;
+            int density = 20 + board % 50;
+            for (int x = 0; x < GameState::BOARD_SIZE; x++)
+                for (int y = 0; y < GameState::BOARD_SIZE; y++)
+                    if ((int)(random() % 100) < density)
+                        state.board[x][y] = random() % 3 ? GameState::PLAYER1 : GameState::PLAYER2;
+            compare(state);
+        }
+        PatternScanner::setKernel(defaultKernel);
+        ASSERT(positions > 1000);
+        ASSERT(shapes > 100);
+        ASSERT_EQ(mismatches, 0);
+    } END_TEST;
+
+    TEST("Edge and anti-diagonal shapes") {
+        GameState s = freshState();
+        placeLine(s, 4, 0, -1, 1, 4, GameState::PLAYER1);   // Four on the 5-cell anti-diagonal: one free end
+        placeLine(s, 18, 3, 0, 1, 3, GameState::PLAYER2);   // Open three on the bottom edge row
+        placeStone(s, 10, 14, GameState::PLAYER1);          // Split three X-XX on a column, open
+        placeStone(s, 12, 14, GameState::PLAYER1);
+        placeStone(s, 13, 14, GameState::PLAYER1);
+        placeLine(s, 0, 16, 1, 1, 3, GameState::PLAYER2);   // ↘ diagonal of length 3: dead shape
+
+        Evaluator::PatternCounts player1 = Evaluator::countAllPatterns(s, GameState::PLAYER1);
+        Evaluator::PatternCounts player2 = Evaluator::countAllPatterns(s, GameState::PLAYER2);
+        ASSERT(sameCounts(player1, Evaluator::countAllPatternsScan(s, GameState::PLAYER1)));
+        ASSERT(sameCounts(player2, Evaluator::countAllPatternsScan(s, GameState::PLAYER2)));
+        ASSERT_EQ(player1.fourHalf, 1);
+        ASSERT_EQ(player1.threeOpen, 1);
+        ASSERT_EQ(player2.threeOpen, 1);
+        ASSERT_EQ(player2.fourOpen + player2.fourHalf + player2.threeHalf, 0);
+    } END_TEST;
+}
+
+// ============================================
+// 28. Board Line Views Tests
+// ============================================
+// Every cell's bit in its four lines agrees with the cell itself
+static bool linesMatchCells(const GameState& s) {
+    for (int x = 0; x < GameState::BOARD_SIZE; x++) {
+        for (int y = 0; y < GameState::BOARD_SIZE; y++) {
+            for (int d = 0; d < 4; d++) {
+                const BoardLines::Point& point = Board::point(x, y, d);
+                int cx = -1, cy = -1;
+                Board::cellAt(point.line, point.bit, cx, cy);
+                bool stone1 = (s.board.stones(point.line, GameState::PLAYER1) >> point.bit) & 1;
+                bool stone2 = (s.board.stones(point.line, GameState::PLAYER2) >> point.bit) & 1;
+                bool empty = (s.board.empty(point.line) >> point.bit) & 1;
+                if (cx != x || cy != y || stone1 != (s.board[x][y] == GameState::PLAYER1) ||
+                    stone2 != (s.board[x][y] == GameState::PLAYER2) || empty != (s.board[x][y] == GameState::EMPTY))
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void testBoardLineViews() {
+    SECTION("Board Line Views");
+
+    TEST("Line bitsets follow moves, captures, direct writes and copies") {
+        std::mt19937 random(4949);
+        int captures = 0, checked = 0;
+        for (int game = 0; game < 6; game++) {
+            GameState state;
+            for (int ply = 0; ply < 150; ply++) {
+                Move move(9 + (int)(random() % 11) - 5, 9 + (int)(random() % 11) - 5);
+                if (ply % 10 == 9) {
+                    state.board[move.x][move.y] = (int)(random() % 3);   // Writes that skip the rules
+                } else if (RuleEngine::isLegalMove(state, move)) {
+                    captures += (int)RuleEngine::applyMove(state, move).myCapturedPieces.size();
+                }
+                if (ply % 25 == 0) {
+                    GameState copy = state;
+                    ASSERT(linesMatchCells(copy));
+                    state = copy;
+                }
+                ASSERT(linesMatchCells(state));
+                checked++;
+            }
+        }
+        ASSERT(captures > 0);
+        ASSERT_EQ(checked, 900);
+    } END_TEST;
+
+    TEST("Line scans stop at the board edge") {
+        // Pair at the end of row 0 with an own stone at the start of row 1:
+        // neighbours in memory, not on the board
+        GameState s = freshState();
+        placeLine(s, 0, 17, 0, 1, 2, GameState::PLAYER2);
+        s.board[1][0] = GameState::PLAYER1;
+        ASSERT(RuleEngine::findCaptures(s, Move(0, 16), GameState::PLAYER1).empty());
+
+        // Capture read against the line's direction
+        s.board[9][11] = GameState::PLAYER2;
+        s.board[9][10] = GameState::PLAYER2;
+        s.board[9][9] = GameState::PLAYER1;
+        ASSERT_EQ((int)RuleEngine::findCaptures(s, Move(9, 12), GameState::PLAYER1).size(), 2);
+
+        // Five on the 5-cell ↗ diagonal in the corner
+        GameState five = freshState();
+        placeLine(five, 4, 0, -1, 1, 5, GameState::PLAYER1);
+        ASSERT(RuleEngine::hasFiveInARow(five, GameState::PLAYER1));
+        ASSERT(RuleEngine::checkWin(five, GameState::PLAYER1));
+
+        // XXX against the left edge is not free; one cell further in, it is
+        GameState edge = freshState();
+        placeLine(edge, 9, 0, 0, 1, 2, GameState::PLAYER1);
+        placeLine(edge, 7, 2, 1, 0, 2, GameState::PLAYER1);
+        ASSERT(!RuleEngine::createsDoubleFreeThree(edge, Move(9, 2), GameState::PLAYER1));
+        GameState inner = freshState();
+        placeLine(inner, 9, 1, 0, 1, 2, GameState::PLAYER1);
+        placeLine(inner, 7, 3, 1, 0, 2, GameState::PLAYER1);
+        ASSERT(RuleEngine::createsDoubleFreeThree(inner, Move(9, 3), GameState::PLAYER1));
+    } END_TEST;
+}
+
+// ============================================
+// 29. Threat Map Tests
+// ============================================
+// Every cell's map entry for both players matches a fresh classification
+static bool threatsMatchBoard(const GameState& s) {
+    for (int x = 0; x < GameState::BOARD_SIZE; x++) {
+        for (int y = 0; y < GameState::BOARD_SIZE; y++) {
+            uint8_t player1, player2;
+            ThreatScanner::classify(s, x, y, player1, player2);
+            if (ThreatScanner::entry(s, GameState::PLAYER1, x, y) != player1 ||
+                ThreatScanner::entry(s, GameState::PLAYER2, x, y) != player2)
+                return false;
+        }
+    }
+    return true;
+}
+
+static void testThreatMap() {
+    SECTION("Threat Map");
+
+    TEST("Map follows moves, captures, direct writes and copies") {
+        std::mt19937 random(5050);
+        int captures = 0, checked = 0, updated = 0;
+        for (int game = 0; game < 6; game++) {
+            GameState state;
+            for (int ply = 0; ply < 120; ply++) {
+                Move move(9 + (int)(random() % 11) - 5, 9 + (int)(random() % 11) - 5);
+                if (ply % 10 == 9) {
+                    state.board[move.x][move.y] = (int)(random() % 3);   // Writes that skip the rules
+                } else if (RuleEngine::isLegalMove(state, move)) {
+                    bool queued = state.threats.valid;
+                    captures += (int)RuleEngine::applyMove(state, move).myCapturedPieces.size();
+                    updated += queued && state.threats.valid && state.threats.pendingCount > 0;
+                }
+                if (ply % 20 == 0) {
+                    GameState copy = state;
+                    ASSERT(threatsMatchBoard(copy));
+                    state = copy;
+                }
+                ASSERT(threatsMatchBoard(state));
+                checked++;
+            }
+        }
+        ASSERT(captures > 0);
+        ASSERT(updated > 300);   // Most moves updated the map instead of rebuilding it
+        ASSERT_EQ(checked, 720);
+    } END_TEST;
+
+    TEST("Shapes, captures and ordering bonuses from the map") {
+        GameState s = freshState();
+        placeLine(s, 3, 3, 0, 1, 4, GameState::PLAYER1);    // XXXX_: five at (3, 7)
+        placeLine(s, 8, 3, 0, 1, 3, GameState::PLAYER1);    // _XXX_: open four at (8, 6)
+        placeLine(s, 13, 4, 0, 1, 2, GameState::PLAYER1);   // OXX_: closed three at (13, 6)
+        placeStone(s, 13, 3, GameState::PLAYER2);
+        placeLine(s, 5, 12, 0, 1, 3, GameState::PLAYER1);   // XXX__: gapped four at (5, 16)
+        placeStone(s, 11, 4, GameState::PLAYER1);           // _X_X__: gapped open three at (11, 7)
+        placeStone(s, 11, 6, GameState::PLAYER1);
+        placeLine(s, 16, 10, 0, 1, 2, GameState::PLAYER2);  // X OO _ : capture at (16, 12)
+        placeStone(s, 16, 9, GameState::PLAYER1);
+
+        uint8_t five = ThreatScanner::entry(s, GameState::PLAYER1, 3, 7);
+        uint8_t openFour = ThreatScanner::entry(s, GameState::PLAYER1, 8, 6);
+        uint8_t three = ThreatScanner::entry(s, GameState::PLAYER1, 13, 6);
+        uint8_t capture = ThreatScanner::entry(s, GameState::PLAYER1, 16, 12);
+        ASSERT_EQ((int)ThreatMap::shape(five), (int)ThreatMap::FIVE);
+        ASSERT_EQ((int)ThreatMap::shape(openFour), (int)ThreatMap::OPEN_FOUR);
+        ASSERT_EQ((int)ThreatMap::shape(three), (int)ThreatMap::THREE);
+        ASSERT_EQ((int)ThreatMap::shape(ThreatScanner::entry(s, GameState::PLAYER1, 5, 16)), (int)ThreatMap::FOUR);
+        ASSERT_EQ((int)ThreatMap::shape(ThreatScanner::entry(s, GameState::PLAYER1, 11, 7)), (int)ThreatMap::OPEN_THREE);
+        ASSERT_EQ((int)ThreatMap::shape(ThreatScanner::entry(s, GameState::PLAYER2, 3, 7)), (int)ThreatMap::NONE);
+        ASSERT(ThreatMap::captures(capture));
+        ASSERT(!ThreatMap::captures(five));
+        ASSERT(!ThreatMap::captures(ThreatScanner::entry(s, GameState::PLAYER2, 16, 12)));
+
+        // Blocking the opponent's four is worth more than extending a two
+        s.currentPlayer = GameState::PLAYER2;
+        AI ai(4, CPP_IMPLEMENTATION);
+        ASSERT_GT(ai.quickEvaluateMove(s, Move(3, 7)), ai.quickEvaluateMove(s, Move(16, 12)) + 5000);
+    } END_TEST;
+
+    TEST("Candidates narrow to the fives and the replies to one") {
+        GameState s = freshState();
+        placeLine(s, 9, 5, 0, 1, 4, GameState::PLAYER1);    // OXXXX_: X threatens (9, 9)
+        placeStone(s, 9, 4, GameState::PLAYER2);
+        placeLine(s, 12, 6, 1, 1, 3, GameState::PLAYER2);   // Scattered O stones
+        placeStone(s, 6, 6, GameState::PLAYER2);
+        s.currentPlayer = GameState::PLAYER2;
+        s.turnCount = 12;
+        s.recalculateHash();
+
+        TranspositionSearch search(1);
+        std::vector<Move> moves = search.generateOrderedMoves(s);
+        ASSERT_EQ((int)moves.size(), 1);
+        ASSERT(moves[0] == Move(9, 9));
+
+        // A capture may break the four: it stays a reply
+        placeStone(s, 10, 6, GameState::PLAYER1);          // O XX _: (11, 6) takes (9, 6)
+        placeStone(s, 8, 6, GameState::PLAYER2);
+        s.recalculateHash();
+        moves = search.generateOrderedMoves(s);
+        ASSERT_EQ((int)moves.size(), 2);
+        ASSERT(moves[0] == Move(9, 9));
+        ASSERT(moves[1] == Move(11, 6));
+
+        // With a five of its own to make, O only considers it
+        placeLine(s, 2, 3, 0, 1, 4, GameState::PLAYER2);    // OOOO_ with an X before it
+        placeStone(s, 2, 2, GameState::PLAYER1);
+        s.recalculateHash();
+        moves = search.generateOrderedMoves(s);
+        ASSERT_EQ((int)moves.size(), 1);
+        ASSERT(moves[0] == Move(2, 7));
+    } END_TEST;
+}
+
 int main() {
     std::cout << "\033[1;33m"
               << "╔═══════════════════════════════════════════════╗\n"
@@ -1895,6 +3245,16 @@ int main() {
     testPatternCounting();
     testMoveOrdering();
     testGameSimulation();
+    testDebugLogWriter();
+    testPiskvorkProtocol();
+    testAnalysisServer();
+    testGameRecord();
+    testTrainingData();
+    testEvaluatorFeatures();
+    testNnueEvaluator();
+    testPatternScanner();
+    testBoardLineViews();
+    testThreatMap();
 
     auto totalEnd = std::chrono::steady_clock::now();
     auto totalMs = std::chrono::duration_cast<std::chrono::milliseconds>(totalEnd - totalStart).count();
@@ -0,0 +1,401 @@
+// ============================================
+// TUNE.CPP - Texel-style tuning of the Evaluator weights
+// ============================================
+// Fits the EvalWeights constants to labelled positions (datagen shards)
+// by minimising the logistic loss between sigmoid(K * eval) and the game
+// result, then writes a new evaluator_weights.hpp.
+//
+// - Each position is reduced once, on all cores, to its EvalFeatures
+//   counts; evaluate() is their dot product with the weights, so no board
+//   is scanned again while tuning
+// - The counts are stored by term as sparse columns (row, count), next to
+//   one cached eval and loss per position: changing one weight only
+//   touches the positions where its term occurs
+// - Coordinate descent: each weight in turn moves up or down by a
+//   fraction of its value while the loss improves; the fraction halves
+//   when a pass changes nothing. Loss deltas run in parallel chunks.
+// - K is fitted first (golden section) unless given; --lambda blends the
+//   result with sigmoid(K * search score) as the target
+// - With --passes 0 the header is written back unchanged
+//
+// Usage: ./tune SHARD... [--threads N] [--k K] [--lambda L] [--step F]
+//                        [--min-step F] [--passes N] [--max-positions N]
+//                        [--out FILE]
+// ============================================
+
+#include "../include/ai/evaluator.hpp"
+#include "../include/core/game_types.hpp"
+#include "../include/rules/rule_engine.hpp"
+#include "../include/utils/game_record.hpp"
+#include "../include/utils/training_data.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const size_t LOAD_BATCH = 65536;
+// Positions re-checked against Evaluator::evaluate while loading
+static const size_t VERIFY_POSITIONS = 1000;
+// Columns shorter than this are scanned on one thread
+static const size_t PARALLEL_MIN_ENTRIES = 32768;
+
+struct TuneOptions {
+    std::vector<std::string> files;
+    int threads = 1;
+    double k = 0.0; // 0 = fit
+    double lambda = 0.0;
+    double step = 0.10;
+    double minStep = 0.005;
+    int passes = 100;
+    size_t maxPositions = SIZE_MAX;
+    std::string outFile = "evaluator_weights.hpp";
+};
+
+// Labelled positions as sparse feature columns plus per-position caches
+struct Dataset {
+    std::vector<float> result;      // PLAYER2's game result: 1, 0.5, 0
+    std::vector<int> searchScore;   // PLAYER2's point of view
+    std::vector<std::vector<uint32_t>> rows; // Per term
+    std::vector<std::vector<int16_t>> counts;
+    std::vector<float> target;
+    std::vector<long long> eval;    // Dot product with the current weights
+    std::vector<double> loss;
+
+    size_t size() const { return result.size(); }
+};
+
+static double sigmoid(double x) {
+    return 1.0 / (1.0 + std::exp(-x));
+}
+
+static double logLoss(double target, double eval, double k) {
+    double p = std::min(std::max(sigmoid(k * eval), 1e-12), 1.0 - 1e-12);
+    return -(target * std::log(p) + (1.0 - target) * std::log(1.0 - p));
+}
+
+// Runs body(begin, end) over [0, count) on up to `threads` threads
+static void parallelFor(size_t count, int threads, const std::function<void(size_t, size_t, int)>& body) {
+    int used = (int)std::max<size_t>(1, std::min<size_t>(threads, count / 1024));
+    if (used == 1) {
+        body(0, count, 0);
+        return;
+    }
+    std::vector<std::thread> workers;
+    for (int t = 0; t < used; t++)
+        workers.emplace_back(body, count * t / used, count * (t + 1) / used, t);
+    for (std::thread& worker : workers)
+        worker.join();
+}
+
+// ============================================
+// Loading
+// ============================================
+
+static void addBatch(Dataset& data, const std::vector<PackedPosition>& batch, int threads,
+                     size_t& skipped, size_t& mismatches, size_t& verified) {
+    std::vector<EvalFeatures> features(batch.size());
+    std::vector<char> usable(batch.size(), 0);
+    std::vector<size_t> threadMismatches(threads, 0);
+    size_t verifyUpTo = verified < VERIFY_POSITIONS ? std::min(batch.size(), VERIFY_POSITIONS - verified) : 0;
+
+    parallelFor(batch.size(), threads, [&](size_t begin, size_t end, int thread) {
+        GameState state;
+        for (size_t i = begin; i < end; i++) {
+            // A five on the board is scored WIN, outside the linear model
+            if (!batch[i].unpack(state) || RuleEngine::hasFiveInARow(state, GameState::PLAYER1) ||
+                RuleEngine::hasFiveInARow(state, GameState::PLAYER2) ||
+                RuleEngine::checkWin(state, GameState::PLAYER1) || RuleEngine::checkWin(state, GameState::PLAYER2))
+                continue;
+            Evaluator::extractFeatures(state, features[i]);
+            usable[i] = 1;
+            if (i < verifyUpTo && features[i].score(EvalFeatures::DEFAULT_WEIGHTS) != Evaluator::evaluate(state))
+                threadMismatches[thread]++;
+        }
+    });
+    verified += verifyUpTo;
+    for (size_t count : threadMismatches)
+        mismatches += count;
+
+    for (size_t i = 0; i < batch.size(); i++) {
+        if (!usable[i]) {
+            skipped++;
+            continue;
+        }
+        uint32_t row = (uint32_t)data.size();
+        int result = batch[i].result();
+        data.result.push_back(result == GameRecord::PLAYER2_WINS ? 1.0f : result == GameRecord::PLAYER1_WINS ? 0.0f : 0.5f);
+        data.searchScore.push_back(batch[i].sideToMove() == GameState::PLAYER2 ? batch[i].score() : -batch[i].score());
+        for (int term = 0; term < EvalFeatures::TERM_COUNT; term++) {
+            if (features[i].counts[term] == 0) continue;
+            data.rows[term].push_back(row);
+            data.counts[term].push_back(features[i].counts[term]);
+        }
+    }
+}
+
+static bool loadDataset(const TuneOptions& options, Dataset& data) {
+    data.rows.assign(EvalFeatures::TERM_COUNT, {});
+    data.counts.assign(EvalFeatures::TERM_COUNT, {});
+    size_t skipped = 0, mismatches = 0, verified = 0;
+    std::vector<PackedPosition> batch;
+    batch.reserve(LOAD_BATCH);
+
+    for (const std::string& file : options.files) {
+        TrainingDataReader reader;
+        if (!reader.open(file))
+            return false;
+        PackedPosition packed;
+        while (data.size() + skipped + batch.size() < options.maxPositions && reader.next(packed)) {
+            batch.push_back(packed);
+            if (batch.size() == LOAD_BATCH) {
+                addBatch(data, batch, options.threads, skipped, mismatches, verified);
+                batch.clear();
+            }
+        }
+        if (reader.hasError())
+            std::cerr << "Warning: " << file << ": truncated record ignored" << std::endl;
+    }
+    addBatch(data, batch, options.threads, skipped, mismatches, verified);
+
+    std::cerr << "Loaded " << data.size() << " positions (" << skipped << " skipped)" << std::endl;
+    if (mismatches > 0)
+        std::cerr << "Warning: features disagree with Evaluator::evaluate on " << mismatches << " of " << verified
+                  << " positions (evaluator_features.cpp out of date?)" << std::endl;
+    return data.size() > 0;
+}
+
+// ============================================
+// Loss
+// ============================================
+
+static void computeEvals(Dataset& data, const int* weights) {
+    data.eval.assign(data.size(), 0);
+    for (int term = 0; term < EvalFeatures::TERM_COUNT; term++)
+        for (size_t i = 0; i < data.rows[term].size(); i++)
+            data.eval[data.rows[term][i]] += (long long)weights[term] * data.counts[term][i];
+}
+
+static double totalLoss(const Dataset& data, const std::vector<float>& target, double k, int threads,
+                        std::vector<double>* perPosition = nullptr) {
+    std::vector<double> sums(threads, 0.0);
+    parallelFor(data.size(), threads, [&](size_t begin, size_t end, int thread) {
+        double sum = 0.0;
+        for (size_t i = begin; i < end; i++) {
+            double loss = logLoss(target[i], (double)data.eval[i], k);
+            if (perPosition) (*perPosition)[i] = loss;
+            sum += loss;
+        }
+        sums[thread] = sum;
+    });
+    double sum = 0.0;
+    for (double s : sums) sum += s;
+    return sum;
+}
+
+// Golden-section search for K on a log scale, targets = results
+static double fitK(const Dataset& data, int threads) {
+    auto lossAt = [&](double logK) { return totalLoss(data, data.result, std::pow(10.0, logK), threads); };
+    const double ratio = (std::sqrt(5.0) - 1.0) / 2.0;
+    double low = -8.0, high = -2.0;
+    double a = high - ratio * (high - low), b = low + ratio * (high - low);
+    double lossA = lossAt(a), lossB = lossAt(b);
+    for (int i = 0; i < 40; i++) {
+        if (lossA < lossB) {
+            high = b; b = a; lossB = lossA;
+            a = high - ratio * (high - low); lossA = lossAt(a);
+        } else {
+            low = a; a = b; lossA = lossB;
+            b = low + ratio * (high - low); lossB = lossAt(b);
+        }
+    }
+    return std::pow(10.0, (low + high) / 2.0);
+}
+
+// Loss change if `term`'s weight moves by delta; touches only its column
+static double lossDelta(const Dataset& data, int term, int delta, double k, int threads) {
+    const std::vector<uint32_t>& rows = data.rows[term];
+    const std::vector<int16_t>& counts = data.counts[term];
+    std::vector<double> sums(threads, 0.0);
+    int used = rows.size() >= PARALLEL_MIN_ENTRIES ? threads : 1;
+    parallelFor(rows.size(), used, [&](size_t begin, size_t end, int thread) {
+        double sum = 0.0;
+        for (size_t i = begin; i < end; i++) {
+            uint32_t row = rows[i];
+            sum += logLoss(data.target[row], (double)(data.eval[row] + (long long)delta * counts[i]), k) - data.loss[row];
+        }
+        sums[thread] = sum;
+    });
+    double sum = 0.0;
+    for (double s : sums) sum += s;
+    return sum;
+}
+
+static void applyDelta(Dataset& data, int term, int delta, double k) {
+    const std::vector<uint32_t>& rows = data.rows[term];
+    for (size_t i = 0; i < rows.size(); i++) {
+        uint32_t row = rows[i];
+        data.eval[row] += (long long)delta * data.counts[term][i];
+        data.loss[row] = logLoss(data.target[row], (double)data.eval[row], k);
+    }
+}
+
+// ============================================
+// Output
+// ============================================
+
+// Same layout as include/ai/evaluator_weights.hpp
+static void writeWeightsHeader(std::ostream& out, const int* weights) {
+    struct Group { const char* comment; int first, last; };
+    static const Group groups[] = {
+        {"Line patterns, per line (a split five, X-XXXX, scores Evaluator::WIN)", EvalFeatures::FOUR_OPEN, EvalFeatures::TWO_OPEN},
+        {"Threats and forks, once per player", EvalFeatures::THREAT_FOUR_OPEN, EvalFeatures::FORK_CAPTURES_THREE},
+        {"Pairs already captured by the player", EvalFeatures::HELD_9, EvalFeatures::HELD_PAIR},
+        {"Pairs already captured by the opponent (subtracted)", EvalFeatures::LOST_9, EvalFeatures::LOST_PAIR},
+        {"Capture opportunities (added) and threats (subtracted), per capture", EvalFeatures::CAPTURE_WIN,
+         EvalFeatures::CAPTURE_UNDER_PRESSURE}};
+    auto note = [](int term) -> const char* {
+        if (term == EvalFeatures::HELD_PAIR) return " // Per pair, below 4";
+        if (term == EvalFeatures::CAPTURE_PAIRS) return " // Per pair held after the capture, below 6";
+        return "";
+    };
+
+    out << "#ifndef EVALUATOR_WEIGHTS_HPP\n#define EVALUATOR_WEIGHTS_HPP\n\n"
+        << "/**\n * Evaluator weights: every constant Evaluator::evaluate adds up\n *\n"
+        << " * tests/tune writes a file of this exact form with fitted values\n"
+        << " * (see README, Evaluator Tuning); names match EvalFeatures::NAMES.\n */\n"
+        << "namespace EvalWeights\n{\n";
+    bool first = true;
+    for (const Group& group : groups) {
+        if (!first) out << "\n";
+        first = false;
+        out << "\t// " << group.comment << "\n";
+        for (int term = group.first; term <= group.last; term++)
+            out << "\tconstexpr int " << EvalFeatures::NAMES[term] << " = " << weights[term] << ";" << note(term) << "\n";
+    }
+    out << "}\n\n#endif // EVALUATOR_WEIGHTS_HPP\n";
+}
+
+// ============================================
+// Main
+// ============================================
+
+int main(int argc, char** argv) {
+    TuneOptions options;
+    options.threads = (int)std::max(1u, std::thread::hardware_concurrency());
+
+    bool validArgs = true;
+    for (int i = 1; i < argc && validArgs; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--threads" && hasValue) options.threads = std::atoi(argv[++i]);
+        else if (arg == "--k" && hasValue) options.k = std::atof(argv[++i]);
+        else if (arg == "--lambda" && hasValue) options.lambda = std::atof(argv[++i]);
+        else if (arg == "--step" && hasValue) options.step = std::atof(argv[++i]);
+        else if (arg == "--min-step" && hasValue) options.minStep = std::atof(argv[++i]);
+        else if (arg == "--passes" && hasValue) options.passes = std::atoi(argv[++i]);
+        else if (arg == "--max-positions" && hasValue) options.maxPositions = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--out" && hasValue) options.outFile = argv[++i];
+        else if (!arg.empty() && arg[0] != '-') options.files.push_back(arg);
+        else validArgs = false;
+    }
+    if (!validArgs || options.files.empty() || options.threads < 1 || options.k < 0.0 || options.lambda < 0.0 ||
+        options.lambda > 1.0 || options.step <= 0.0 || options.step >= 1.0 || options.minStep <= 0.0 ||
+        options.passes < 0 || options.maxPositions < 1) {
+        std::cerr << "Usage: " << argv[0] << " SHARD... [--threads N] [--k K] [--lambda L] [--step F]\n"
+                  << "       [--min-step F] [--passes N] [--max-positions N] [--out FILE]\n"
+                  << "SHARD: datagen output (.gpos)" << std::endl;
+        return 2;
+    }
+
+    GameState::initializeHasher();
+    auto start = std::chrono::steady_clock::now();
+    auto elapsed = [&start]() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    Dataset data;
+    if (!loadDataset(options, data)) {
+        std::cerr << "Error: no usable positions" << std::endl;
+        GameState::cleanupHasher();
+        return 2;
+    }
+    size_t entries = 0;
+    for (const std::vector<uint32_t>& column : data.rows)
+        entries += column.size();
+    std::cerr << std::fixed << std::setprecision(1) << "Features: " << (double)entries / data.size()
+              << " non-zero terms per position, loaded in " << elapsed() << " s" << std::endl;
+
+    int weights[EvalFeatures::TERM_COUNT];
+    std::copy(EvalFeatures::DEFAULT_WEIGHTS, EvalFeatures::DEFAULT_WEIGHTS + EvalFeatures::TERM_COUNT, weights);
+    computeEvals(data, weights);
+
+    double k = options.k > 0.0 ? options.k : fitK(data, options.threads);
+    data.target.resize(data.size());
+    for (size_t i = 0; i < data.size(); i++)
+        data.target[i] = (float)((1.0 - options.lambda) * data.result[i] +
+                                 options.lambda * sigmoid(k * data.searchScore[i]));
+    data.loss.resize(data.size());
+    double loss = totalLoss(data, data.target, k, options.threads, &data.loss);
+    double initialLoss = loss;
+    std::cerr << std::setprecision(4) << "K = " << std::scientific << k << std::fixed << std::setprecision(6)
+              << ", initial loss " << loss / data.size() << std::endl;
+
+    double step = options.step;
+    uint64_t scanned = 0;
+    double tuneStart = elapsed();
+    for (int pass = 1; pass <= options.passes && step >= options.minStep; pass++) {
+        int changed = 0;
+        for (int term = 0; term < EvalFeatures::TERM_COUNT; term++) {
+            if (term == EvalFeatures::PATTERN_FIVE || data.rows[term].empty())
+                continue;
+            int magnitude = std::max(1, (int)std::lround(std::abs(weights[term]) * step));
+            for (int direction : {1, -1}) {
+                int delta = direction * magnitude;
+                if (weights[term] + delta < 0)
+                    continue; // Bonuses and penalties keep their sign
+                double change = lossDelta(data, term, delta, k, options.threads);
+                scanned += data.rows[term].size();
+                if (change < -1e-9 * data.size()) {
+                    applyDelta(data, term, delta, k);
+                    weights[term] += delta;
+                    loss += change;
+                    changed++;
+                    break;
+                }
+            }
+        }
+        std::cerr << "pass " << std::setw(3) << pass << "  step " << std::setprecision(4) << step
+                  << "  loss " << std::setprecision(6) << loss / data.size() << "  changed " << changed << std::endl;
+        if (changed == 0)
+            step /= 2.0;
+    }
+    double tuneSeconds = elapsed() - tuneStart;
+
+    std::cerr << std::setprecision(6) << "Loss " << initialLoss / data.size() << " -> " << loss / data.size()
+              << std::setprecision(0) << "  (" << (tuneSeconds > 0.0 ? scanned / tuneSeconds : 0.0)
+              << " feature entries/s)" << std::endl;
+    for (int term = 0; term < EvalFeatures::TERM_COUNT; term++) {
+        if (weights[term] != EvalFeatures::DEFAULT_WEIGHTS[term])
+            std::cerr << "  " << std::left << std::setw(24) << EvalFeatures::NAMES[term] << std::right << std::setw(8)
+                      << EvalFeatures::DEFAULT_WEIGHTS[term] << " -> " << weights[term] << std::endl;
+    }
+
+    std::ofstream out(options.outFile);
+    if (!out.is_open()) {
+        std::cerr << "Error: Could not write " << options.outFile << std::endl;
+        GameState::cleanupHasher();
+        return 2;
+    }
+    writeWeightsHeader(out, weights);
+    std::cerr << "Wrote " << options.outFile << std::endl;
+
+    GameState::cleanupHasher();
+    return 0;
+}